@@ -27,6 +27,7 @@ public:
     Close = 0x10,
     Cancel = 0x20,
     Shutdown = 0x40,
+    Recv = 0x80,
   };
 
   Request(RequestType type, IoUringSocket& socket) : type_(type), socket_(socket) {}
@@ -53,8 +54,11 @@ private:
  * queue.
  * @param result is a return code of submitted system call.
  * @param injected indicates whether the completion is injected or not.
+ * @param flags is the flags of the completion queue entry, e.g. `IORING_CQE_F_MORE`. Injected
+ * completions always have no flags.
  */
-using CompletionCb = std::function<void(Request* user_data, int32_t result, bool injected)>;
+using CompletionCb =
+    std::function<void(Request* user_data, int32_t result, bool injected, uint32_t flags)>;
 
 /**
  * Callback for releasing the user data.
@@ -147,6 +151,54 @@ public:
    */
   virtual IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) PURE;
 
+  /**
+   * Registers a ring of kernel provided buffers. A recv prepared by prepareRecvMultishot() only
+   * takes a buffer from the ring when data arrives, and its completion carries the buffer id in
+   * the flags. The buffer has to be given back with recycleProvidedBuffer() once consumed.
+   * Returns IoUringResult::Failed if the kernel does not support provided buffer rings and
+   * IoUringResult::Ok otherwise.
+   * @param num_buffers the number of buffers, a power of 2 no larger than 32768.
+   * @param buffer_size the size of each buffer.
+   */
+  virtual IoUringResult registerBufferRing(uint32_t num_buffers, uint32_t buffer_size) PURE;
+
+  /**
+   * Returns the memory of a buffer in the provided buffer ring.
+   * @param buffer_id the buffer id carried by a completion.
+   */
+  virtual const uint8_t* getProvidedBuffer(uint16_t buffer_id) const PURE;
+
+  /**
+   * Gives a buffer taken by a completion back to the provided buffer ring.
+   * @param buffer_id the buffer id carried by a completion.
+   */
+  virtual void recycleProvidedBuffer(uint16_t buffer_id) PURE;
+
+  /**
+   * Prepares a multishot recv which reads into buffers of the provided buffer ring and puts it
+   * into the submission queue. The request stays armed as long as its completions are flagged
+   * with `IORING_CQE_F_MORE`.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareRecvMultishot(os_fd_t fd, Request* user_data) PURE;
+
+  /**
+   * Returns true if the kernel supports zero copy sends with prepareSendmsgZeroCopy().
+   */
+  virtual bool isZeroCopySendSupported() PURE;
+
+  /**
+   * Prepares a zero copy sendmsg system call and puts it into the submission queue. The kernel
+   * keeps referring to the memory of the message after the completion with the result, and posts
+   * a second completion flagged with `IORING_CQE_F_NOTIF` once it is done with it. The first
+   * completion is flagged with `IORING_CQE_F_MORE` if the second one follows.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareSendmsgZeroCopy(os_fd_t fd, const struct msghdr* msg,
+                                               Request* user_data) PURE;
+
   /**
    * Submits the entries in the submission queue to the kernel using the
    * `io_uring_enter()` system call.
@@ -428,6 +480,13 @@ public:
   virtual Request* submitWriteRequest(IoUringSocket& socket,
                                       const Buffer::RawSliceVector& slices) PURE;
 
+  /**
+   * Submit a zero copy send request for a socket. The request takes the first `length` bytes of
+   * `data` and keeps them until the kernel is done with their memory.
+   */
+  virtual Request* submitSendZeroCopyRequest(IoUringSocket& socket, Buffer::Instance& data,
+                                             uint64_t length) PURE;
+
   /**
    * Submit a close request for a socket.
    */
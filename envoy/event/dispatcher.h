@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -187,6 +188,14 @@ public:
   virtual void initializeStats(Stats::Scope& scope,
                                const absl::optional<std::string>& prefix = absl::nullopt) PURE;
 
+  /**
+   * @return a moving average of how long recent event loop iterations took, counting both the time
+   *         spent running callbacks and any delay in returning from polling past its timeout. This
+   *         is only tracked once initializeStats() has been called and is zero until then. May be
+   *         called from any thread.
+   */
+  virtual std::chrono::microseconds loopLatency() const PURE;
+
   /**
    * Clears any items in the deferred deletion queue.
    */
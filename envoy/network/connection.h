@@ -120,6 +120,9 @@ public:
     Stats::Counter* bind_errors_;
     // Optional counter. Delayed close timeouts will not be tracked if this is nullptr.
     Stats::Counter* delayed_close_timeouts_;
+    // Optional counter of the write calls made to the socket, where the transport socket tracks
+    // them. Together with write_total_ this gives the number of system calls per byte written.
+    Stats::Counter* write_calls_{};
   };
 
   ~Connection() override = default;
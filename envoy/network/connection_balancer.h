@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "envoy/network/listen_socket.h"
 
 namespace Envoy {
@@ -27,6 +29,13 @@ public:
    */
   virtual void incNumConnections() PURE;
 
+  /**
+   * @return a moving average of the event loop latency of the worker the handler runs on, or zero
+   *         if it is not tracked. May be called from any thread. @see
+   *         Event::Dispatcher::loopLatency().
+   */
+  virtual std::chrono::microseconds loopLatency() const PURE;
+
   /**
    * Post a connected socket to this connection handler. This is used for cross-thread connection
    * transfer during the balancing process.
@@ -609,6 +609,13 @@ public:
    */
   virtual FilterStatus onReceiveError(Api::IoError::IoErrorCode error_code) PURE;
 
+  /**
+   * Called after a batch of onData() calls, such as all the packets read for one socket event.
+   * Filters which defer work while a batch is delivered, e.g. to send datagrams in batches, must
+   * complete it here.
+   */
+  virtual void onReadComplete() {}
+
 protected:
   /**
    * @param callbacks supplies the read filter callbacks used to interact with the filter manager.
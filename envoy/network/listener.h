@@ -403,6 +403,13 @@ public:
    */
   virtual void onReadReady() PURE;
 
+  /**
+   * Called after the packets read in one go, such as all the packets read for one socket event,
+   * have been passed to onData() or onDataWorker(). Work deferred while the packets were delivered,
+   * e.g. sending datagrams in batches, can be completed here.
+   */
+  virtual void onReadComplete() PURE;
+
   /**
    * Called when the underlying socket is ready for write.
    *
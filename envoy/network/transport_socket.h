@@ -66,6 +66,12 @@ struct IoResult {
    * The underlying I/O error code.
    */
   absl::optional<Api::IoError::IoErrorCode> err_code_;
+
+  /**
+   * Number of write calls made to the underlying IoHandle by a write operation. Zero if the
+   * transport socket does not track them.
+   */
+  uint64_t write_calls_{0};
 };
 
 /**
@@ -217,6 +217,23 @@ public:
    */
   virtual std::chrono::milliseconds fileFlushIntervalMsec() const PURE;
 
+  /**
+   * @return uint64_t the most data buffered for each log file awaiting a flush, beyond which
+   *         writes are dropped. 0 means no limit.
+   */
+  virtual uint64_t fileFlushMaxBufferedBytes() const PURE;
+
+  /**
+   * @return bool whether all log files are flushed by a single thread rather than a thread each.
+   */
+  virtual bool fileFlushSingleThread() const PURE;
+
+  /**
+   * @return uint64_t the most bytes of freed buffer slice storage each thread keeps for reuse.
+   *         0 disables reuse.
+   */
+  virtual uint64_t bufferSliceCacheBytesPerThread() const PURE;
+
   /**
    * @return const std::string& the server's cluster.
    */
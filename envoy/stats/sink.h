@@ -109,6 +109,14 @@ public:
    * @param value the value of the sample.
    */
   virtual void onHistogramComplete(const Histogram& histogram, uint64_t value) PURE;
+
+  /**
+   * @return true if the sink only wants metrics that changed since the previous flush. Such a sink
+   *         is flushed with a snapshot holding only counters with a non-zero delta, gauges that
+   *         were written to, and histograms with values recorded during the interval. Text
+   *         readouts and host gauges carry no change tracking and are always included.
+   */
+  virtual bool changedMetricsOnly() const { return false; }
 };
 
 using SinkPtr = std::unique_ptr<Sink>;
@@ -1,5 +1,6 @@
 #include "source/common/access_log/access_log_manager_impl.h"
 
+#include <algorithm>
 #include <string>
 
 #include "envoy/common/exception.h"
@@ -7,8 +8,11 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/lock_guard.h"
+#include "source/common/stats/utility.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
 
 namespace Envoy {
 namespace AccessLog {
@@ -46,20 +50,111 @@ AccessLogManagerImpl::createAccessLog(const Filesystem::FilePathAndType& file_in
                                                   open_result.err_->getErrorDetails()));
   }
 
-  access_logs_[file_name] =
-      std::make_shared<AccessLogFileImpl>(std::move(file), dispatcher_, lock_, file_stats_,
-                                          file_flush_interval_msec_, api_.threadFactory());
+  std::unique_ptr<AccessLogFileQueueStats> queue_stats;
+  if (flush_thread_ != nullptr) {
+    // Dots in the path would otherwise add levels to the stat names.
+    const std::string prefix = absl::StrCat(
+        "filesystem.file.", absl::StrReplaceAll(Stats::Utility::sanitizeStatsName(file_name),
+                                                {{".", "_"}}),
+        ".");
+    queue_stats = std::make_unique<AccessLogFileQueueStats>(AccessLogFileQueueStats{
+        ACCESS_LOG_FILE_QUEUE_STATS(POOL_COUNTER_PREFIX(stats_store_, prefix),
+                                    POOL_GAUGE_PREFIX(stats_store_, prefix))});
+  }
+
+  access_logs_[file_name] = std::make_shared<AccessLogFileImpl>(
+      std::move(file), dispatcher_, lock_, file_stats_, file_flush_interval_msec_,
+      api_.threadFactory(), file_max_buffered_bytes_, flush_thread_, std::move(queue_stats));
   return access_logs_[file_name];
 }
 
+AccessLogFlushThread::AccessLogFlushThread(Thread::ThreadFactory& thread_factory,
+                                           TimeSource& time_source)
+    : time_source_(time_source) {
+  thread_ = thread_factory.createThread([this]() -> void { threadFunc(); },
+                                       Thread::Options{"AccessLogFlush"});
+}
+
+AccessLogFlushThread::~AccessLogFlushThread() {
+  {
+    Thread::LockGuard lock(lock_);
+    // Files hold a reference to the thread, so none can be left.
+    ASSERT(queue_.empty());
+    exit_ = true;
+    event_.notifyAll();
+  }
+  thread_->join();
+}
+
+void AccessLogFlushThread::enqueue(AccessLogFileImpl& file) {
+  Thread::LockGuard lock(lock_);
+  if (file.queued_) {
+    return;
+  }
+  file.queued_ = true;
+  file.queued_time_ = time_source_.monotonicTime();
+  queue_.push_back(&file);
+  event_.notifyAll();
+}
+
+void AccessLogFlushThread::remove(AccessLogFileImpl& file) {
+  Thread::LockGuard lock(lock_);
+  if (file.queued_) {
+    queue_.erase(std::find(queue_.begin(), queue_.end(), &file));
+    file.queued_ = false;
+  }
+  while (flushing_ == &file) {
+    event_.wait(lock_);
+  }
+}
+
+void AccessLogFlushThread::threadFunc() {
+  while (true) {
+    AccessLogFileImpl* file;
+    MonotonicTime queued_time;
+    {
+      Thread::LockGuard lock(lock_);
+      while (queue_.empty() && !exit_) {
+        event_.wait(lock_);
+      }
+      if (exit_) {
+        return;
+      }
+      file = queue_.front();
+      queue_.pop_front();
+      file->queued_ = false;
+      queued_time = file->queued_time_;
+      flushing_ = file;
+    }
+
+    // The file is flushed without the lock held, so that files can be queued meanwhile. Any which
+    // is removed in the meantime waits for the flush to complete.
+    file->flushQueued();
+    file->queue_stats_->flushed_.inc();
+    file->queue_stats_->last_flush_latency_ms_.set(
+        std::chrono::duration_cast<std::chrono::milliseconds>(time_source_.monotonicTime() -
+                                                              queued_time)
+            .count());
+
+    Thread::LockGuard lock(lock_);
+    flushing_ = nullptr;
+    event_.notifyAll();
+  }
+}
+
 AccessLogFileImpl::AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                                      Thread::BasicLockable& lock, AccessLogFileStats& stats,
                                      std::chrono::milliseconds flush_interval_msec,
-                                     Thread::ThreadFactory& thread_factory)
+                                     Thread::ThreadFactory& thread_factory,
+                                     uint64_t max_buffered_bytes,
+                                     AccessLogFlushThreadSharedPtr shared_flush_thread,
+                                     std::unique_ptr<AccessLogFileQueueStats> queue_stats)
     : file_(std::move(file)), file_lock_(lock),
+      shared_flush_thread_(std::move(shared_flush_thread)), queue_stats_(std::move(queue_stats)),
+      max_buffered_bytes_(max_buffered_bytes),
       flush_timer_(dispatcher.createTimer([this]() -> void {
         stats_.flushed_by_timer_.inc();
-        flush_event_.notifyOne();
+        requestFlush();
         flush_timer_->enableTimer(flush_interval_msec_);
       })),
       thread_factory_(thread_factory), flush_interval_msec_(flush_interval_msec), stats_(stats) {
@@ -67,12 +162,37 @@ AccessLogFileImpl::AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatch
 }
 
 void AccessLogFileImpl::reopen() {
-  Thread::LockGuard lock(write_lock_);
-  reopen_file_ = true;
-  flush_event_.notifyOne();
+  {
+    Thread::LockGuard lock(write_lock_);
+    reopen_file_ = true;
+    if (shared_flush_thread_ == nullptr) {
+      flush_event_.notifyOne();
+      return;
+    }
+  }
+  shared_flush_thread_->enqueue(*this);
+}
+
+void AccessLogFileImpl::requestFlush() {
+  if (shared_flush_thread_ != nullptr) {
+    {
+      // Queueing an idle file would only count a flush that writes nothing.
+      Thread::LockGuard lock(write_lock_);
+      if (buffered_bytes_.load() == 0 && !reopen_file_) {
+        return;
+      }
+    }
+    shared_flush_thread_->enqueue(*this);
+  } else {
+    flush_event_.notifyOne();
+  }
 }
 
 AccessLogFileImpl::~AccessLogFileImpl() {
+  if (shared_flush_thread_ != nullptr) {
+    shared_flush_thread_->remove(*this);
+  }
+
   {
     Thread::LockGuard lock(write_lock_);
     flush_thread_exit_ = true;
@@ -85,8 +205,9 @@ AccessLogFileImpl::~AccessLogFileImpl() {
 
   // Flush any remaining data. If file was not opened for some reason, skip flushing part.
   if (file_->isOpen()) {
-    if (flush_buffer_.length() > 0) {
-      doWrite(flush_buffer_);
+    collectShards();
+    if (about_to_write_buffer_.length() > 0) {
+      doWrite(about_to_write_buffer_);
     }
     const Api::IoCallBoolResult result = file_->close();
     ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
@@ -95,7 +216,7 @@ AccessLogFileImpl::~AccessLogFileImpl() {
 }
 
 void AccessLogFileImpl::doWrite(Buffer::Instance& buffer) {
-  Buffer::RawSliceVector slices = buffer.getRawSlices();
+  const uint64_t length = buffer.length();
 
   // We must do the actual writes to disk under lock, so that we don't intermix chunks from
   // different AccessLogFileImpl pointing to the same underlying file. This can happen either via
@@ -107,42 +228,43 @@ void AccessLogFileImpl::doWrite(Buffer::Instance& buffer) {
   //            process lock or had multiple locks.
   {
     Thread::LockGuard lock(file_lock_);
-    for (const Buffer::RawSlice& slice : slices) {
-      absl::string_view data(static_cast<char*>(slice.mem_), slice.len_);
+    // The buffer is written in chunks of WRITE_CHUNK_SIZE, copying together the slices of each
+    // chunk, so that many small slices take a single write.
+    while (buffer.length() > 0) {
+      const uint64_t chunk_size = std::min(buffer.length(), WRITE_CHUNK_SIZE);
+      absl::string_view data(
+          static_cast<char*>(buffer.linearize(static_cast<uint32_t>(chunk_size))), chunk_size);
       const Api::IoCallSizeResult result = file_->write(data);
-      if (result.ok() && result.return_value_ == static_cast<ssize_t>(slice.len_)) {
+      if (result.ok() && result.return_value_ == static_cast<ssize_t>(chunk_size)) {
         stats_.write_completed_.inc();
       } else {
         // Probably disk full.
         stats_.write_failed_.inc();
       }
+      buffer.drain(chunk_size);
     }
   }
 
-  stats_.write_total_buffered_.sub(buffer.length());
-  buffer.drain(buffer.length());
+  stats_.write_total_buffered_.sub(length);
+  if (queue_stats_ != nullptr) {
+    queue_stats_->queued_bytes_.sub(length);
+  }
 }
 
 void AccessLogFileImpl::flushThreadFunc() {
-
-  // Transfer the action from `reopen_file_` to this variable so that `reopen_file_` is only
-  // accessed while holding the mutex while the actual operation is performed while not holding the
-  // mutex.
-  bool do_reopen = false;
-
   while (true) {
     std::unique_lock<Thread::BasicLockable> flush_lock;
 
     {
       Thread::LockGuard write_lock(write_lock_);
 
-      // flush_event_ can be woken up either by large enough flush_buffer or by timer.
-      // In case it was timer, flush_buffer_ can be empty.
+      // flush_event_ can be woken up either by large enough shards or by timer.
+      // In case it was timer, the shards can be empty.
       //
-      // Note: do not stop waiting when only `do_reopen` is true. In this case, we tried to
+      // Note: do not stop waiting when only `do_reopen_` is true. In this case, we tried to
       // reopen and failed. We don't want to retry this in a tight loop, so wait for the next
       // event (timer or flush).
-      while (flush_buffer_.length() == 0 && !flush_thread_exit_ && !reopen_file_) {
+      while (buffered_bytes_.load() == 0 && !flush_thread_exit_ && !reopen_file_) {
         // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
         flush_event_.wait(write_lock_);
       }
@@ -152,68 +274,136 @@ void AccessLogFileImpl::flushThreadFunc() {
       }
 
       flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-      about_to_write_buffer_.move(flush_buffer_);
-      ASSERT(flush_buffer_.length() == 0);
-
+      // Transfer the action from `reopen_file_` to `do_reopen_` so that `reopen_file_` is only
+      // accessed while holding the mutex while the actual operation is performed while not
+      // holding the mutex.
       if (reopen_file_) {
-        do_reopen = true;
+        do_reopen_ = true;
         reopen_file_ = false;
       }
     }
 
-    if (do_reopen) {
-      if (file_->isOpen()) {
-        const Api::IoCallBoolResult result = file_->close();
-        ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
-                                                 result.err_->getErrorDetails()));
-      }
-      const Api::IoCallBoolResult open_result = file_->open(default_flags);
-      if (!open_result.return_value_) {
-        stats_.reopen_failed_.inc();
-      } else {
-        do_reopen = false;
-      }
-    }
-    // doWrite no matter file isOpen, if not, we can drain buffer
-    doWrite(about_to_write_buffer_);
+    flushShards();
   }
 }
 
-void AccessLogFileImpl::flush() {
-  std::unique_lock<Thread::BasicLockable> flush_buffer_lock;
-
+void AccessLogFileImpl::flushQueued() {
+  std::unique_lock<Thread::BasicLockable> flush_lock;
   {
     Thread::LockGuard write_lock(write_lock_);
+    flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
+    if (reopen_file_) {
+      do_reopen_ = true;
+      reopen_file_ = false;
+    }
+  }
+  flushShards();
+}
 
-    // flush_lock_ must be held while checking this or else it is
-    // possible that flushThreadFunc() has already moved data from
-    // flush_buffer_ to about_to_write_buffer_, has unlocked write_lock_,
-    // but has not yet completed doWrite(). This would allow flush() to
-    // return before the pending data has actually been written to disk.
-    flush_buffer_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
+void AccessLogFileImpl::flushShards() {
+  collectShards();
 
-    if (flush_buffer_.length() == 0) {
-      return;
+  if (do_reopen_) {
+    if (file_->isOpen()) {
+      const Api::IoCallBoolResult result = file_->close();
+      ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
+                                               result.err_->getErrorDetails()));
+    }
+    const Api::IoCallBoolResult open_result = file_->open(default_flags);
+    if (!open_result.return_value_) {
+      stats_.reopen_failed_.inc();
+    } else {
+      do_reopen_ = false;
     }
-
-    about_to_write_buffer_.move(flush_buffer_);
-    ASSERT(flush_buffer_.length() == 0);
   }
+  // doWrite no matter file isOpen, if not, we can drain buffer
+  doWrite(about_to_write_buffer_);
+}
 
+void AccessLogFileImpl::flush() {
+  // flush_lock_ must be held while collecting the shards or else it is
+  // possible that flushThreadFunc() has already moved data from them
+  // to about_to_write_buffer_ but has not yet completed doWrite(). This
+  // would allow flush() to return before the pending data has actually
+  // been written to disk.
+  Thread::LockGuard flush_lock(flush_lock_);
+  collectShards();
+  if (about_to_write_buffer_.length() == 0) {
+    return;
+  }
   doWrite(about_to_write_buffer_);
 }
 
-void AccessLogFileImpl::write(absl::string_view data) {
-  Thread::LockGuard lock(write_lock_);
+void AccessLogFileImpl::collectShards() {
+  for (WriteShard& shard : shards_) {
+    uint64_t length;
+    {
+      Thread::LockGuard shard_lock(shard.lock_);
+      length = shard.buffer_.length();
+      if (length == 0) {
+        continue;
+      }
+      about_to_write_buffer_.move(shard.buffer_);
+    }
+    buffered_bytes_ -= length;
+  }
+}
+
+size_t AccessLogFileImpl::shardIndex() {
+  // Threads are assigned shards in turn, so that as long as there are no more threads writing than
+  // shards, each has a shard of its own.
+  static std::atomic<size_t> next_thread_index{0};
+  static thread_local const size_t thread_index = next_thread_index++;
+  return thread_index % WRITE_SHARDS;
+}
 
-  if (flush_thread_ == nullptr) {
-    createFlushStructures();
+void AccessLogFileImpl::write(absl::string_view data) {
+  // The limit is checked before the data is added, so concurrent writes may exceed it by up to one
+  // write each.
+  if (max_buffered_bytes_ != 0 && buffered_bytes_.load() + data.size() > max_buffered_bytes_) {
+    stats_.write_dropped_.inc();
+    return;
   }
 
   stats_.write_buffered_.inc();
   stats_.write_total_buffered_.add(data.length());
-  flush_buffer_.add(data.data(), data.size());
-  if (flush_buffer_.length() > MIN_FLUSH_SIZE) {
+  if (queue_stats_ != nullptr) {
+    queue_stats_->queued_bytes_.add(data.length());
+  }
+  WriteShard& shard = shards_[shardIndex()];
+  uint64_t buffered;
+  {
+    // buffered_bytes_ is added to under the lock, so that it is never less than the data the
+    // shards hold when collectShards() subtracts from it.
+    Thread::LockGuard shard_lock(shard.lock_);
+    shard.buffer_.add(data.data(), data.size());
+    buffered = buffered_bytes_ += data.size();
+  }
+  const bool reached_flush_size =
+      buffered > MIN_FLUSH_SIZE && buffered - data.size() <= MIN_FLUSH_SIZE;
+
+  // A file flushed by the shared thread waits to be queued until it has enough data to flush, or
+  // its timer fires, so that its writes are batched.
+  if (shared_flush_thread_ != nullptr) {
+    if (reached_flush_size) {
+      shared_flush_thread_->enqueue(*this);
+    }
+    return;
+  }
+
+  // The flush thread is started after the data is buffered, so that it finds the data once it runs.
+  if (!flush_thread_started_.load(std::memory_order_acquire)) {
+    Thread::LockGuard lock(write_lock_);
+    if (flush_thread_ == nullptr) {
+      createFlushStructures();
+      flush_thread_started_.store(true, std::memory_order_release);
+    }
+  }
+
+  // Only the write which takes the shards past the threshold wakes the flush thread. The lock is
+  // taken so that the wakeup cannot be missed by the flush thread as it is about to wait.
+  if (reached_flush_size) {
+    Thread::LockGuard lock(write_lock_);
     flush_event_.notifyOne();
   }
 }
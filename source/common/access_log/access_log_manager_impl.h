@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <deque>
 #include <string>
 
 #include "envoy/access_log/access_log.h"
@@ -22,6 +25,7 @@ namespace Envoy {
   COUNTER(reopen_failed)                                                                           \
   COUNTER(write_buffered)                                                                          \
   COUNTER(write_completed)                                                                         \
+  COUNTER(write_dropped)                                                                           \
   COUNTER(write_failed)                                                                            \
   GAUGE(write_total_buffered, Accumulate)
 
@@ -29,17 +33,78 @@ struct AccessLogFileStats {
   ACCESS_LOG_FILE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
 };
 
+/**
+ * Stats of each file flushed by an AccessLogFlushThread.
+ */
+#define ACCESS_LOG_FILE_QUEUE_STATS(COUNTER, GAUGE)                                                \
+  COUNTER(flushed)                                                                                 \
+  GAUGE(last_flush_latency_ms, NeverImport)                                                        \
+  GAUGE(queued_bytes, NeverImport)
+
+struct AccessLogFileQueueStats {
+  ACCESS_LOG_FILE_QUEUE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
 namespace AccessLog {
 
+class AccessLogFileImpl;
+
+/**
+ * A thread which flushes all the files of an AccessLogManagerImpl, in place of a thread per file.
+ * Files queue themselves when they have data to flush or are to be reopened, and are flushed in
+ * the order they were queued.
+ */
+class AccessLogFlushThread {
+public:
+  AccessLogFlushThread(Thread::ThreadFactory& thread_factory, TimeSource& time_source);
+  ~AccessLogFlushThread();
+
+  /**
+   * Queues a file to be flushed, unless it already is.
+   */
+  void enqueue(AccessLogFileImpl& file);
+
+  /**
+   * Removes a file from the queue, waiting for any flush of it in progress to complete.
+   */
+  void remove(AccessLogFileImpl& file);
+
+private:
+  void threadFunc();
+
+  TimeSource& time_source_;
+  Thread::MutexBasicLockable lock_;
+  Thread::CondVar event_;
+  std::deque<AccessLogFileImpl*> queue_ ABSL_GUARDED_BY(lock_);
+  // The file being flushed, if any.
+  AccessLogFileImpl* flushing_ ABSL_GUARDED_BY(lock_){};
+  bool exit_ ABSL_GUARDED_BY(lock_){false};
+  Thread::ThreadPtr thread_;
+};
+
+using AccessLogFlushThreadSharedPtr = std::shared_ptr<AccessLogFlushThread>;
+
 class AccessLogManagerImpl : public AccessLogManager, Logger::Loggable<Logger::Id::main> {
 public:
+  /**
+   * @param file_max_buffered_bytes supplies the most data which may be buffered for each file
+   *        awaiting a flush, beyond which writes are dropped. 0 means no limit.
+   * @param file_flush_single_thread supplies whether all files are flushed by a single
+   *        AccessLogFlushThread rather than by a thread each.
+   */
   AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec, Api::Api& api,
                        Event::Dispatcher& dispatcher, Thread::BasicLockable& lock,
-                       Stats::Store& stats_store)
-      : file_flush_interval_msec_(file_flush_interval_msec), api_(api), dispatcher_(dispatcher),
-        lock_(lock), file_stats_{
-                         ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(stats_store, "filesystem."),
-                                               POOL_GAUGE_PREFIX(stats_store, "filesystem."))} {}
+                       Stats::Store& stats_store, uint64_t file_max_buffered_bytes = 0,
+                       bool file_flush_single_thread = false)
+      : file_flush_interval_msec_(file_flush_interval_msec),
+        file_max_buffered_bytes_(file_max_buffered_bytes), api_(api), dispatcher_(dispatcher),
+        lock_(lock), stats_store_(stats_store),
+        file_stats_{ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(stats_store, "filesystem."),
+                                          POOL_GAUGE_PREFIX(stats_store, "filesystem."))},
+        flush_thread_(file_flush_single_thread
+                          ? std::make_shared<AccessLogFlushThread>(api.threadFactory(),
+                                                                   api.timeSource())
+                          : nullptr) {}
   ~AccessLogManagerImpl() override;
 
   // AccessLog::AccessLogManager
@@ -49,10 +114,13 @@ public:
 
 private:
   const std::chrono::milliseconds file_flush_interval_msec_;
+  const uint64_t file_max_buffered_bytes_;
   Api::Api& api_;
   Event::Dispatcher& dispatcher_;
   Thread::BasicLockable& lock_;
+  Stats::Store& stats_store_;
   AccessLogFileStats file_stats_;
+  const AccessLogFlushThreadSharedPtr flush_thread_;
   absl::node_hash_map<std::string, AccessLogFileSharedPtr> access_logs_;
 };
 
@@ -60,15 +128,21 @@ private:
  * This is a file implementation geared for writing out access logs. It turn out that in certain
  * cases even if a standard file is opened with O_NONBLOCK, the kernel can still block when writing.
  * This implementation uses a flush thread per file, with the idea there aren't that many
- * files. If this turns out to be a good implementation we can potentially have a single flush
- * thread that flushes all files, but we will start with this.
+ * files, or optionally an AccessLogFlushThread shared by all files.
+ *
+ * Writes are buffered in one of several shards, each thread always using the same shard, so that
+ * worker threads writing to the same file do not contend on a single lock. The flush thread
+ * collects the shards, so data written by one thread is flushed in order, while data written by
+ * different threads may be reordered by up to a flush.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
   AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                     Thread::BasicLockable& lock, AccessLogFileStats& stats,
                     std::chrono::milliseconds flush_interval_msec,
-                    Thread::ThreadFactory& thread_factory);
+                    Thread::ThreadFactory& thread_factory, uint64_t max_buffered_bytes = 0,
+                    AccessLogFlushThreadSharedPtr shared_flush_thread = nullptr,
+                    std::unique_ptr<AccessLogFileQueueStats> queue_stats = nullptr);
   ~AccessLogFileImpl() override;
 
   // AccessLog::AccessLogFile
@@ -82,10 +156,35 @@ public:
   void reopen() override;
   void flush() override;
 
+  // The number of shards writes are buffered in.
+  static constexpr size_t WRITE_SHARDS = 32;
+  // The most data written to the file by each write() call.
+  static constexpr uint64_t WRITE_CHUNK_SIZE = 256 * 1024;
+
 private:
+  // A buffer written to by the threads assigned to it. Aligned so that shards do not share cache
+  // lines.
+  struct alignas(64) WriteShard {
+    Thread::MutexBasicLockable lock_;
+    Buffer::OwnedImpl buffer_ ABSL_GUARDED_BY(lock_);
+  };
+
+  friend class AccessLogFlushThread;
+
   void doWrite(Buffer::Instance& buffer);
   void flushThreadFunc();
+  // Called by the AccessLogFlushThread to flush the file once it is at the head of the queue.
+  void flushQueued();
+  // Writes the data of the shards, after reopening the file if do_reopen_ is set. Must be called
+  // with flush_lock_ held.
+  void flushShards();
+  // Requests a flush from the flush thread of the file or the shared one. The file is only queued
+  // on the shared thread when it has data or a reopen pending.
+  void requestFlush();
   void createFlushStructures();
+  // Moves the data of all shards to about_to_write_buffer_.
+  void collectShards();
+  static size_t shardIndex();
 
   // Minimum size before the flush thread will be told to flush.
   static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
@@ -95,7 +194,8 @@ private:
   // These locks are always acquired in the following order if multiple locks are held:
   //    1) write_lock_
   //    2) flush_lock_
-  //    3) file_lock_
+  //    3) the lock_ of a WriteShard
+  //    4) file_lock_
   Thread::BasicLockable& file_lock_;      // This lock is used only by the flush thread when writing
                                           // to disk. This is used to make sure that file blocks do
                                           // not get interleaved by multiple processes writing to
@@ -105,26 +205,35 @@ private:
                                           // concurrent access to the about_to_write_buffer_, fd_,
                                           // and all other data used during flushing and file
                                           // re-opening.
-  Thread::MutexBasicLockable
-      write_lock_; // The lock is used when filling the flush buffer. It allows
-                   // multiple threads to write to the same file at relatively
-                   // high performance. It is always local to the process.
+  Thread::MutexBasicLockable write_lock_; // This lock guards the state shared with the flush
+                                          // thread, and is used to wake it. Writes only take it
+                                          // to start the flush thread or to wake it.
   Thread::ThreadPtr flush_thread_;
+  std::atomic<bool> flush_thread_started_{false};
   Thread::CondVar flush_event_;
   bool flush_thread_exit_ ABSL_GUARDED_BY(write_lock_){false};
   bool reopen_file_ ABSL_GUARDED_BY(write_lock_){false};
-  Buffer::OwnedImpl
-      flush_buffer_ ABSL_GUARDED_BY(write_lock_); // This buffer is used by multiple threads. It
-                                                  // gets filled and then flushed either when max
-                                                  // size is reached or when a timer fires.
+  // Set once a reopen has been requested, until it succeeds. Used only under flush_lock_.
+  bool do_reopen_{false};
+  const AccessLogFlushThreadSharedPtr shared_flush_thread_;
+  // Whether the file is in the queue of shared_flush_thread_. Guarded by its lock.
+  bool queued_{false};
+  MonotonicTime queued_time_;
+  const std::unique_ptr<AccessLogFileQueueStats> queue_stats_;
+  // The shards are filled by writes, and flushed either when MIN_FLUSH_SIZE is reached across all
+  // of them or when a timer fires.
+  std::array<WriteShard, WRITE_SHARDS> shards_;
+  // The data buffered in shards_.
+  std::atomic<uint64_t> buffered_bytes_{0};
+  const uint64_t max_buffered_bytes_;
   // TODO(jmarantz): this should be ABSL_GUARDED_BY(flush_lock_) but the analysis cannot poke
   // through the std::make_unique assignment. I do not believe it's possible to annotate this
   // properly now due to limitations in the clang thread annotation analysis.
-  Buffer::OwnedImpl about_to_write_buffer_; // This buffer is used only by the flush thread. Data
-                                            // is moved from flush_buffer_ under lock, and then
-                                            // the lock is released so that flush_buffer_ can
-                                            // continue to fill. This buffer is then used for the
-                                            // final write to disk.
+  Buffer::OwnedImpl about_to_write_buffer_; // This buffer is used only under flush_lock_. Data
+                                            // is moved from each shard under its lock, which is
+                                            // then released so that the shard can continue to
+                                            // fill. This buffer is then used for the final write
+                                            // to disk.
   Event::TimerPtr flush_timer_;
   Thread::ThreadFactory& thread_factory_;
   const std::chrono::milliseconds flush_interval_msec_; // Time interval buffer gets flushed no
@@ -7,6 +7,7 @@
 
 #include "source/common/common/thread.h"
 #include "source/common/event/dispatcher_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Api {
@@ -28,8 +29,10 @@ Event::DispatcherPtr Impl::allocateDispatcher(const std::string& name) {
 Event::DispatcherPtr
 Impl::allocateDispatcher(const std::string& name,
                          const Event::ScaledRangeTimerManagerFactory& scaled_timer_factory) {
-  return std::make_unique<Event::DispatcherImpl>(name, *this, time_system_, scaled_timer_factory,
-                                                 watermark_factory_);
+  // This is how worker dispatchers are allocated, which is where most timers are armed.
+  return std::make_unique<Event::DispatcherImpl>(
+      name, *this, time_system_, scaled_timer_factory, watermark_factory_,
+      Runtime::runtimeFeatureEnabled("envoy.restart_features.worker_timer_wheel"));
 }
 
 Event::DispatcherPtr Impl::allocateDispatcher(const std::string& name,
@@ -0,0 +1,157 @@
+#include "source/common/buffer/slice_pool.h"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+// Per-thread counters are folded into the process wide totals after this many operations, so the
+// hot path never touches a shared cache line.
+constexpr uint32_t PublishInterval = 256;
+
+std::atomic<uint64_t> max_cached_bytes_per_thread{SlicePool::DefaultMaxCachedBytesPerThread};
+
+std::atomic<uint64_t> total_pool_hits;
+std::atomic<uint64_t> total_pool_misses;
+std::atomic<uint64_t> total_recycled;
+std::atomic<uint64_t> total_overflow_frees;
+std::atomic<uint64_t> total_cached_bytes;
+
+// Set once the calling thread's cache has been destroyed. Other thread-local objects may own slices
+// and be destroyed after the cache, since the order is unspecified; their storage then bypasses the
+// pool. Being trivially destructible, the flag stays usable until the thread is gone.
+thread_local bool thread_cache_destroyed = false;
+
+class ThreadCache {
+public:
+  ~ThreadCache() {
+    drain();
+    thread_cache_destroyed = true;
+  }
+
+  SlicePool::StoragePtr allocate(uint64_t size) {
+    const uint32_t size_class = sizeClass(size);
+    if (size_class < SlicePool::NumSizeClasses) {
+      auto& free_list = free_lists_[size_class];
+      if (!free_list.empty()) {
+        SlicePool::StoragePtr mem = std::move(free_list.back());
+        free_list.pop_back();
+        cached_bytes_ -= size;
+        ++pending_.pool_hits_;
+        maybePublish();
+        return mem;
+      }
+      ++pending_.pool_misses_;
+      maybePublish();
+    }
+    return SlicePool::StoragePtr{new uint8_t[size]};
+  }
+
+  void release(SlicePool::StoragePtr mem, uint64_t size) {
+    const uint32_t size_class = sizeClass(size);
+    if (size_class >= SlicePool::NumSizeClasses) {
+      return;
+    }
+    if (cached_bytes_ + size > max_cached_bytes_per_thread.load(std::memory_order_relaxed)) {
+      ++pending_.overflow_frees_;
+    } else {
+      free_lists_[size_class].push_back(std::move(mem));
+      cached_bytes_ += size;
+      ++pending_.recycled_;
+    }
+    maybePublish();
+  }
+
+  void drain() {
+    for (auto& free_list : free_lists_) {
+      free_list.clear();
+      free_list.shrink_to_fit();
+    }
+    cached_bytes_ = 0;
+    publish();
+  }
+
+private:
+  static uint32_t sizeClass(uint64_t size) {
+    ASSERT(size % SlicePool::PageSize == 0);
+    if (size == 0 || size > SlicePool::MaxPooledSize) {
+      return SlicePool::NumSizeClasses;
+    }
+    return static_cast<uint32_t>(size / SlicePool::PageSize) - 1;
+  }
+
+  void maybePublish() {
+    if (++ops_since_publish_ >= PublishInterval) {
+      publish();
+    }
+  }
+
+  void publish() {
+    total_pool_hits.fetch_add(pending_.pool_hits_, std::memory_order_relaxed);
+    total_pool_misses.fetch_add(pending_.pool_misses_, std::memory_order_relaxed);
+    total_recycled.fetch_add(pending_.recycled_, std::memory_order_relaxed);
+    total_overflow_frees.fetch_add(pending_.overflow_frees_, std::memory_order_relaxed);
+    // Unsigned wrap-around makes this correct whether the cache grew or shrank.
+    total_cached_bytes.fetch_add(cached_bytes_ - published_cached_bytes_,
+                                 std::memory_order_relaxed);
+    published_cached_bytes_ = cached_bytes_;
+    pending_ = {};
+    ops_since_publish_ = 0;
+  }
+
+  std::array<std::vector<SlicePool::StoragePtr>, SlicePool::NumSizeClasses> free_lists_;
+  uint64_t cached_bytes_{};
+  uint64_t published_cached_bytes_{};
+  SlicePool::Stats pending_;
+  uint32_t ops_since_publish_{};
+};
+
+thread_local ThreadCache thread_cache;
+
+} // namespace
+
+SlicePool::StoragePtr SlicePool::allocate(uint64_t size) {
+  if (thread_cache_destroyed) {
+    return StoragePtr{new uint8_t[size]};
+  }
+  return thread_cache.allocate(size);
+}
+
+void SlicePool::release(StoragePtr mem, uint64_t size) {
+  // After the cache is gone, the storage is simply freed when mem goes out of scope.
+  if (mem != nullptr && !thread_cache_destroyed) {
+    thread_cache.release(std::move(mem), size);
+  }
+}
+
+void SlicePool::setMaxCachedBytesPerThread(uint64_t max_bytes) {
+  max_cached_bytes_per_thread.store(max_bytes, std::memory_order_relaxed);
+}
+
+uint64_t SlicePool::maxCachedBytesPerThread() {
+  return max_cached_bytes_per_thread.load(std::memory_order_relaxed);
+}
+
+void SlicePool::drainThreadCache() {
+  if (!thread_cache_destroyed) {
+    thread_cache.drain();
+  }
+}
+
+SlicePool::Stats SlicePool::stats() {
+  Stats stats;
+  stats.pool_hits_ = total_pool_hits.load(std::memory_order_relaxed);
+  stats.pool_misses_ = total_pool_misses.load(std::memory_order_relaxed);
+  stats.recycled_ = total_recycled.load(std::memory_order_relaxed);
+  stats.overflow_frees_ = total_overflow_frees.load(std::memory_order_relaxed);
+  stats.cached_bytes_ = total_cached_bytes.load(std::memory_order_relaxed);
+  return stats;
+}
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * A per-thread, size-classed cache of backing storage for owned buffer slices.
+ *
+ * Slice storage is always a multiple of the page size. Blocks of up to MaxPooledSize bytes are
+ * bucketed by page count and, when released, are kept on the releasing thread's free list for the
+ * matching size class instead of being returned to the heap. Because workers allocate and free
+ * slices on their own dispatcher thread, this turns most of the malloc/free traffic on the data
+ * path into a vector push/pop. The number of bytes each thread may keep cached is bounded by
+ * maxCachedBytesPerThread(); blocks released above that high-water mark go straight back to the
+ * heap.
+ *
+ * Every block handed out by the pool is allocated with new uint8_t[], so storage obtained from
+ * allocate() can always be safely freed with delete[] (e.g. when a StoragePtr is simply
+ * destroyed); it is then just not recycled.
+ *
+ * Each thread's cache is a thread_local, destroyed at thread exit in no particular order relative
+ * to other thread_local objects that may own slices. Storage allocated or released on a thread
+ * after its cache is destroyed goes straight to and from the heap.
+ */
+class SlicePool {
+public:
+  using StoragePtr = std::unique_ptr<uint8_t[]>;
+
+  static constexpr uint64_t PageSize = 4096;
+  static constexpr uint32_t NumSizeClasses = 16;
+  static constexpr uint64_t MaxPooledSize = PageSize * NumSizeClasses;
+  static constexpr uint64_t DefaultMaxCachedBytesPerThread = 1024 * 1024;
+
+  /**
+   * Process wide pool statistics. Counters are published from each thread in batches, so they
+   * may lag the true values slightly.
+   */
+  struct Stats {
+    // Allocations served from a thread's free list.
+    uint64_t pool_hits_{};
+    // Pool-sized allocations that had to go to the heap because the free list was empty.
+    uint64_t pool_misses_{};
+    // Released blocks that were kept on a thread's free list.
+    uint64_t recycled_{};
+    // Pool-sized blocks that were returned to the heap because the thread was at its high-water
+    // mark.
+    uint64_t overflow_frees_{};
+    // Bytes currently held on all threads' free lists.
+    uint64_t cached_bytes_{};
+  };
+
+  /**
+   * Allocate backing storage for a slice.
+   * @param size the size of the storage in bytes. Must be a multiple of PageSize.
+   * @return storage of exactly size bytes.
+   */
+  static StoragePtr allocate(uint64_t size);
+
+  /**
+   * Release slice storage previously obtained from allocate().
+   * @param mem the storage to release. May be nullptr.
+   * @param size the size that was passed to allocate() for this storage.
+   */
+  static void release(StoragePtr mem, uint64_t size);
+
+  /**
+   * Set the high-water mark for bytes cached on each thread. A value of 0 disables recycling.
+   * Threads that are above the new limit shrink lazily as they release storage. The server sets it
+   * from --buffer-slice-cache-bytes-per-thread.
+   */
+  static void setMaxCachedBytesPerThread(uint64_t max_bytes);
+  static uint64_t maxCachedBytesPerThread();
+
+  /**
+   * Return all storage cached by the calling thread to the heap and publish its pending
+   * statistics.
+   */
+  static void drainThreadCache();
+
+  /**
+   * @return a snapshot of the process wide pool statistics.
+   */
+  static Stats stats();
+};
+
+} // namespace Buffer
+} // namespace Envoy
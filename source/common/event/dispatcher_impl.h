@@ -18,6 +18,7 @@
 #include "source/common/common/thread.h"
 #include "source/common/event/libevent.h"
 #include "source/common/event/libevent_scheduler.h"
+#include "source/common/event/timer_wheel_scheduler.h"
 #include "source/common/signal/fatal_error_handler.h"
 
 #include "absl/container/inlined_vector.h"
@@ -40,14 +41,18 @@ public:
   DispatcherImpl(const std::string& name, Api::Api& api, Event::TimeSystem& time_system);
   DispatcherImpl(const std::string& name, Api::Api& api, Event::TimeSystem& time_systems,
                  const Buffer::WatermarkFactorySharedPtr& watermark_factory);
+  // If use_timer_wheel is true, millisecond timers are kept in a TimerWheelScheduler rather than
+  // in libevent.
   DispatcherImpl(const std::string& name, Api::Api& api, Event::TimeSystem& time_system,
                  const ScaledRangeTimerManagerFactory& scaled_timer_factory,
-                 const Buffer::WatermarkFactorySharedPtr& watermark_factory);
+                 const Buffer::WatermarkFactorySharedPtr& watermark_factory,
+                 bool use_timer_wheel = false);
   DispatcherImpl(const std::string& name, Thread::ThreadFactory& thread_factory,
                  TimeSource& time_source, Filesystem::Instance& file_system,
                  Event::TimeSystem& time_system,
                  const ScaledRangeTimerManagerFactory& scaled_timer_factory,
-                 const Buffer::WatermarkFactorySharedPtr& watermark_factory);
+                 const Buffer::WatermarkFactorySharedPtr& watermark_factory,
+                 bool use_timer_wheel = false);
   ~DispatcherImpl() override;
 
   /**
@@ -61,6 +66,7 @@ public:
                         std::chrono::milliseconds min_touch_interval) override;
   TimeSource& timeSource() override { return time_source_; }
   void initializeStats(Stats::Scope& scope, const absl::optional<std::string>& prefix) override;
+  std::chrono::microseconds loopLatency() const override { return base_scheduler_.loopLatency(); }
   void clearDeferredDeleteList() override;
   Network::ServerConnectionPtr
   createServerConnection(Network::ConnectionSocketPtr&& socket,
@@ -149,6 +155,8 @@ private:
   Thread::ThreadId run_tid_;
   Buffer::WatermarkFactorySharedPtr buffer_factory_;
   LibeventScheduler base_scheduler_;
+  // Set if timers are kept in a timer wheel, in which case it is the base of scheduler_.
+  std::unique_ptr<TimerWheelScheduler> timer_wheel_;
   SchedulerPtr scheduler_;
 
   SchedulableCallbackPtr thread_local_delete_cb_;
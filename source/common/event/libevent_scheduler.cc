@@ -10,9 +10,14 @@ namespace Envoy {
 namespace Event {
 
 namespace {
+uint64_t toMicroseconds(const timeval& tv) { return tv.tv_sec * 1000000 + tv.tv_usec; }
+
 void recordTimeval(Stats::Histogram& histogram, const timeval& tv) {
-  histogram.recordValue(tv.tv_sec * 1000000 + tv.tv_usec);
+  histogram.recordValue(toMicroseconds(tv));
 }
+
+// Weight of the newest sample in the loop latency moving average is 1/2^kLoopLatencyDecayShift.
+constexpr uint64_t kLoopLatencyDecayShift = 3;
 } // namespace
 
 LibeventScheduler::LibeventScheduler() {
@@ -101,6 +106,7 @@ void LibeventScheduler::onPrepareForStats(evwatch*, const evwatch_prepare_cb_inf
     timeval delta;
     evutil_timersub(&self->prepare_time_, &self->check_time_, &delta);
     recordTimeval(self->stats_->loop_duration_us_, delta);
+    self->loop_duration_us_ = toMicroseconds(delta);
   }
 }
 
@@ -112,6 +118,7 @@ void LibeventScheduler::onCheckForStats(evwatch*, const evwatch_check_cb_info*,
   // from above to compute the actual polling duration, and store it for the next iteration of the
   // event loop to compute the loop duration.
   evutil_gettimeofday(&self->check_time_, nullptr);
+  uint64_t latency_us = self->loop_duration_us_;
   if (self->timeout_set_) {
     timeval delta, delay;
     evutil_timersub(&self->check_time_, &self->prepare_time_, &delta);
@@ -123,8 +130,15 @@ void LibeventScheduler::onCheckForStats(evwatch*, const evwatch_check_cb_info*,
     // particularly useful.
     if (delay.tv_sec >= 0) {
       recordTimeval(self->stats_->poll_delay_us_, delay);
+      latency_us += toMicroseconds(delay);
     }
   }
+
+  // Only this thread writes the average, so a plain load and store is enough.
+  const uint64_t average = self->loop_latency_us_.load(std::memory_order_relaxed);
+  self->loop_latency_us_.store(
+      average - (average >> kLoopLatencyDecayShift) + (latency_us >> kLoopLatencyDecayShift),
+      std::memory_order_relaxed);
 }
 
 } // namespace Event
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 
 #include "envoy/event/dispatcher.h"
@@ -99,6 +101,14 @@ public:
    */
   void initializeStats(DispatcherStats* stats);
 
+  /**
+   * @return a moving average of the loop duration plus poll delay of recent event loop iterations,
+   *         as recorded for stats. Zero until stats are initialized. May be called from any thread.
+   */
+  std::chrono::microseconds loopLatency() const {
+    return std::chrono::microseconds(loop_latency_us_.load(std::memory_order_relaxed));
+  }
+
 private:
   static void onPrepareForCallback(evwatch*, const evwatch_prepare_cb_info* info, void* arg);
   static void onPrepareForStats(evwatch*, const evwatch_prepare_cb_info* info, void* arg);
@@ -121,6 +131,11 @@ private:
   timeval prepare_time_{};   // timestamp immediately before polling
   timeval check_time_{};     // timestamp immediately after polling
   OnPrepareCallback callback_; // callback to be called from onPrepareForCallback()
+
+  // Loop duration of the current event loop iteration, folded into loop_latency_us_ together with
+  // the poll delay once polling returns.
+  uint64_t loop_duration_us_{};
+  std::atomic<uint64_t> loop_latency_us_{};
 };
 
 } // namespace Event
@@ -1,8 +1,10 @@
 #include "source/common/event/scaled_range_timer_manager_impl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <memory>
+#include <vector>
 
 #include "envoy/event/timer.h"
 
@@ -138,11 +140,16 @@ private:
 };
 
 ScaledRangeTimerManagerImpl::ScaledRangeTimerManagerImpl(
-    Dispatcher& dispatcher, const ScaledTimerTypeMapConstSharedPtr& timer_minimums)
+    Dispatcher& dispatcher, const ScaledTimerTypeMapConstSharedPtr& timer_minimums,
+    std::chrono::milliseconds coalescing_window)
     : dispatcher_(dispatcher),
       timer_minimums_(timer_minimums != nullptr ? timer_minimums
                                                 : std::make_shared<ScaledTimerTypeMap>()),
-      scale_factor_(1.0) {}
+      scale_factor_(1.0),
+      coalescing_window_(std::max(coalescing_window, std::chrono::milliseconds::zero())),
+      coalesced_timer_(coalescing() ? dispatcher.createTimer([this] { onCoalescedTimerFired(); })
+                                    : nullptr),
+      coalesced_timer_time_(MonotonicTime::max()) {}
 
 ScaledRangeTimerManagerImpl::~ScaledRangeTimerManagerImpl() {
   // Scaled timers created by the manager shouldn't outlive it. This is
@@ -166,6 +173,10 @@ TimerPtr ScaledRangeTimerManagerImpl::createTimer(ScaledTimerMinimum minimum, Ti
 void ScaledRangeTimerManagerImpl::setScaleFactor(UnitFloat scale_factor) {
   const MonotonicTime now = dispatcher_.approximateMonotonicTime();
   scale_factor_ = scale_factor;
+  if (coalescing()) {
+    resetCoalescedTimer(now);
+    return;
+  }
   for (auto& queue : queues_) {
     resetQueueTimer(*queue, now);
   }
@@ -178,7 +189,10 @@ ScaledRangeTimerManagerImpl::Queue::Queue(std::chrono::milliseconds duration,
                                           ScaledRangeTimerManagerImpl& manager,
                                           Dispatcher& dispatcher)
     : duration_(duration),
-      timer_(dispatcher.createTimer([this, &manager] { manager.onQueueTimerFired(*this); })) {}
+      timer_(manager.coalescing()
+                 ? nullptr
+                 : dispatcher.createTimer([this, &manager] { manager.onQueueTimerFired(*this); })) {
+}
 
 ScaledRangeTimerManagerImpl::ScalingTimerHandle::ScalingTimerHandle(Queue& queue,
                                                                     Queue::Iterator iterator)
@@ -197,6 +211,12 @@ ScaledRangeTimerManagerImpl::activateTimer(std::chrono::milliseconds duration,
   // Ensure this is being called on the same dispatcher.
   ASSERT(dispatcher_.isThreadSafe());
 
+  // When coalescing, round the duration up to a multiple of the window so that timers with similar
+  // durations share a queue.
+  if (coalescing() && duration % coalescing_window_ != std::chrono::milliseconds::zero()) {
+    duration += coalescing_window_ - duration % coalescing_window_;
+  }
+
   // Find the matching queue for the (max - min) duration of the range timer; if there isn't one,
   // create it.
   auto it = queues_.find(duration);
@@ -209,9 +229,15 @@ ScaledRangeTimerManagerImpl::activateTimer(std::chrono::milliseconds duration,
   // Put the timer at the back of the queue. Since the timer has the same maximum duration as all
   // the other timers in the queue, and since the activation times are monotonic, the queue stays in
   // sorted order.
-  queue.range_timers_.emplace_back(range_timer, dispatcher_.approximateMonotonicTime());
+  const MonotonicTime now = dispatcher_.approximateMonotonicTime();
+  queue.range_timers_.emplace_back(range_timer, now);
   if (queue.range_timers_.size() == 1) {
-    resetQueueTimer(queue, dispatcher_.approximateMonotonicTime());
+    if (coalescing()) {
+      scheduleCoalescedTimer(
+          computeTriggerTime(queue.range_timers_.front(), duration, scale_factor_), now);
+    } else {
+      resetQueueTimer(queue, now);
+    }
   }
 
   return {queue, --queue.range_timers_.end()};
@@ -226,16 +252,18 @@ void ScaledRangeTimerManagerImpl::removeTimer(ScalingTimerHandle handle) {
   // Don't keep around empty queues
   if (handle.queue_.range_timers_.empty()) {
     // Skip erasing the queue if we're in the middle of processing timers for the queue. The
-    // queue will be erased in `onQueueTimerFired` after the queue entries have been processed.
-    if (!handle.queue_.processing_timers_) {
+    // queue will be erased in `onQueueTimerFired` after the queue entries have been processed, or
+    // in `onCoalescedTimerFired` after the batch has been processed.
+    if (!handle.queue_.processing_timers_ && !processing_batch_) {
       queues_.erase(handle.queue_);
     }
     return;
   }
 
   // The queue's timer tracks the expiration time of the first range timer, so it only needs
-  // adjusting if the first timer is the one that was removed.
-  if (was_front) {
+  // adjusting if the first timer is the one that was removed. The coalesced timer is left as it
+  // is, as firing early for a batch with nothing due costs less than finding the earliest queue.
+  if (was_front && !coalescing()) {
     resetQueueTimer(handle.queue_, dispatcher_.approximateMonotonicTime());
   }
 }
@@ -276,5 +304,75 @@ void ScaledRangeTimerManagerImpl::onQueueTimerFired(Queue& queue) {
   }
 }
 
+void ScaledRangeTimerManagerImpl::resetCoalescedTimer(MonotonicTime now) {
+  MonotonicTime trigger_time = MonotonicTime::max();
+  for (const auto& queue : queues_) {
+    ASSERT(!queue->range_timers_.empty());
+    trigger_time = std::min(trigger_time, computeTriggerTime(queue->range_timers_.front(),
+                                                             queue->duration_, scale_factor_));
+  }
+  coalesced_timer_time_ = MonotonicTime::max();
+  if (trigger_time == MonotonicTime::max()) {
+    coalesced_timer_->disableTimer();
+    return;
+  }
+  scheduleCoalescedTimer(trigger_time, now);
+}
+
+void ScaledRangeTimerManagerImpl::scheduleCoalescedTimer(MonotonicTime trigger_time,
+                                                         MonotonicTime now) {
+  // Round up to a multiple of the window, so that timers expiring within a window fire together.
+  const auto window = std::chrono::duration_cast<MonotonicTime::duration>(coalescing_window_);
+  const auto remainder = trigger_time.time_since_epoch() % window;
+  if (remainder > MonotonicTime::duration::zero()) {
+    trigger_time += window - remainder;
+  }
+  if (trigger_time >= coalesced_timer_time_) {
+    return;
+  }
+  coalesced_timer_time_ = trigger_time;
+  coalesced_timer_->enableTimer(
+      trigger_time > now ? std::chrono::ceil<std::chrono::milliseconds>(trigger_time - now)
+                         : std::chrono::milliseconds::zero());
+}
+
+void ScaledRangeTimerManagerImpl::onCoalescedTimerFired() {
+  // Everything due by the time the timer was armed for belongs to this batch, even if the loop
+  // woke a little early.
+  const MonotonicTime now = std::max(dispatcher_.approximateMonotonicTime(), coalesced_timer_time_);
+  coalesced_timer_time_ = MonotonicTime::max();
+
+  // Collect the queues with timers due first, since the callbacks may add queues.
+  std::vector<Queue*> due_queues;
+  for (const auto& queue : queues_) {
+    if (computeTriggerTime(queue->range_timers_.front(), queue->duration_, scale_factor_) <= now) {
+      due_queues.push_back(queue.get());
+    }
+  }
+
+  // No queue is erased while processing the batch, so the pointers stay valid.
+  processing_batch_ = true;
+  for (Queue* queue : due_queues) {
+    auto& timers = queue->range_timers_;
+    while (!timers.empty() &&
+           computeTriggerTime(timers.front(), queue->duration_, scale_factor_) <= now) {
+      auto item = std::move(timers.front());
+      timers.pop_front();
+      item.timer_.trigger();
+    }
+  }
+  processing_batch_ = false;
+
+  // Maintain the invariant that queues are never empty.
+  for (auto it = queues_.begin(); it != queues_.end();) {
+    if ((*it)->range_timers_.empty()) {
+      queues_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  resetCoalescedTimer(dispatcher_.approximateMonotonicTime());
+}
+
 } // namespace Event
 } // namespace Envoy
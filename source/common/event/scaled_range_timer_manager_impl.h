@@ -20,12 +20,21 @@ namespace Event {
  * expectation is that the number of (max - min) values used to enable timers is small, so the
  * number of queues is tightly bounded. The queue-based implementation depends on that expectation
  * for efficient operation.
+ *
+ * If a coalescing window is given, durations are rounded up to a multiple of the window before
+ * picking a queue, which bounds the number of queues however varied the durations are. The queues
+ * then share a single real Timer, armed for the earliest expiration rounded up to a multiple of the
+ * window, so timers expiring within the same window are triggered together in one batch. Changing
+ * the scale factor takes time linear in the number of queues in either mode. A timer may trigger up
+ * to a window late for rounding its duration up, and up to another for waiting for its batch.
  */
 class ScaledRangeTimerManagerImpl : public ScaledRangeTimerManager {
 public:
-  // Takes a Dispatcher and a map from timer type to scaled minimum value.
-  ScaledRangeTimerManagerImpl(Dispatcher& dispatcher,
-                              const ScaledTimerTypeMapConstSharedPtr& timer_minimums = nullptr);
+  // Takes a Dispatcher, a map from timer type to scaled minimum value and the coalescing window,
+  // where zero disables coalescing.
+  ScaledRangeTimerManagerImpl(
+      Dispatcher& dispatcher, const ScaledTimerTypeMapConstSharedPtr& timer_minimums = nullptr,
+      std::chrono::milliseconds coalescing_window = std::chrono::milliseconds::zero());
   ~ScaledRangeTimerManagerImpl() override;
 
   // ScaledRangeTimerManager impl
@@ -67,6 +76,7 @@ private:
     //   1) at queue creation time
     //   2) on expiration
     //   3) when the scale factor changes
+    // Not set when coalescing, as the queues share coalesced_timer_ instead.
     const TimerPtr timer_;
 
     // A flag indicating whether the queue is currently processing timers. Used to guard against
@@ -122,10 +132,27 @@ private:
 
   void onQueueTimerFired(Queue& queue);
 
+  bool coalescing() const { return coalescing_window_ > std::chrono::milliseconds::zero(); }
+
+  // Arms coalesced_timer_ for the earliest expiration of any queue.
+  void resetCoalescedTimer(MonotonicTime now);
+
+  // Arms coalesced_timer_ for the window of trigger_time, unless it is armed for an earlier one.
+  void scheduleCoalescedTimer(MonotonicTime trigger_time, MonotonicTime now);
+
+  void onCoalescedTimerFired();
+
   Dispatcher& dispatcher_;
   const ScaledTimerTypeMapConstSharedPtr timer_minimums_;
   UnitFloat scale_factor_;
+  const std::chrono::milliseconds coalescing_window_;
   absl::flat_hash_set<std::unique_ptr<Queue>, Hash, Eq> queues_;
+
+  // The Timer shared by all the queues when coalescing, and the time it is armed for.
+  const TimerPtr coalesced_timer_;
+  MonotonicTime coalesced_timer_time_;
+  // Set while a batch of coalesced timers is being triggered, during which queues are not erased.
+  bool processing_batch_{false};
 };
 
 } // namespace Event
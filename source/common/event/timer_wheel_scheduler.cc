@@ -0,0 +1,284 @@
+#include "source/common/event/timer_wheel_scheduler.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/scope_tracker.h"
+
+namespace Envoy {
+namespace Event {
+
+class TimerWheelScheduler::WheelTimer : public Timer, public Link {
+public:
+  WheelTimer(TimerWheelScheduler& scheduler, const TimerCb& cb, Dispatcher& dispatcher)
+      : scheduler_(scheduler), cb_(cb), dispatcher_(dispatcher) {
+    ASSERT(cb_);
+  }
+  ~WheelTimer() override {
+    if (linked()) {
+      scheduler_.disable(*this);
+    }
+  }
+
+  // Timer
+  void disableTimer() override {
+    ASSERT(dispatcher_.isThreadSafe());
+    if (linked()) {
+      scheduler_.disable(*this);
+    }
+    if (hr_timer_ != nullptr) {
+      hr_timer_->disableTimer();
+    }
+  }
+  void enableTimer(std::chrono::milliseconds duration, const ScopeTrackedObject* object) override {
+    ASSERT(dispatcher_.isThreadSafe());
+    if (hr_timer_ != nullptr) {
+      hr_timer_->disableTimer();
+    }
+    object_ = object;
+    scheduler_.enable(*this, duration);
+  }
+  void enableHRTimer(std::chrono::microseconds duration,
+                     const ScopeTrackedObject* object) override {
+    ASSERT(dispatcher_.isThreadSafe());
+    if (linked()) {
+      scheduler_.disable(*this);
+    }
+    if (hr_timer_ == nullptr) {
+      hr_timer_ = scheduler_.base_scheduler_.createTimer(cb_, dispatcher_);
+    }
+    hr_timer_->enableHRTimer(duration, object);
+  }
+  bool enabled() override {
+    ASSERT(dispatcher_.isThreadSafe());
+    return linked() || (hr_timer_ != nullptr && hr_timer_->enabled());
+  }
+
+  void run() {
+    if (object_ == nullptr) {
+      cb_();
+      return;
+    }
+    ScopeTrackerScopeState scope(object_, dispatcher_);
+    object_ = nullptr;
+    cb_();
+  }
+
+  // The tick at which the timer expires.
+  uint64_t expiry_tick_{0};
+  // The level of the wheel holding the timer, or DueLevel.
+  uint32_t level_{DueLevel};
+
+private:
+  TimerWheelScheduler& scheduler_;
+  const TimerCb cb_;
+  Dispatcher& dispatcher_;
+  const ScopeTrackedObject* object_{};
+  // Created on the first enableHRTimer().
+  TimerPtr hr_timer_;
+};
+
+void TimerWheelScheduler::Link::unlink() {
+  prev_->next_ = next_;
+  next_->prev_ = prev_;
+  prev_ = this;
+  next_ = this;
+}
+
+void TimerWheelScheduler::Link::linkBefore(Link& next) {
+  ASSERT(!linked());
+  prev_ = next.prev_;
+  next_ = &next;
+  next.prev_->next_ = this;
+  next.prev_ = this;
+}
+
+TimerWheelScheduler::TimerWheelScheduler(Scheduler& base_scheduler, Dispatcher& dispatcher,
+                                         TimeSource& time_source)
+    : base_scheduler_(base_scheduler), time_source_(time_source),
+      start_(time_source.monotonicTime()),
+      driver_(base_scheduler.createTimer([this]() { onDriverTimer(); }, dispatcher)) {}
+
+TimerWheelScheduler::~TimerWheelScheduler() { ASSERT(enabled_timers_ == 0); }
+
+TimerPtr TimerWheelScheduler::createTimer(const TimerCb& cb, Dispatcher& dispatcher) {
+  return std::make_unique<WheelTimer>(*this, cb, dispatcher);
+}
+
+void TimerWheelScheduler::enable(WheelTimer& timer, std::chrono::milliseconds duration) {
+  if (timer.linked()) {
+    disable(timer);
+  }
+  if (duration.count() < 0) {
+    IS_ENVOY_BUG(fmt::format("Negative duration passed to enableTimer(): {}", duration.count()));
+    duration = std::chrono::milliseconds(0);
+  }
+  enabled_timers_++;
+  uint64_t wake_tick;
+  if (duration.count() == 0) {
+    // As with libevent, a timer enabled for no time runs on the next iteration of the event loop.
+    timer.level_ = DueLevel;
+    timer.linkBefore(due_);
+    wake_tick = current_tick_;
+  } else {
+    if (enabled_timers_ == 1) {
+      // Skip the ticks the wheel was idle for, rather than processing them when it next wakes.
+      current_tick_ = std::max(current_tick_, nowTicks(false));
+    }
+    // Durations beyond the span of the wheel are clipped, as place() parks such timers at the top
+    // level in any case.
+    constexpr uint64_t MaxTicks = uint64_t(1) << (SlotBits * (Levels + 1));
+    timer.expiry_tick_ =
+        nowTicks(true) + std::min<uint64_t>(static_cast<uint64_t>(duration.count()), MaxTicks);
+    wake_tick = place(timer);
+  }
+  if (wake_tick < driver_tick_) {
+    armDriver(wake_tick);
+  }
+}
+
+void TimerWheelScheduler::disable(WheelTimer& timer) {
+  ASSERT(timer.linked());
+  if (timer.level_ != DueLevel) {
+    level_timers_[timer.level_]--;
+  }
+  timer.unlink();
+  enabled_timers_--;
+}
+
+uint64_t TimerWheelScheduler::place(WheelTimer& timer) {
+  ASSERT(timer.expiry_tick_ >= current_tick_);
+  const uint64_t delta = timer.expiry_tick_ - current_tick_;
+  uint32_t level = 0;
+  while (level + 1 < Levels && delta >> (SlotBits * (level + 1)) != 0) {
+    level++;
+  }
+  // A timer beyond the span of the top level is kept in its furthest slot, and placed again from
+  // there when the wheel reaches it.
+  const uint64_t tick =
+      std::min(timer.expiry_tick_, current_tick_ + (uint64_t(1) << (SlotBits * Levels)) - 1);
+  const uint32_t shift = SlotBits * level;
+  timer.level_ = level;
+  timer.linkBefore(slots_[level][(tick >> shift) & SlotMask]);
+  level_timers_[level]++;
+  return (tick >> shift) << shift;
+}
+
+void TimerWheelScheduler::cascade(Link& slot) {
+  while (slot.linked()) {
+    auto& timer = static_cast<WheelTimer&>(*slot.next_);
+    level_timers_[timer.level_]--;
+    timer.unlink();
+    place(timer);
+  }
+}
+
+void TimerWheelScheduler::expire(Link& list, Link& expired) {
+  while (list.linked()) {
+    auto& timer = static_cast<WheelTimer&>(*list.next_);
+    if (timer.level_ != DueLevel) {
+      level_timers_[timer.level_]--;
+      timer.level_ = DueLevel;
+    }
+    timer.unlink();
+    timer.linkBefore(expired);
+  }
+}
+
+void TimerWheelScheduler::onDriverTimer() {
+  driver_tick_ = NotArmed;
+  Link expired;
+  expire(due_, expired);
+  advance(nowTicks(false), expired);
+
+  // Run the timers in the order they expired. A callback may disable or delete the timers which
+  // follow it, which unlinks them from expired, or enable them again, which moves them back into
+  // the wheel.
+  while (expired.linked()) {
+    auto& timer = static_cast<WheelTimer&>(*expired.next_);
+    timer.unlink();
+    enabled_timers_--;
+    timer.run();
+  }
+
+  const uint64_t wake_tick = nextWakeTick();
+  if (wake_tick != driver_tick_) {
+    armDriver(wake_tick);
+  }
+}
+
+void TimerWheelScheduler::advance(uint64_t target, Link& expired) {
+  while (current_tick_ < target) {
+    if (level_timers_[0] == 0) {
+      // No timer expires before the next tick at which timers move down from the lowest level
+      // holding any, so skip to it.
+      uint32_t level = 1;
+      while (level < Levels && level_timers_[level] == 0) {
+        level++;
+      }
+      if (level == Levels) {
+        current_tick_ = target;
+        return;
+      }
+      const uint64_t last_tick_of_slot = current_tick_ | ((uint64_t(1) << (SlotBits * level)) - 1);
+      if (last_tick_of_slot >= target) {
+        current_tick_ = target;
+        return;
+      }
+      current_tick_ = last_tick_of_slot;
+    }
+    current_tick_++;
+    // On reaching the start of a slot of a level, its timers move down to the levels below.
+    for (uint32_t level = 1; level < Levels; level++) {
+      const uint32_t shift = SlotBits * level;
+      if ((current_tick_ & ((uint64_t(1) << shift) - 1)) != 0) {
+        break;
+      }
+      cascade(slots_[level][(current_tick_ >> shift) & SlotMask]);
+    }
+    expire(slots_[0][current_tick_ & SlotMask], expired);
+  }
+}
+
+uint64_t TimerWheelScheduler::nextWakeTick() const {
+  if (due_.linked()) {
+    return current_tick_;
+  }
+  uint64_t wake_tick = NotArmed;
+  for (uint32_t level = 0; level < Levels; level++) {
+    if (level_timers_[level] == 0) {
+      continue;
+    }
+    const uint32_t shift = SlotBits * level;
+    const uint64_t current_slot = current_tick_ >> shift;
+    for (uint64_t slot = current_slot + 1; slot <= current_slot + SlotsPerLevel; slot++) {
+      if (slots_[level][slot & SlotMask].linked()) {
+        wake_tick = std::min(wake_tick, slot << shift);
+        break;
+      }
+    }
+  }
+  return wake_tick;
+}
+
+void TimerWheelScheduler::armDriver(uint64_t tick) {
+  driver_tick_ = tick;
+  if (tick == NotArmed) {
+    driver_->disableTimer();
+    return;
+  }
+  const MonotonicTime wake_time = start_ + std::chrono::milliseconds(tick);
+  const MonotonicTime now = time_source_.monotonicTime();
+  driver_->enableHRTimer(
+      wake_time > now ? std::chrono::ceil<std::chrono::microseconds>(wake_time - now)
+                      : std::chrono::microseconds(0));
+}
+
+uint64_t TimerWheelScheduler::nowTicks(bool round_up) const {
+  const auto elapsed = time_source_.monotonicTime() - start_;
+  return round_up ? std::chrono::ceil<std::chrono::milliseconds>(elapsed).count()
+                  : std::chrono::floor<std::chrono::milliseconds>(elapsed).count();
+}
+
+} // namespace Event
+} // namespace Envoy
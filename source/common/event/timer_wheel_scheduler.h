@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * A Scheduler which keeps timers in a hierarchical timing wheel of millisecond ticks, so that
+ * enabling and disabling a timer takes constant time however many timers are outstanding. libevent
+ * keeps timers in a min-heap, where both take time logarithmic in the number of timers.
+ *
+ * Each level of the wheel has 256 slots, a slot of level n covering 256^n ticks. A timer is kept
+ * in the lowest level whose span covers its expiry, and is moved down a level each time the wheel
+ * reaches the start of its slot. The wheel is driven by a single timer from the base scheduler,
+ * armed for the next tick at which a timer expires or is moved down.
+ *
+ * Timers fire no earlier than requested and at most a tick later. High resolution timers need
+ * better than tick precision, so they are passed on to the base scheduler.
+ */
+class TimerWheelScheduler : public Scheduler {
+public:
+  TimerWheelScheduler(Scheduler& base_scheduler, Dispatcher& dispatcher, TimeSource& time_source);
+  ~TimerWheelScheduler() override;
+
+  // Scheduler
+  TimerPtr createTimer(const TimerCb& cb, Dispatcher& dispatcher) override;
+
+  /**
+   * @return the number of timers enabled in the wheel, not counting high resolution timers.
+   */
+  uint64_t enabledTimers() const { return enabled_timers_; }
+
+  static constexpr uint32_t SlotBits = 8;
+  static constexpr uint32_t SlotsPerLevel = 1 << SlotBits;
+  static constexpr uint64_t SlotMask = SlotsPerLevel - 1;
+  static constexpr uint32_t Levels = 4;
+
+private:
+  class WheelTimer;
+
+  // A link of an intrusive circular list. A list is headed by a link of its own, which is linked
+  // to itself when the list is empty.
+  struct Link {
+    Link() = default;
+    Link(const Link&) = delete;
+    Link& operator=(const Link&) = delete;
+
+    bool linked() const { return next_ != this; }
+    void unlink();
+    void linkBefore(Link& next);
+
+    Link* prev_{this};
+    Link* next_{this};
+  };
+
+  static constexpr uint64_t NotArmed = std::numeric_limits<uint64_t>::max();
+  // The level of timers which are not in the wheel, because they are due.
+  static constexpr uint32_t DueLevel = Levels;
+
+  void enable(WheelTimer& timer, std::chrono::milliseconds duration);
+  void disable(WheelTimer& timer);
+  // Adds a timer to the wheel, returning the tick at which it expires or moves down a level.
+  uint64_t place(WheelTimer& timer);
+  // Moves the timers of a slot to the levels below it.
+  void cascade(Link& slot);
+  // Moves the timers of a slot or of due_ to the end of expired.
+  void expire(Link& list, Link& expired);
+  void onDriverTimer();
+  // Processes the ticks up to and including target, moving the timers which expire to expired.
+  void advance(uint64_t target, Link& expired);
+  // @return the next tick at which a timer is due or has to be moved down a level.
+  uint64_t nextWakeTick() const;
+  void armDriver(uint64_t tick);
+  uint64_t nowTicks(bool round_up) const;
+
+  Scheduler& base_scheduler_;
+  TimeSource& time_source_;
+  const MonotonicTime start_;
+  const TimerPtr driver_;
+  // The last tick which has been processed.
+  uint64_t current_tick_{0};
+  // The tick for which driver_ is armed, or NotArmed.
+  uint64_t driver_tick_{NotArmed};
+  uint64_t enabled_timers_{0};
+  std::array<uint64_t, Levels> level_timers_{};
+  std::array<std::array<Link, SlotsPerLevel>, Levels> slots_;
+  // Timers enabled to expire on a tick which has already been processed. They are run by the next
+  // driver_ callback, so a timer which keeps enabling itself for no time does not starve the loop.
+  Link due_;
+};
+
+} // namespace Event
+} // namespace Envoy
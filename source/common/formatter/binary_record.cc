@@ -0,0 +1,65 @@
+#include "source/common/formatter/binary_record.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Formatter {
+
+namespace {
+
+uint32_t readLength(absl::string_view data) {
+  uint32_t length = 0;
+  for (size_t i = 0; i < BinaryRecord::LengthSize; i++) {
+    length |= static_cast<uint32_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+  }
+  return length;
+}
+
+} // namespace
+
+void BinaryRecord::appendLength(std::string& record, uint32_t length) {
+  record.append(LengthSize, '\0');
+  setLength(record, record.size() - LengthSize, length);
+}
+
+void BinaryRecord::setLength(std::string& record, size_t offset, uint32_t length) {
+  for (size_t i = 0; i < LengthSize; i++) {
+    record[offset + i] = static_cast<char>(length >> (8 * i));
+  }
+}
+
+absl::StatusOr<size_t>
+BinaryRecord::decode(absl::string_view data,
+                     std::vector<absl::optional<absl::string_view>>& columns) {
+  columns.clear();
+  if (data.size() < LengthSize) {
+    return 0;
+  }
+  const uint64_t record_size = LengthSize + uint64_t(readLength(data));
+  if (data.size() < record_size) {
+    return 0;
+  }
+  absl::string_view body = data.substr(LengthSize, record_size - LengthSize);
+  while (!body.empty()) {
+    if (body.size() < LengthSize) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("truncated column length in column ", columns.size()));
+    }
+    const uint32_t length = readLength(body);
+    body.remove_prefix(LengthSize);
+    if (length == AbsentLength) {
+      columns.emplace_back(absl::nullopt);
+      continue;
+    }
+    if (body.size() < length) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("column ", columns.size(), " overruns the record"));
+    }
+    columns.emplace_back(body.substr(0, length));
+    body.remove_prefix(length);
+  }
+  return record_size;
+}
+
+} // namespace Formatter
+} // namespace Envoy
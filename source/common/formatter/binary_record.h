@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Formatter {
+
+/**
+ * The records written by binary access log formats. A record is the length of the rest of the
+ * record, followed by the columns of the format in order, each being the length of its value and
+ * the value. Lengths are 32 bit little-endian integers, and the length of a column without a value
+ * is AbsentLength. The columns are only known from the format, so records of different formats
+ * must not be mixed.
+ */
+class BinaryRecord {
+public:
+  static constexpr size_t LengthSize = sizeof(uint32_t);
+  static constexpr uint32_t AbsentLength = 0xffffffff;
+
+  /**
+   * Appends a length to a record.
+   */
+  static void appendLength(std::string& record, uint32_t length);
+
+  /**
+   * Overwrites the length at an offset of a record.
+   */
+  static void setLength(std::string& record, size_t offset, uint32_t length);
+
+  /**
+   * Decodes the record at the start of data.
+   * @param data supplies the data, which may hold more than one record.
+   * @param columns receives the values of the columns of the record, which point into data, with
+   *        absl::nullopt for those without a value.
+   * @return the size of the record, 0 if data only holds part of it, or an error if the record is
+   *         malformed.
+   */
+  static absl::StatusOr<size_t> decode(absl::string_view data,
+                                       std::vector<absl::optional<absl::string_view>>& columns);
+};
+
+} // namespace Formatter
+} // namespace Envoy
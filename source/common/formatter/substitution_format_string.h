@@ -76,6 +76,9 @@ public:
                                                          context.serverFactoryContext().api()),
                                 std::string),
           config.omit_empty_values(), commands);
+    case envoy::config::core::v3::SubstitutionFormatString::FormatCase::kBinaryFormat:
+      return std::make_unique<BinaryFormatterBaseImpl<FormatterContext>>(
+          config.binary_format().columns(), commands);
     case envoy::config::core::v3::SubstitutionFormatString::FormatCase::FORMAT_NOT_SET:
       PANIC_DUE_TO_PROTO_UNSET;
     }
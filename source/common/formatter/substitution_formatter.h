@@ -12,6 +12,7 @@
 #include "envoy/stream_info/stream_info.h"
 
 #include "source/common/common/utility.h"
+#include "source/common/formatter/binary_record.h"
 #include "source/common/formatter/http_specific_formatter.h"
 #include "source/common/formatter/stream_info_formatter.h"
 #include "source/common/json/json_loader.h"
@@ -168,6 +169,63 @@ private:
   std::vector<FormatterProviderBasePtr<FormatterContext>> providers_;
 };
 
+/**
+ * Formatter writing length-prefixed binary records with a column for each of a list of format
+ * strings. @see BinaryRecord. Values are copied into the record as they are, without escaping. A
+ * column has no value if none of its command operators has one, and otherwise is formatted as by
+ * FormatterBaseImpl.
+ */
+template <class FormatterContext>
+class BinaryFormatterBaseImpl : public FormatterBase<FormatterContext> {
+public:
+  using CommandParsers = std::vector<CommandParserBasePtr<FormatterContext>>;
+
+  BinaryFormatterBaseImpl(const Protobuf::RepeatedPtrField<std::string>& columns,
+                          const CommandParsers& command_parsers = {}) {
+    columns_.reserve(columns.size());
+    for (const std::string& column : columns) {
+      columns_.push_back(
+          SubstitutionFormatParser::parse<FormatterContext>(column, command_parsers));
+    }
+  }
+
+  // FormatterBase
+  std::string formatWithContext(const FormatterContext& context,
+                                const StreamInfo::StreamInfo& stream_info) const override {
+    std::string record;
+    record.reserve(256);
+    BinaryRecord::appendLength(record, 0);
+
+    for (const auto& providers : columns_) {
+      const size_t length_offset = record.size();
+      BinaryRecord::appendLength(record, 0);
+      bool has_value = providers.empty();
+      for (const auto& provider : providers) {
+        const auto bit = provider->formatWithContext(context, stream_info);
+        if (bit.has_value()) {
+          record.append(bit.value());
+          has_value = true;
+        } else {
+          record.append(DefaultUnspecifiedValueStringView);
+        }
+      }
+      if (has_value) {
+        BinaryRecord::setLength(record, length_offset,
+                                record.size() - length_offset - BinaryRecord::LengthSize);
+      } else {
+        record.resize(length_offset + BinaryRecord::LengthSize);
+        BinaryRecord::setLength(record, length_offset, BinaryRecord::AbsentLength);
+      }
+    }
+
+    BinaryRecord::setLength(record, 0, record.size() - BinaryRecord::LengthSize);
+    return record;
+  }
+
+private:
+  std::vector<std::vector<FormatterProviderBasePtr<FormatterContext>>> columns_;
+};
+
 // Helper classes for StructFormatter::StructFormatMapVisitor.
 template <class... Ts> struct StructFormatMapVisitorHelper : Ts... { using Ts::operator()...; };
 template <class... Ts> StructFormatMapVisitorHelper(Ts...) -> StructFormatMapVisitorHelper<Ts...>;
@@ -374,6 +432,202 @@ private:
 template <class FormatterContext>
 using StructFormatterBasePtr = std::unique_ptr<StructFormatterBase<FormatterContext>>;
 
+/**
+ * A formatter for JSON log formats with sorted properties, which writes the log line directly
+ * rather than building a Struct and serializing it. The keys of the format are escaped once, when
+ * the formatter is created, and values which need no escaping are copied as they are. The output
+ * is identical to serializing the Struct of StructFormatterBase with Json::Factory.
+ */
+template <class FormatterContext> class SortedJsonFormatterBase {
+public:
+  using CommandParsers = std::vector<CommandParserBasePtr<FormatterContext>>;
+
+  SortedJsonFormatterBase(const ProtobufWkt::Struct& format_mapping, bool preserve_types,
+                          bool omit_empty_values, const CommandParsers& commands = {})
+      : omit_empty_values_(omit_empty_values), preserve_types_(preserve_types),
+        empty_value_(omit_empty_values_ ? std::string()
+                                        : std::string(DefaultUnspecifiedValueStringView)),
+        root_(toMapNode(format_mapping, commands)) {}
+
+  /**
+   * Appends the JSON of a log entry, without a trailing newline, to out.
+   */
+  void format(const FormatterContext& context, const StreamInfo::StreamInfo& info,
+              std::string& out) const {
+    if (!formatNode(root_, context, info, out)) {
+      // As for an empty Struct, which is what a map with all of its values omitted results in.
+      out.append("{}");
+    }
+  }
+
+private:
+  struct Node {
+    enum class Kind { Providers, Map, List };
+    Kind kind_;
+    // The providers of a value.
+    std::vector<FormatterProviderBasePtr<FormatterContext>> providers_;
+    // The keys of a map in sorted order, each serialized and followed by a colon.
+    std::vector<std::string> keys_;
+    // The values of a map, in the order of keys_, or the items of a list.
+    std::vector<Node> values_;
+  };
+
+  static Node toNode(const ProtobufWkt::Value& value, const CommandParsers& commands) {
+    switch (value.kind_case()) {
+    case ProtobufWkt::Value::kStringValue:
+      return {Node::Kind::Providers,
+              SubstitutionFormatParser::parse<FormatterContext>(value.string_value(), commands),
+              {},
+              {}};
+    case ProtobufWkt::Value::kStructValue:
+      return toMapNode(value.struct_value(), commands);
+    case ProtobufWkt::Value::kListValue: {
+      Node node{Node::Kind::List, {}, {}, {}};
+      for (const auto& item : value.list_value().values()) {
+        node.values_.push_back(toNode(item, commands));
+      }
+      return node;
+    }
+    case ProtobufWkt::Value::kNumberValue: {
+      Node node{Node::Kind::Providers, {}, {}, {}};
+      node.providers_.emplace_back(
+          new PlainNumberFormatterBase<FormatterContext>(value.number_value()));
+      return node;
+    }
+    default:
+      throwEnvoyExceptionOrPanic(
+          "Only string values, nested structs, list values and number values are "
+          "supported in structured access log format.");
+    }
+  }
+
+  static Node toMapNode(const ProtobufWkt::Struct& format_mapping, const CommandParsers& commands) {
+    std::map<std::string, const ProtobufWkt::Value*> sorted;
+    for (const auto& pair : format_mapping.fields()) {
+      sorted.emplace(pair.first, &pair.second);
+    }
+    Node node{Node::Kind::Map, {}, {}, {}};
+    for (const auto& [key, value] : sorted) {
+      node.keys_.push_back(
+          absl::StrCat(Json::Factory::serializeProtobufValue(ValueUtil::stringValue(key)), ":"));
+      node.values_.push_back(toNode(*value, commands));
+    }
+    return node;
+  }
+
+  // Appends the JSON of a node to out. Returns false, leaving out as it was, if the node is null
+  // and null values are omitted.
+  bool formatNode(const Node& node, const FormatterContext& context,
+                  const StreamInfo::StreamInfo& info, std::string& out) const {
+    switch (node.kind_) {
+    case Node::Kind::Providers:
+      return formatProviders(node.providers_, context, info, out);
+    case Node::Kind::Map: {
+      const size_t start = out.size();
+      out.push_back('{');
+      bool empty = true;
+      for (size_t i = 0; i < node.keys_.size(); i++) {
+        const size_t field_start = out.size();
+        if (!empty) {
+          out.push_back(',');
+        }
+        out.append(node.keys_[i]);
+        if (formatNode(node.values_[i], context, info, out)) {
+          empty = false;
+        } else {
+          out.resize(field_start);
+        }
+      }
+      if (omit_empty_values_ && empty) {
+        out.resize(start);
+        return false;
+      }
+      out.push_back('}');
+      return true;
+    }
+    case Node::Kind::List: {
+      out.push_back('[');
+      bool empty = true;
+      for (const Node& item : node.values_) {
+        const size_t item_start = out.size();
+        if (!empty) {
+          out.push_back(',');
+        }
+        if (formatNode(item, context, info, out)) {
+          empty = false;
+        } else {
+          out.resize(item_start);
+        }
+      }
+      out.push_back(']');
+      return true;
+    }
+    }
+    PANIC_DUE_TO_CORRUPT_ENUM;
+  }
+
+  // As StructFormatterBase::providersCallback().
+  bool formatProviders(const std::vector<FormatterProviderBasePtr<FormatterContext>>& providers,
+                       const FormatterContext& context, const StreamInfo::StreamInfo& info,
+                       std::string& out) const {
+    ASSERT(!providers.empty());
+    if (providers.size() == 1) {
+      const auto& provider = providers.front();
+      if (preserve_types_) {
+        const ProtobufWkt::Value value = provider->formatValueWithContext(context, info);
+        if (value.kind_case() == ProtobufWkt::Value::kNullValue) {
+          if (omit_empty_values_) {
+            return false;
+          }
+          out.append("null");
+          return true;
+        }
+        if (value.kind_case() == ProtobufWkt::Value::kStringValue) {
+          appendString(value.string_value(), out);
+          return true;
+        }
+        out.append(Json::Factory::serializeProtobufValue(value));
+        return true;
+      }
+
+      const auto str = provider->formatWithContext(context, info);
+      if (!str.has_value() && omit_empty_values_) {
+        return false;
+      }
+      appendString(str.has_value() ? str.value() : empty_value_, out);
+      return true;
+    }
+    // Multiple providers forces string output.
+    std::string str;
+    for (const auto& provider : providers) {
+      const auto bit = provider->formatWithContext(context, info);
+      str += bit.value_or(empty_value_);
+    }
+    appendString(str, out);
+    return true;
+  }
+
+  static void appendString(absl::string_view str, std::string& out) {
+    // Only control characters, quotes, backslashes and bytes which may be part of invalid UTF-8
+    // have to be escaped or replaced.
+    for (const char c : str) {
+      const uint8_t byte = static_cast<uint8_t>(c);
+      if (byte < 0x20 || byte >= 0x80 || c == '"' || c == '\\') {
+        out.append(Json::Factory::serializeProtobufValue(ValueUtil::stringValue(std::string(str))));
+        return;
+      }
+    }
+    out.push_back('"');
+    out.append(str.data(), str.size());
+    out.push_back('"');
+  }
+
+  const bool omit_empty_values_;
+  const bool preserve_types_;
+  const std::string empty_value_;
+  const Node root_;
+};
+
 template <class FormatterContext>
 class JsonFormatterBaseImpl : public FormatterBase<FormatterContext> {
 public:
@@ -382,31 +636,40 @@ public:
   JsonFormatterBaseImpl(const ProtobufWkt::Struct& format_mapping, bool preserve_types,
                         bool omit_empty_values, bool sort_properties,
                         const CommandParsers& commands = {})
-      : struct_formatter_(format_mapping, preserve_types, omit_empty_values, commands),
-        sort_properties_(sort_properties) {}
+      : struct_formatter_(sort_properties ? nullptr
+                                          : std::make_unique<StructFormatterBase<FormatterContext>>(
+                                                format_mapping, preserve_types, omit_empty_values,
+                                                commands)),
+        sorted_formatter_(sort_properties
+                              ? std::make_unique<SortedJsonFormatterBase<FormatterContext>>(
+                                    format_mapping, preserve_types, omit_empty_values, commands)
+                              : nullptr) {}
 
   // FormatterBase
   std::string formatWithContext(const FormatterContext& context,
                                 const StreamInfo::StreamInfo& info) const override {
-    const ProtobufWkt::Struct output_struct = struct_formatter_.formatWithContext(context, info);
-
     std::string log_line = "";
 #ifdef ENVOY_ENABLE_YAML
-    if (sort_properties_) {
-      log_line = Json::Factory::loadFromProtobufStruct(output_struct)->asJsonString();
+    if (sorted_formatter_ != nullptr) {
+      sorted_formatter_->format(context, info, log_line);
     } else {
+      const ProtobufWkt::Struct output_struct =
+          struct_formatter_->formatWithContext(context, info);
       log_line = MessageUtil::getJsonStringFromMessageOrError(output_struct, false, true);
     }
 #else
-    UNREFERENCED_PARAMETER(sort_properties_);
+    UNREFERENCED_PARAMETER(context);
+    UNREFERENCED_PARAMETER(info);
     IS_ENVOY_BUG("Json support compiled out");
 #endif
-    return absl::StrCat(log_line, "\n");
+    log_line.push_back('\n');
+    return log_line;
   }
 
 private:
-  const StructFormatterBase<FormatterContext> struct_formatter_;
-  const bool sort_properties_;
+  // Only one of these is set, the sorted formatter for formats with sorted properties.
+  const std::unique_ptr<const StructFormatterBase<FormatterContext>> struct_formatter_;
+  const std::unique_ptr<const SortedJsonFormatterBase<FormatterContext>> sorted_formatter_;
 };
 
 using StructFormatter = StructFormatterBase<HttpFormatterContext>;
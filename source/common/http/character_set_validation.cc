@@ -0,0 +1,174 @@
+#include "source/common/http/character_set_validation.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ENVOY_CHARACTER_SET_X86_64
+#include <immintrin.h>
+#endif
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+using Implementation = CharacterSet::Implementation;
+
+size_t findFirstNotInScalar(const CharacterSet& set, const char* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    if (!set.contains(data[i])) {
+      return i;
+    }
+  }
+  return size;
+}
+
+#ifdef ENVOY_CHARACTER_SET_X86_64
+
+// Bit `h` of the regrouped tables is selected by a character whose high nibble is `h` (ASCII) or
+// `h + 8` (extended). Indices outside each half select no bit.
+alignas(16) constexpr uint8_t kAsciiHighNibbleBits[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                                          0, 0, 0, 0, 0,  0,  0,  0};
+alignas(16) constexpr uint8_t kExtendedHighNibbleBits[16] = {0, 0, 0,  0,  0,  0,  0,  0,
+                                                             1, 2, 4, 8, 16, 32, 64, 128};
+
+// Returns a bitmask with bit i set if byte i of input is not in the set.
+__attribute__((target("ssse3"))) inline uint32_t notInSetMask(__m128i input, __m128i ascii,
+                                                              __m128i extended) {
+  const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+  const __m128i ascii_bits =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kAsciiHighNibbleBits));
+  const __m128i extended_bits =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kExtendedHighNibbleBits));
+  const __m128i low = _mm_and_si128(input, nibble_mask);
+  const __m128i high = _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask);
+  const __m128i found = _mm_or_si128(
+      _mm_and_si128(_mm_shuffle_epi8(ascii, low), _mm_shuffle_epi8(ascii_bits, high)),
+      _mm_and_si128(_mm_shuffle_epi8(extended, low), _mm_shuffle_epi8(extended_bits, high)));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(found, _mm_setzero_si128()));
+}
+
+__attribute__((target("avx2"))) inline uint32_t notInSetMask(__m256i input, __m256i ascii,
+                                                             __m256i extended) {
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+  const __m256i ascii_bits = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kAsciiHighNibbleBits)));
+  const __m256i extended_bits = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kExtendedHighNibbleBits)));
+  const __m256i low = _mm256_and_si256(input, nibble_mask);
+  const __m256i high = _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask);
+  const __m256i found = _mm256_or_si256(
+      _mm256_and_si256(_mm256_shuffle_epi8(ascii, low), _mm256_shuffle_epi8(ascii_bits, high)),
+      _mm256_and_si256(_mm256_shuffle_epi8(extended, low),
+                       _mm256_shuffle_epi8(extended_bits, high)));
+  return _mm256_movemask_epi8(_mm256_cmpeq_epi8(found, _mm256_setzero_si256()));
+}
+
+// Both vector paths finish with one unaligned load ending at the last byte, overlapping bytes that
+// were already checked, so strings shorter than a vector are left to the scalar path.
+__attribute__((target("ssse3"))) size_t findFirstNotInSsse3(const uint8_t* ascii_table,
+                                                            const uint8_t* extended_table,
+                                                            const char* data, size_t size) {
+  const __m128i ascii = _mm_load_si128(reinterpret_cast<const __m128i*>(ascii_table));
+  const __m128i extended = _mm_load_si128(reinterpret_cast<const __m128i*>(extended_table));
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const uint32_t mask = notInSetMask(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), ascii, extended);
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  if (i < size) {
+    i = size - 16;
+    const uint32_t mask = notInSetMask(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), ascii, extended);
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return size;
+}
+
+__attribute__((target("avx2"))) size_t findFirstNotInAvx2(const uint8_t* ascii_table,
+                                                          const uint8_t* extended_table,
+                                                          const char* data, size_t size) {
+  const __m256i ascii =
+      _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(ascii_table)));
+  const __m256i extended = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(extended_table)));
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const uint32_t mask = notInSetMask(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), ascii, extended);
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  if (i < size) {
+    i = size - 32;
+    const uint32_t mask = notInSetMask(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), ascii, extended);
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return size;
+}
+
+Implementation selectImplementation() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Implementation::Avx2;
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    return Implementation::Ssse3;
+  }
+  return Implementation::Scalar;
+}
+
+#else
+
+Implementation selectImplementation() { return Implementation::Scalar; }
+
+#endif
+
+Implementation bestImplementation() {
+  static const Implementation implementation = selectImplementation();
+  return implementation;
+}
+
+} // namespace
+
+bool CharacterSet::isSupported(Implementation implementation) {
+  switch (implementation) {
+  case Implementation::Scalar:
+    return true;
+  case Implementation::Ssse3:
+    return bestImplementation() != Implementation::Scalar;
+  case Implementation::Avx2:
+    return bestImplementation() == Implementation::Avx2;
+  }
+  return false;
+}
+
+size_t CharacterSet::findFirstNotIn(absl::string_view value) const {
+  return findFirstNotIn(value, bestImplementation());
+}
+
+size_t CharacterSet::findFirstNotIn(absl::string_view value,
+                                    Implementation implementation) const {
+#ifdef ENVOY_CHARACTER_SET_X86_64
+  if (implementation == Implementation::Avx2 && value.size() >= 32) {
+    return findFirstNotInAvx2(ascii_by_low_nibble_.data(), extended_by_low_nibble_.data(),
+                              value.data(), value.size());
+  }
+  if (implementation != Implementation::Scalar && value.size() >= 16) {
+    return findFirstNotInSsse3(ascii_by_low_nibble_.data(), extended_by_low_nibble_.data(),
+                               value.data(), value.size());
+  }
+#else
+  (void)implementation;
+#endif
+  return findFirstNotInScalar(*this, value.data(), value.size());
+}
+
+} // namespace Http
+} // namespace Envoy
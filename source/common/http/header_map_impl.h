@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstdint>
+#include <deque>
 #include <list>
 #include <memory>
 #include <string>
@@ -142,12 +143,22 @@ protected:
     const LowerCaseString* key_;
   };
 
+  /**
+   * A resolved inline header slot. The lookup table maps each inline header key directly to one
+   * of these, so a hit costs a single indexed load rather than a call through a type-erased
+   * callback.
+   */
+  struct StaticLookupEntry {
+    // Index of the header's slot in the inline header array of the header map.
+    size_t inline_index_;
+    const LowerCaseString* key_;
+  };
+
   /**
    * Base class for a static lookup table that converts a string key into an O(1) header.
    */
   template <class Interface>
-  struct StaticLookupTable
-      : public CompiledStringMap<std::function<StaticLookupResponse(HeaderMapImpl&)>> {
+  struct StaticLookupTable : public CompiledStringMap<const StaticLookupEntry*> {
     StaticLookupTable();
 
     std::vector<KV> finalizedTable() {
@@ -157,13 +168,18 @@ protected:
       std::vector<KV> input;
       input.reserve(size_);
       for (const auto& header : headers) {
-        input.emplace_back(header.first.get(), [&header](HeaderMapImpl& h) -> StaticLookupResponse {
-          return {&h.inlineHeaders()[header.second], &header.first};
-        });
+        input.emplace_back(header.first.get(), addEntry(header.second, header.first));
       }
       return input;
     }
 
+    // Entries are kept in a deque so that the pointers handed to the compiled map stay valid as
+    // aliases (e.g. the legacy host header) are added.
+    const StaticLookupEntry* addEntry(size_t inline_index, const LowerCaseString& key) {
+      entries_.push_back({inline_index, &key});
+      return &entries_.back();
+    }
+
     static size_t size() {
       // The size of the lookup table is finalized when the singleton lookup table is created. This
       // allows for late binding of custom headers as well as envoy header prefix changes. This
@@ -177,18 +193,20 @@ protected:
 
     static absl::optional<StaticLookupResponse> lookup(HeaderMapImpl& header_map,
                                                        absl::string_view key) {
-      const auto& entry = ConstSingleton<StaticLookupTable>::get().find(key);
+      const StaticLookupEntry* entry = ConstSingleton<StaticLookupTable>::get().find(key);
       if (entry != nullptr) {
-        return entry(header_map);
+        return StaticLookupResponse{&header_map.inlineHeaders()[entry->inline_index_],
+                                    entry->key_};
       } else {
         return absl::nullopt;
       }
     }
 
-    // This is the size of the number of callbacks; in the case of Requests,
+    // This is the size of the number of inline headers; in the case of Requests,
     // this is one smaller than the number of entries in the lookup table,
     // because of legacy `host` mapping to the same thing as `:authority`.
     size_t size_;
+    std::deque<StaticLookupEntry> entries_;
   };
 
   /**
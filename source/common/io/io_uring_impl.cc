@@ -4,6 +4,12 @@
 
 namespace Envoy {
 namespace Io {
+namespace {
+
+// The multishot recv requests all select their buffers from a single group.
+constexpr uint16_t ProvidedBufferGroupId = 0;
+
+} // namespace
 
 bool isIoUringSupported() {
   struct io_uring_params p {};
@@ -30,7 +36,12 @@ IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polli
   RELEASE_ASSERT(ret == 0, fmt::format("unable to initialize io_uring: {}", errorDetails(-ret)));
 }
 
-IoUringImpl::~IoUringImpl() { io_uring_queue_exit(&ring_); }
+IoUringImpl::~IoUringImpl() {
+  if (buf_ring_ != nullptr) {
+    io_uring_free_buf_ring(&ring_, buf_ring_, num_provided_buffers_, ProvidedBufferGroupId);
+  }
+  io_uring_queue_exit(&ring_);
+}
 
 os_fd_t IoUringImpl::registerEventfd() {
   ASSERT(!isEventfdRegistered());
@@ -69,7 +80,7 @@ void IoUringImpl::forEveryCompletion(const CompletionCb& completion_cb) {
 
   for (unsigned i = 0; i < count; ++i) {
     struct io_uring_cqe* cqe = cqes_[i];
-    completion_cb(reinterpret_cast<Request*>(cqe->user_data), cqe->res, false);
+    completion_cb(reinterpret_cast<Request*>(cqe->user_data), cqe->res, false, cqe->flags);
   }
 
   io_uring_cq_advance(&ring_, count);
@@ -80,7 +91,7 @@ void IoUringImpl::forEveryCompletion(const CompletionCb& completion_cb) {
   // Iterate the injected completion.
   while (!injected_completions_.empty()) {
     auto& completion = injected_completions_.front();
-    completion_cb(completion.user_data_, completion.result_, true);
+    completion_cb(completion.user_data_, completion.result_, true, 0);
     // The socket may closed in the completion_cb and all the related completions are
     // removed.
     if (injected_completions_.empty()) {
@@ -195,6 +206,89 @@ IoUringResult IoUringImpl::prepareShutdown(os_fd_t fd, int how, Request* user_da
   return IoUringResult::Ok;
 }
 
+IoUringResult IoUringImpl::registerBufferRing(uint32_t num_buffers, uint32_t buffer_size) {
+  ASSERT(buf_ring_ == nullptr);
+  ASSERT(num_buffers > 0 && num_buffers <= 32768 && (num_buffers & (num_buffers - 1)) == 0);
+  int ret = 0;
+  buf_ring_ = io_uring_setup_buf_ring(&ring_, num_buffers, ProvidedBufferGroupId, 0, &ret);
+  if (buf_ring_ == nullptr) {
+    ENVOY_LOG(debug, "unable to register provided buffer ring: {}", errorDetails(-ret));
+    return IoUringResult::Failed;
+  }
+
+  num_provided_buffers_ = num_buffers;
+  provided_buffer_size_ = buffer_size;
+  provided_buffers_ = std::make_unique<uint8_t[]>(static_cast<size_t>(num_buffers) * buffer_size);
+  const int mask = io_uring_buf_ring_mask(num_buffers);
+  for (uint32_t i = 0; i < num_buffers; i++) {
+    io_uring_buf_ring_add(buf_ring_, provided_buffers_.get() + static_cast<size_t>(i) * buffer_size,
+                          buffer_size, i, mask, i);
+  }
+  io_uring_buf_ring_advance(buf_ring_, num_buffers);
+  return IoUringResult::Ok;
+}
+
+const uint8_t* IoUringImpl::getProvidedBuffer(uint16_t buffer_id) const {
+  ASSERT(buffer_id < num_provided_buffers_);
+  return provided_buffers_.get() + static_cast<size_t>(buffer_id) * provided_buffer_size_;
+}
+
+void IoUringImpl::recycleProvidedBuffer(uint16_t buffer_id) {
+  ASSERT(buffer_id < num_provided_buffers_);
+  io_uring_buf_ring_add(buf_ring_,
+                        provided_buffers_.get() +
+                            static_cast<size_t>(buffer_id) * provided_buffer_size_,
+                        provided_buffer_size_, buffer_id,
+                        io_uring_buf_ring_mask(num_provided_buffers_), 0);
+  io_uring_buf_ring_advance(buf_ring_, 1);
+}
+
+IoUringResult IoUringImpl::prepareRecvMultishot(os_fd_t fd, Request* user_data) {
+  ENVOY_LOG(trace, "prepare multishot recv for fd = {}", fd);
+  ASSERT(buf_ring_ != nullptr);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    ENVOY_LOG(trace, "failed to prepare multishot recv for fd = {}", fd);
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = ProvidedBufferGroupId;
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
+bool IoUringImpl::isZeroCopySendSupported() {
+  struct io_uring_probe* probe = io_uring_get_probe_ring(&ring_);
+  if (probe == nullptr) {
+    return false;
+  }
+  const bool supported = io_uring_opcode_supported(probe, IORING_OP_SENDMSG_ZC);
+  io_uring_free_probe(probe);
+  return supported;
+}
+
+IoUringResult IoUringImpl::prepareSendmsgZeroCopy(os_fd_t fd, const struct msghdr* msg,
+                                                  Request* user_data) {
+  ENVOY_LOG(trace, "prepare zero copy sendmsg for fd = {}", fd);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    ENVOY_LOG(trace, "failed to prepare zero copy sendmsg for fd = {}", fd);
+    return IoUringResult::Failed;
+  }
+
+  // Let the kernel wait for socket buffer space rather than completing with a partial send, which
+  // would make the caller copy the rest of the data.
+  io_uring_prep_sendmsg_zc(sqe, fd, msg, MSG_WAITALL);
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::submit() {
   int res = io_uring_submit(&ring_);
   RELEASE_ASSERT(res >= 0 || res == -EBUSY, "unable to submit io_uring queue entries");
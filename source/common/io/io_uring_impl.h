@@ -43,6 +43,13 @@ public:
   IoUringResult prepareClose(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareCancel(Request* cancelling_user_data, Request* user_data) override;
   IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) override;
+  IoUringResult registerBufferRing(uint32_t num_buffers, uint32_t buffer_size) override;
+  const uint8_t* getProvidedBuffer(uint16_t buffer_id) const override;
+  void recycleProvidedBuffer(uint16_t buffer_id) override;
+  IoUringResult prepareRecvMultishot(os_fd_t fd, Request* user_data) override;
+  bool isZeroCopySendSupported() override;
+  IoUringResult prepareSendmsgZeroCopy(os_fd_t fd, const struct msghdr* msg,
+                                       Request* user_data) override;
   IoUringResult submit() override;
   void injectCompletion(os_fd_t fd, Request* user_data, int32_t result) override;
   void removeInjectedCompletion(os_fd_t fd) override;
@@ -52,6 +59,11 @@ private:
   std::vector<struct io_uring_cqe*> cqes_;
   os_fd_t event_fd_{INVALID_SOCKET};
   std::list<InjectedCompletion> injected_completions_;
+  // The provided buffer ring shared by all the multishot recv requests, and the memory backing it.
+  struct io_uring_buf_ring* buf_ring_{nullptr};
+  uint32_t num_provided_buffers_{0};
+  uint32_t provided_buffer_size_{0};
+  std::unique_ptr<uint8_t[]> provided_buffers_;
 };
 
 } // namespace Io
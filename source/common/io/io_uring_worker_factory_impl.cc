@@ -9,9 +9,14 @@ IoUringWorkerFactoryImpl::IoUringWorkerFactoryImpl(uint32_t io_uring_size,
                                                    bool use_submission_queue_polling,
                                                    uint32_t read_buffer_size,
                                                    uint32_t write_timeout_ms,
-                                                   ThreadLocal::SlotAllocator& tls)
+                                                   uint32_t buffer_ring_size,
+                                                   uint32_t zero_copy_send_threshold,
+                                                   ThreadLocal::SlotAllocator& tls,
+                                                   Stats::Scope& scope)
     : io_uring_size_(io_uring_size), use_submission_queue_polling_(use_submission_queue_polling),
-      read_buffer_size_(read_buffer_size), write_timeout_ms_(write_timeout_ms), tls_(tls) {}
+      read_buffer_size_(read_buffer_size), write_timeout_ms_(write_timeout_ms),
+      buffer_ring_size_(buffer_ring_size), zero_copy_send_threshold_(zero_copy_send_threshold),
+      tls_(tls), scope_(scope) {}
 
 OptRef<IoUringWorker> IoUringWorkerFactoryImpl::getIoUringWorker() {
   auto ret = tls_.get();
@@ -25,9 +30,12 @@ void IoUringWorkerFactoryImpl::onWorkerThreadInitialized() {
   tls_.set([io_uring_size = io_uring_size_,
             use_submission_queue_polling = use_submission_queue_polling_,
             read_buffer_size = read_buffer_size_,
-            write_timeout_ms = write_timeout_ms_](Event::Dispatcher& dispatcher) {
-    return std::make_shared<IoUringWorkerImpl>(io_uring_size, use_submission_queue_polling,
-                                               read_buffer_size, write_timeout_ms, dispatcher);
+            write_timeout_ms = write_timeout_ms_, buffer_ring_size = buffer_ring_size_,
+            zero_copy_send_threshold = zero_copy_send_threshold_,
+            &scope = scope_](Event::Dispatcher& dispatcher) {
+    return std::make_shared<IoUringWorkerImpl>(
+        io_uring_size, use_submission_queue_polling, read_buffer_size, write_timeout_ms,
+        buffer_ring_size, zero_copy_send_threshold, dispatcher, scope);
   });
 }
 
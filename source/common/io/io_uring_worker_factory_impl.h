@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/common/io/io_uring.h"
+#include "envoy/stats/scope.h"
 #include "envoy/thread_local/thread_local.h"
 
 namespace Envoy {
@@ -10,7 +11,8 @@ class IoUringWorkerFactoryImpl : public IoUringWorkerFactory {
 public:
   IoUringWorkerFactoryImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                            uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                           ThreadLocal::SlotAllocator& tls);
+                           uint32_t buffer_ring_size, uint32_t zero_copy_send_threshold,
+                           ThreadLocal::SlotAllocator& tls, Stats::Scope& scope);
 
   OptRef<IoUringWorker> getIoUringWorker() override;
 
@@ -22,7 +24,10 @@ private:
   const bool use_submission_queue_polling_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  const uint32_t buffer_ring_size_;
+  const uint32_t zero_copy_send_threshold_;
   ThreadLocal::TypedSlot<IoUringWorker> tls_;
+  Stats::Scope& scope_;
 };
 
 } // namespace Io
@@ -1,5 +1,8 @@
 #include "source/common/io/io_uring_worker_impl.h"
 
+#include <algorithm>
+#include <bit>
+
 namespace Envoy {
 namespace Io {
 
@@ -10,6 +13,8 @@ ReadRequest::ReadRequest(IoUringSocket& socket, uint32_t size)
   iov_->iov_len = size;
 }
 
+RecvRequest::RecvRequest(IoUringSocket& socket) : Request(RequestType::Recv, socket) {}
+
 WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices)
     : Request(RequestType::Write, socket), iov_(std::make_unique<struct iovec[]>(slices.size())) {
   for (size_t i = 0; i < slices.size(); i++) {
@@ -18,6 +23,20 @@ WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector&
   }
 }
 
+SendZeroCopyRequest::SendZeroCopyRequest(IoUringSocket& socket, Buffer::Instance& data,
+                                         uint64_t length)
+    : Request(RequestType::Write, socket) {
+  buf_.move(data, length);
+  Buffer::RawSliceVector slices = buf_.getRawSlices();
+  iov_ = std::make_unique<struct iovec[]>(slices.size());
+  for (size_t i = 0; i < slices.size(); i++) {
+    iov_[i].iov_base = slices[i].mem_;
+    iov_[i].iov_len = slices[i].len_;
+  }
+  msg_.msg_iov = iov_.get();
+  msg_.msg_iovlen = slices.size();
+}
+
 IoUringSocketEntry::IoUringSocketEntry(os_fd_t fd, IoUringWorkerImpl& parent, Event::FileReadyCb cb,
                                        bool enable_close_event)
     : fd_(fd), parent_(parent), enable_close_event_(enable_close_event), cb_(std::move(cb)) {}
@@ -60,14 +79,36 @@ void IoUringSocketEntry::onRemoteClose() {
 
 IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                                      uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                                     Event::Dispatcher& dispatcher)
+                                     uint32_t buffer_ring_size, uint32_t zero_copy_send_threshold,
+                                     Event::Dispatcher& dispatcher, Stats::Scope& scope)
     : IoUringWorkerImpl(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling),
-                        read_buffer_size, write_timeout_ms, dispatcher) {}
+                        read_buffer_size, write_timeout_ms, buffer_ring_size,
+                        zero_copy_send_threshold, dispatcher, scope) {}
 
 IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
-                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher)
+                                     uint32_t write_timeout_ms, uint32_t buffer_ring_size,
+                                     uint32_t zero_copy_send_threshold,
+                                     Event::Dispatcher& dispatcher, Stats::Scope& scope)
     : io_uring_(std::move(io_uring)), read_buffer_size_(read_buffer_size),
-      write_timeout_ms_(write_timeout_ms), dispatcher_(dispatcher) {
+      write_timeout_ms_(write_timeout_ms),
+      stats_({ALL_IO_URING_WORKER_STATS(POOL_COUNTER_PREFIX(scope, "io_uring."))}),
+      zero_copy_send_threshold_(zero_copy_send_threshold), dispatcher_(dispatcher) {
+  if (buffer_ring_size > 0) {
+    // The kernel limits a provided buffer ring to 32768 entries.
+    const uint32_t num_buffers = std::min<uint32_t>(std::bit_ceil(buffer_ring_size), 32768);
+    if (io_uring_->registerBufferRing(num_buffers, read_buffer_size_) == IoUringResult::Ok) {
+      use_buffer_ring_ = true;
+    } else {
+      ENVOY_LOG(warn, "provided buffer rings are not supported, fall back to per socket buffers");
+      stats_.buffer_ring_unsupported_.inc();
+    }
+  }
+  if (zero_copy_send_threshold_ > 0 && !io_uring_->isZeroCopySendSupported()) {
+    ENVOY_LOG(warn, "zero copy sends are not supported, fall back to copying sends");
+    stats_.zero_copy_send_unsupported_.inc();
+    zero_copy_send_threshold_ = 0;
+  }
+
   const os_fd_t event_fd = io_uring_->registerEventfd();
   // We only care about the read event of Eventfd, since we only receive the
   // event here.
@@ -89,7 +130,9 @@ IoUringWorkerImpl::~IoUringWorkerImpl() {
     }
   }
 
-  while (!sockets_.empty()) {
+  // Zero copy sends own their data until their notification completions, which may arrive after
+  // their sockets are gone.
+  while (!sockets_.empty() || pending_zero_copy_sends_ > 0) {
     ENVOY_LOG(trace, "still left {} sockets are not closed", sockets_.size());
     for (auto& socket : sockets_) {
       ENVOY_LOG(trace, "the socket fd = {} not closed", socket->fd());
@@ -153,6 +196,10 @@ IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
 }
 
 Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
+  if (use_buffer_ring_) {
+    return submitRecvRequest(socket);
+  }
+
   ReadRequest* req = new ReadRequest(socket, read_buffer_size_);
 
   ENVOY_LOG(trace, "submit read request, fd = {}, read req = {}", socket.fd(), fmt::ptr(req));
@@ -168,6 +215,22 @@ Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
   return req;
 }
 
+Request* IoUringWorkerImpl::submitRecvRequest(IoUringSocket& socket) {
+  RecvRequest* req = new RecvRequest(socket);
+
+  ENVOY_LOG(trace, "submit recv request, fd = {}, recv req = {}", socket.fd(), fmt::ptr(req));
+
+  auto res = io_uring_->prepareRecvMultishot(socket.fd(), req);
+  if (res == IoUringResult::Failed) {
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    submit();
+    res = io_uring_->prepareRecvMultishot(socket.fd(), req);
+    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare recv");
+  }
+  submit();
+  return req;
+}
+
 Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
                                                const Buffer::RawSliceVector& slices) {
   WriteRequest* req = new WriteRequest(socket, slices);
@@ -185,6 +248,23 @@ Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
   return req;
 }
 
+Request* IoUringWorkerImpl::submitSendZeroCopyRequest(IoUringSocket& socket, Buffer::Instance& data,
+                                                      uint64_t length) {
+  SendZeroCopyRequest* req = new SendZeroCopyRequest(socket, data, length);
+
+  ENVOY_LOG(trace, "submit zero copy send request, fd = {}, req = {}", socket.fd(), fmt::ptr(req));
+
+  auto res = io_uring_->prepareSendmsgZeroCopy(socket.fd(), &req->msg_, req);
+  if (res == IoUringResult::Failed) {
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    submit();
+    res = io_uring_->prepareSendmsgZeroCopy(socket.fd(), &req->msg_, req);
+    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare zero copy sendmsg");
+  }
+  submit();
+  return req;
+}
+
 Request* IoUringWorkerImpl::submitCloseRequest(IoUringSocket& socket) {
   Request* req = new Request(Request::RequestType::Close, socket);
 
@@ -251,7 +331,8 @@ void IoUringWorkerImpl::injectCompletion(IoUringSocket& socket, Request::Request
 void IoUringWorkerImpl::onFileEvent() {
   ENVOY_LOG(trace, "io uring worker, on file event");
   delay_submit_ = true;
-  io_uring_->forEveryCompletion([](Request* req, int32_t result, bool injected) {
+  io_uring_->forEveryCompletion([this](Request* req, int32_t result, bool injected,
+                                       uint32_t flags) {
     ENVOY_LOG(trace, "receive request completion, type = {}, req = {}",
               static_cast<uint8_t>(req->type()), fmt::ptr(req));
     ASSERT(req != nullptr);
@@ -273,9 +354,20 @@ void IoUringWorkerImpl::onFileEvent() {
       req->socket().onRead(req, result, injected);
       break;
     case Request::RequestType::Write:
+      if (flags & IORING_CQE_F_NOTIF) {
+        // The kernel is done with the data of a zero copy send, whose socket may be gone already.
+        ENVOY_LOG(trace, "receive zero copy send notification, req = {}", fmt::ptr(req));
+        pending_zero_copy_sends_--;
+        break;
+      }
       ENVOY_LOG(trace, "receive write request completion, fd = {}, req = {}", req->socket().fd(),
                 fmt::ptr(req));
       req->socket().onWrite(req, result, injected);
+      if (flags & IORING_CQE_F_MORE) {
+        // A zero copy send keeps its data until the notification completion.
+        pending_zero_copy_sends_++;
+        return;
+      }
       break;
     case Request::RequestType::Close:
       ENVOY_LOG(trace, "receive close request completion, fd = {}, req = {}", req->socket().fd(),
@@ -292,6 +384,16 @@ void IoUringWorkerImpl::onFileEvent() {
                 fmt::ptr(req));
       req->socket().onShutdown(req, result, injected);
       break;
+    case Request::RequestType::Recv:
+      ENVOY_LOG(trace, "receive recv request completion, fd = {}, req = {}, flags = {}",
+                req->socket().fd(), fmt::ptr(req), flags);
+      ASSERT(!injected);
+      onRecvCompletion(*static_cast<RecvRequest*>(req), result, flags);
+      // A multishot recv is done with its last completion only.
+      if (static_cast<RecvRequest*>(req)->more_) {
+        return;
+      }
+      break;
     }
 
     delete req;
@@ -300,6 +402,27 @@ void IoUringWorkerImpl::onFileEvent() {
   submit();
 }
 
+void IoUringWorkerImpl::onRecvCompletion(RecvRequest& req, int32_t result, uint32_t flags) {
+  req.more_ = (flags & IORING_CQE_F_MORE) != 0;
+  if (result == -ENOBUFS) {
+    // Every buffer of the ring holds data of a completion that has not been handled yet. Those
+    // completions give their buffers back as they are handled, so the socket just submits the recv
+    // again.
+    stats_.buffer_ring_exhausted_.inc();
+  }
+
+  if (!(flags & IORING_CQE_F_BUFFER)) {
+    req.socket().onRead(&req, result, false);
+    return;
+  }
+
+  const uint16_t buffer_id = flags >> IORING_CQE_BUFFER_SHIFT;
+  req.data_ = io_uring_->getProvidedBuffer(buffer_id);
+  req.socket().onRead(&req, result, false);
+  req.data_ = nullptr;
+  io_uring_->recycleProvidedBuffer(buffer_id);
+}
+
 void IoUringWorkerImpl::submit() {
   if (!delay_submit_) {
     io_uring_->submit();
@@ -338,7 +461,8 @@ void IoUringServerSocket::close(bool keep_fd_open, IoUringSocketOnClosedCb cb) {
     return;
   }
 
-  if (read_req_ != nullptr) {
+  // The read request may already be cancelled by disableRead().
+  if (read_req_ != nullptr && read_cancel_req_ == nullptr) {
     ENVOY_LOG(trace, "cancel the read request, fd = {}", fd_);
     read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
   }
@@ -372,7 +496,10 @@ void IoUringServerSocket::enableRead() {
   submitReadRequest();
 }
 
-void IoUringServerSocket::disableRead() { IoUringSocketEntry::disableRead(); }
+void IoUringServerSocket::disableRead() {
+  IoUringSocketEntry::disableRead();
+  cancelRecvIfReadDisabled();
+}
 
 void IoUringServerSocket::write(Buffer::Instance& data) {
   ENVOY_LOG(trace, "write, buffer size = {}, fd = {}", data.length(), fd_);
@@ -428,7 +555,25 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
   }
 }
 
+void IoUringServerSocket::cancelRecvIfReadDisabled() {
+  // A multishot recv keeps completing with data while reads are disabled, so it is cancelled once
+  // there is data the handler has not consumed yet. Otherwise the read buffer would grow without
+  // bound and defeat the watermarks of the upper layer. enableRead() arms the recv again.
+  if (status_ != ReadDisabled || read_req_ == nullptr || read_cancel_req_ != nullptr ||
+      read_req_->type() != Request::RequestType::Recv || read_buf_.length() == 0) {
+    return;
+  }
+  ENVOY_LOG(trace, "cancel the recv request since read is disabled, fd = {}, size = {}", fd_,
+            read_buf_.length());
+  read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
+}
+
 void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length) {
+  if (req->type() == Request::RequestType::Recv) {
+    // The provided buffer goes back to the ring once the completion is handled.
+    read_buf_.add(static_cast<RecvRequest*>(req)->data_, data_length);
+    return;
+  }
   ReadRequest* read_req = static_cast<ReadRequest*>(req);
   Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
       read_req->buf_.release(), data_length,
@@ -457,10 +602,13 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
             "onRead with result {}, fd = {}, injected = {}, status_ = {}, enable_close_event = {}",
             result, fd_, injected, status_, enable_close_event_);
   if (!injected) {
-    read_req_ = nullptr;
+    // A multishot recv stays armed until its last completion.
+    if (req->type() != Request::RequestType::Recv || !static_cast<RecvRequest*>(req)->more_) {
+      read_req_ = nullptr;
+    }
     // If the socket is going to close, discard all results.
-    if (status_ == Closed && write_or_shutdown_req_ == nullptr && read_cancel_req_ == nullptr &&
-        write_or_shutdown_cancel_req_ == nullptr) {
+    if (status_ == Closed && read_req_ == nullptr && write_or_shutdown_req_ == nullptr &&
+        read_cancel_req_ == nullptr && write_or_shutdown_cancel_req_ == nullptr) {
       if (result > 0 && keep_fd_open_) {
         moveReadDataToBuffer(req, result);
       }
@@ -473,7 +621,10 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   if (result > 0) {
     moveReadDataToBuffer(req, result);
   } else {
-    if (result != -ECANCELED) {
+    // Running out of provided buffers is not an error of the socket, the recv is submitted again
+    // below.
+    if (result != -ECANCELED &&
+        !(result == -ENOBUFS && req->type() == Request::RequestType::Recv)) {
       read_error_ = result;
     }
   }
@@ -542,9 +693,15 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
     // Since error in a disabled socket will not be handled by the handler, stop submit read
     // request if there is any error.
     if (!read_error_.has_value()) {
-      // Submit a read request for monitoring the remote close event, otherwise there is no
-      // way to know the connection is closed by the remote.
-      submitReadRequest();
+      if (read_req_ != nullptr) {
+        // The multishot recv is still armed.
+        cancelRecvIfReadDisabled();
+      } else if (req->type() != Request::RequestType::Recv || read_buf_.length() == 0) {
+        // Submit a read request for monitoring the remote close event, otherwise there is no
+        // way to know the connection is closed by the remote. A recv which was cancelled with
+        // data left in the buffer is armed again by enableRead().
+        submitReadRequest();
+      }
     }
   }
 }
@@ -578,8 +735,19 @@ void IoUringServerSocket::onWrite(Request* req, int32_t result, bool injected) {
   }
 
   if (result > 0) {
-    write_buf_.drain(result);
-    ENVOY_LOG(trace, "drain write buf, drain size = {}, fd = {}", result, fd_);
+    if (zero_copy_send_) {
+      // The data has been moved into the request, which keeps it until the kernel is done with its
+      // memory. Anything left unsent is copied back to the front of the write buffer.
+      SendZeroCopyRequest* send_req = static_cast<SendZeroCopyRequest*>(req);
+      if (static_cast<uint64_t>(result) < send_req->buf_.length()) {
+        std::string unsent(send_req->buf_.length() - result, '\0');
+        send_req->buf_.copyOut(result, unsent.size(), unsent.data());
+        write_buf_.prepend(unsent);
+      }
+    } else {
+      write_buf_.drain(result);
+      ENVOY_LOG(trace, "drain write buf, drain size = {}, fd = {}", result, fd_);
+    }
   } else {
     // Drain all write buf since the write failed.
     write_buf_.drain(write_buf_.length());
@@ -632,7 +800,18 @@ void IoUringServerSocket::submitWriteOrShutdownRequest() {
       Buffer::RawSliceVector slices = write_buf_.getRawSlices(IOV_MAX);
       ENVOY_LOG(trace, "submit write request, write_buf size = {}, num_iovecs = {}, fd = {}",
                 write_buf_.length(), slices.size(), fd_);
-      write_or_shutdown_req_ = parent_.submitWriteRequest(*this, slices);
+      const uint32_t zero_copy_send_threshold = parent_.zeroCopySendThreshold();
+      zero_copy_send_ =
+          zero_copy_send_threshold > 0 && write_buf_.length() >= zero_copy_send_threshold;
+      if (zero_copy_send_) {
+        uint64_t length = 0;
+        for (const Buffer::RawSlice& slice : slices) {
+          length += slice.len_;
+        }
+        write_or_shutdown_req_ = parent_.submitSendZeroCopyRequest(*this, write_buf_, length);
+      } else {
+        write_or_shutdown_req_ = parent_.submitWriteRequest(*this, slices);
+      }
     } else if (shutdown_.has_value() && !shutdown_.value()) {
       write_or_shutdown_req_ = parent_.submitShutdownRequest(*this, SHUT_WR);
     } else if (status_ == Closed && read_req_ == nullptr && read_cancel_req_ == nullptr &&
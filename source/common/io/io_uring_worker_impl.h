@@ -1,6 +1,8 @@
 #pragma once
 
 #include "envoy/common/io/io_uring.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/linked_object.h"
@@ -18,6 +20,18 @@ public:
   std::unique_ptr<struct iovec> iov_;
 };
 
+// A multishot recv which reads into the worker's provided buffer ring, so the socket holds no
+// buffer while it is idle. The worker points `data_` at the buffer picked by the kernel while the
+// completion is delivered to the socket, and gives the buffer back to the ring right after.
+class RecvRequest : public Request {
+public:
+  explicit RecvRequest(IoUringSocket& socket);
+
+  const uint8_t* data_{nullptr};
+  // Whether the request stays armed after the completion being delivered.
+  bool more_{false};
+};
+
 class WriteRequest : public Request {
 public:
   WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices);
@@ -25,16 +39,51 @@ public:
   std::unique_ptr<struct iovec[]> iov_;
 };
 
+// A zero copy send. It owns the data being sent, since the kernel keeps referring to its memory
+// until the notification completion which follows the completion with the result.
+class SendZeroCopyRequest : public Request {
+public:
+  SendZeroCopyRequest(IoUringSocket& socket, Buffer::Instance& data, uint64_t length);
+
+  Buffer::OwnedImpl buf_;
+  std::unique_ptr<struct iovec[]> iov_;
+  struct msghdr msg_ {};
+};
+
+/**
+ * All io_uring worker stats. @see stats_macros.h
+ */
+#define ALL_IO_URING_WORKER_STATS(COUNTER)                                                         \
+  COUNTER(buffer_ring_exhausted)                                                                   \
+  COUNTER(buffer_ring_unsupported)                                                                 \
+  COUNTER(zero_copy_send_unsupported)
+
+/**
+ * Struct definition for all io_uring worker stats. @see stats_macros.h
+ */
+struct IoUringWorkerStats {
+  ALL_IO_URING_WORKER_STATS(GENERATE_COUNTER_STRUCT)
+};
+
 class IoUringSocketEntry;
 using IoUringSocketEntryPtr = std::unique_ptr<IoUringSocketEntry>;
 
 class IoUringWorkerImpl : public IoUringWorker, private Logger::Loggable<Logger::Id::io> {
 public:
+  /**
+   * @param buffer_ring_size the number of buffers of `read_buffer_size` bytes in the provided
+   * buffer ring shared by the sockets of this worker, rounded up to a power of 2. Zero disables
+   * the ring and every socket reads into a buffer of its own.
+   * @param zero_copy_send_threshold the number of pending bytes from which a socket sends them
+   * with a zero copy send. Zero disables zero copy sends.
+   */
   IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
-                    uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    uint32_t read_buffer_size, uint32_t write_timeout_ms, uint32_t buffer_ring_size,
+                    uint32_t zero_copy_send_threshold, Event::Dispatcher& dispatcher,
+                    Stats::Scope& scope);
   IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    uint32_t buffer_ring_size, uint32_t zero_copy_send_threshold,
+                    Event::Dispatcher& dispatcher, Stats::Scope& scope);
   ~IoUringWorkerImpl() override;
 
   // IoUringWorker
@@ -49,6 +98,8 @@ public:
                                 const Network::Address::InstanceConstSharedPtr& address) override;
   Request* submitReadRequest(IoUringSocket& socket) override;
   Request* submitWriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices) override;
+  Request* submitSendZeroCopyRequest(IoUringSocket& socket, Buffer::Instance& data,
+                                     uint64_t length) override;
   Request* submitCloseRequest(IoUringSocket& socket) override;
   Request* submitCancelRequest(IoUringSocket& socket, Request* request_to_cancel) override;
   Request* submitShutdownRequest(IoUringSocket& socket, int how) override;
@@ -64,16 +115,29 @@ public:
   // Return the number of sockets in this worker.
   uint32_t getNumOfSockets() const override { return sockets_.size(); }
 
+  // Return the number of pending bytes from which sockets send them with a zero copy send, or zero
+  // if zero copy sends are disabled.
+  uint32_t zeroCopySendThreshold() const { return zero_copy_send_threshold_; }
+
 protected:
   // Add a socket to the worker.
   IoUringSocketEntry& addSocket(IoUringSocketEntryPtr&& socket);
   void onFileEvent();
+  void onRecvCompletion(RecvRequest& req, int32_t result, uint32_t flags);
+  Request* submitRecvRequest(IoUringSocket& socket);
   void submit();
 
   // The iouring instance.
   IoUringPtr io_uring_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  IoUringWorkerStats stats_;
+  // Whether read requests are multishot recvs into the provided buffer ring.
+  bool use_buffer_ring_{false};
+  uint32_t zero_copy_send_threshold_;
+  // The zero copy sends waiting for their notification completion. The sockets may be gone by
+  // then, so the worker keeps track of them.
+  uint32_t pending_zero_copy_sends_{0};
   // The dispatcher of this worker is running on.
   Event::Dispatcher& dispatcher_;
   // The file event of iouring's eventfd.
@@ -233,6 +297,9 @@ protected:
   // we can make sure all SQEs bounding to the iouring socket is completed and the socket can be
   // closed successfully.
   Request* write_or_shutdown_req_{nullptr};
+  // Whether write_or_shutdown_req_ is a zero copy send, which owns the data being sent rather than
+  // leaving it in write_buf_.
+  bool zero_copy_send_{false};
   Event::TimerPtr write_timeout_timer_{nullptr};
   // Whether keep the fd open when close the IoUringSocket.
   bool keep_fd_open_{false};
@@ -246,6 +313,7 @@ protected:
   void closeInternal();
   void submitReadRequest();
   void submitWriteOrShutdownRequest();
+  void cancelRecvIfReadDisabled();
   void moveReadDataToBuffer(Request* req, size_t data_length);
   void onReadCompleted(int32_t result);
   void onWriteCompleted(int32_t result);
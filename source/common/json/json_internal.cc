@@ -790,6 +790,19 @@ std::string Factory::serialize(absl::string_view str) {
   return j.dump();
 }
 
+std::string Factory::serializeProtobufValue(const ProtobufWkt::Value& protobuf_value) {
+  // Strings and numbers, the common cases, are serialized without building a Field.
+  switch (protobuf_value.kind_case()) {
+  case ProtobufWkt::Value::kStringValue:
+    return nlohmann::json(protobuf_value.string_value())
+        .dump(-1, ' ', false, nlohmann::detail::error_handler_t::replace);
+  case ProtobufWkt::Value::kNumberValue:
+    return nlohmann::json(protobuf_value.number_value()).dump();
+  default:
+    return loadFromProtobufValueInternal(protobuf_value)->asJsonString();
+  }
+}
+
 std::vector<uint8_t> Factory::jsonToMsgpack(const std::string& json_string) {
   return nlohmann::json::to_msgpack(nlohmann::json::parse(json_string, nullptr, false));
 }
@@ -39,6 +39,12 @@ public:
    */
   static std::string serialize(absl::string_view str);
 
+  /**
+   * Serializes a Protobuf value exactly as asJsonString() serializes it as a field of an object
+   * loaded with loadFromProtobufStruct(). Invalid UTF-8 is replaced rather than throwing.
+   */
+  static std::string serializeProtobufValue(const ProtobufWkt::Value& protobuf_value);
+
   /*
    * Serializes a JSON string to a byte vector using the MessagePack serialization format.
    * If the provided JSON string is invalid, an empty vector will be returned.
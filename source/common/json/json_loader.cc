@@ -18,6 +18,10 @@ ObjectSharedPtr Factory::loadFromProtobufStruct(const ProtobufWkt::Struct& proto
   return Nlohmann::Factory::loadFromProtobufStruct(protobuf_struct);
 }
 
+std::string Factory::serializeProtobufValue(const ProtobufWkt::Value& protobuf_value) {
+  return Nlohmann::Factory::serializeProtobufValue(protobuf_value);
+}
+
 std::vector<uint8_t> Factory::jsonToMsgpack(const std::string& json) {
   return Nlohmann::Factory::jsonToMsgpack(json);
 }
@@ -28,6 +28,12 @@ public:
    */
   static ObjectSharedPtr loadFromProtobufStruct(const ProtobufWkt::Struct& protobuf_struct);
 
+  /**
+   * Serializes a Protobuf value exactly as asJsonString() serializes it as a field of an object
+   * loaded with loadFromProtobufStruct(). Invalid UTF-8 is replaced rather than throwing.
+   */
+  static std::string serializeProtobufValue(const ProtobufWkt::Value& protobuf_value);
+
   /*
    * Serializes a JSON string to a byte vector using the MessagePack serialization format.
    * If the provided JSON string is invalid, an empty vector will be returned.
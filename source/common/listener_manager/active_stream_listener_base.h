@@ -34,6 +34,7 @@ public:
   static void emitLogs(Network::ListenerConfig& config, StreamInfo::StreamInfo& stream_info);
 
   Event::Dispatcher& dispatcher() { return dispatcher_; }
+  const Event::Dispatcher& dispatcher() const { return dispatcher_; }
 
   /**
    * Schedule to remove and destroy the active connections which are not tracked by listener
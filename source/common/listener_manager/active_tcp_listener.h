@@ -72,6 +72,7 @@ public:
     ++num_listener_connections_;
     config_->openConnections().inc();
   }
+  std::chrono::microseconds loopLatency() const override { return dispatcher().loopLatency(); }
   void post(Network::ConnectionSocketPtr&& socket) override;
   void onAcceptWorker(Network::ConnectionSocketPtr&& socket,
                       bool hand_off_restored_destination_connections, bool rebalanced) override;
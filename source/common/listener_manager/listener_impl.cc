@@ -636,6 +636,17 @@ void ListenerImpl::buildListenSocketOptions(
       addListenSocketOptions(listen_socket_options_list_[i],
                              Network::SocketOptionFactory::buildReusePortOptions());
     }
+    if (config.reuse_port_cpu_steering() && socket_type_ == Network::Socket::Type::Stream) {
+      const uint32_t concurrency = parent_.server_.options().concurrency();
+      if (!reuse_port_) {
+        ENVOY_LOG(warn, "Not steering connections by CPU on listener '{}' without reuse_port",
+                  name_);
+      } else if (concurrency > 1) {
+        addListenSocketOptions(
+            listen_socket_options_list_[i],
+            Network::SocketOptionFactory::buildReusePortCpuSteeringOptions(concurrency));
+      }
+    }
     if (!config.socket_options().empty()) {
       addListenSocketOptions(
           listen_socket_options_list_[i],
@@ -753,6 +764,11 @@ void ListenerImpl::buildConnectionBalancer(const envoy::config::listener::v3::Li
         connection_balancers_.emplace(address.asString(),
                                       std::make_shared<Network::ExactConnectionBalancerImpl>());
         break;
+      case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kLoadAwareBalance:
+        connection_balancers_.emplace(address.asString(),
+                                      std::make_shared<Network::LoadAwareConnectionBalancerImpl>(
+                                          parent_.server_.options().concurrency()));
+        break;
       case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kExtendBalance: {
         const std::string connection_balance_library_type{TypeUtil::typeUrlToDescriptorFullName(
             config.connection_balance_config().extend_balance().typed_config().type_url())};
@@ -1122,7 +1138,8 @@ bool ListenerMessageUtil::socketOptionsEqual(const envoy::config::listener::v3::
       (PROTOBUF_GET_WRAPPED_OR_DEFAULT(lhs, freebind, false) !=
        PROTOBUF_GET_WRAPPED_OR_DEFAULT(rhs, freebind, false)) ||
       (PROTOBUF_GET_WRAPPED_OR_DEFAULT(lhs, tcp_fast_open_queue_length, 0) !=
-       PROTOBUF_GET_WRAPPED_OR_DEFAULT(rhs, tcp_fast_open_queue_length, 0))) {
+       PROTOBUF_GET_WRAPPED_OR_DEFAULT(rhs, tcp_fast_open_queue_length, 0)) ||
+      lhs.reuse_port_cpu_steering() != rhs.reuse_port_cpu_steering()) {
     return false;
   }
 
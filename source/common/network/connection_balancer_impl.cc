@@ -1,5 +1,9 @@
 #include "source/common/network/connection_balancer_impl.h"
 
+#include <thread>
+
+#include "source/common/common/assert.h"
+
 namespace Envoy {
 namespace Network {
 
@@ -34,5 +38,70 @@ ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&) {
   return *min_connection_handler;
 }
 
+LoadAwareConnectionBalancerImpl::LoadAwareConnectionBalancerImpl(uint32_t max_handlers)
+    : num_slots_(max_handlers), slots_(std::make_unique<HandlerSlot[]>(max_handlers)) {}
+
+void LoadAwareConnectionBalancerImpl::registerHandler(BalancedConnectionHandler& handler) {
+  for (uint32_t i = 0; i < num_slots_; i++) {
+    BalancedConnectionHandler* expected = nullptr;
+    if (slots_[i].handler_.compare_exchange_strong(expected, &handler)) {
+      return;
+    }
+  }
+  IS_ENVOY_BUG("more connection handlers registered than the load aware balancer has slots for");
+}
+
+void LoadAwareConnectionBalancerImpl::unregisterHandler(BalancedConnectionHandler& handler) {
+  for (uint32_t i = 0; i < num_slots_; i++) {
+    HandlerSlot& slot = slots_[i];
+    if (slot.handler_.load() != &handler) {
+      continue;
+    }
+    // Pickers mark the slot before reading the handler, so once the handler is cleared and the
+    // slot is unmarked no picker can be using it. Picks are short and this is a rare operation.
+    slot.handler_.store(nullptr);
+    while (slot.readers_.load() != 0) {
+      std::this_thread::yield();
+    }
+    return;
+  }
+}
+
+BalancedConnectionHandler&
+LoadAwareConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler& current_handler) {
+  // The current handler runs this, so it needs no marking.
+  BalancedConnectionHandler* target = &current_handler;
+  HandlerSlot* target_slot = nullptr;
+  uint64_t target_load = load(current_handler);
+  for (uint32_t i = 0; i < num_slots_; i++) {
+    HandlerSlot& slot = slots_[i];
+    slot.readers_.fetch_add(1);
+    BalancedConnectionHandler* handler = slot.handler_.load();
+    if (handler != nullptr && handler != &current_handler) {
+      const uint64_t handler_load = load(*handler);
+      if (handler_load < target_load) {
+        if (target_slot != nullptr) {
+          target_slot->readers_.fetch_sub(1);
+        }
+        target = handler;
+        target_slot = &slot;
+        target_load = handler_load;
+        continue;
+      }
+    }
+    slot.readers_.fetch_sub(1);
+  }
+
+  target->incNumConnections();
+  if (target_slot != nullptr) {
+    target_slot->readers_.fetch_sub(1);
+  }
+  return *target;
+}
+
+uint64_t LoadAwareConnectionBalancerImpl::load(const BalancedConnectionHandler& handler) {
+  return (handler.numConnections() + 1) * (handler.loopLatency() + BaselineLoopLatency).count();
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+
 #include "envoy/config/listener/v3/listener.pb.h"
 #include "envoy/network/connection_balancer.h"
 #include "envoy/registry/registry.h"
@@ -44,6 +48,48 @@ private:
   std::vector<BalancedConnectionHandler*> handlers_ ABSL_GUARDED_BY(lock_);
 };
 
+/**
+ * Implementation of connection balancer that places a connection on the least loaded handler, where
+ * load is the handler's connection count scaled by the event loop latency of its worker. Long lived
+ * connections with uneven request rates leave some workers busier than their connection counts
+ * suggest, which shows in their loop latency. Without loop latency, e.g. when dispatcher stats are
+ * disabled, this balances by connection count. The current handler is kept unless another one is
+ * strictly less loaded, to avoid needless cross-thread hand offs.
+ *
+ * No lock is taken. Handlers are kept in a fixed number of slots and a picker marks each slot while
+ * it reads the handler in it, so that unregisterHandler() can wait until the handler is unused.
+ */
+class LoadAwareConnectionBalancerImpl : public ConnectionBalancer {
+public:
+  /**
+   * @param max_handlers supplies the number of handlers that can be registered at once, which is
+   *        the number of workers. Handlers registered beyond that are not picked as a target.
+   */
+  explicit LoadAwareConnectionBalancerImpl(uint32_t max_handlers);
+
+  // ConnectionBalancer
+  void registerHandler(BalancedConnectionHandler& handler) override;
+  void unregisterHandler(BalancedConnectionHandler& handler) override;
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler) override;
+
+  // Loop latency added to every handler's, so that handlers on idle workers, or with no loop
+  // latency tracked, compare by connection count.
+  static constexpr std::chrono::microseconds BaselineLoopLatency{100};
+
+private:
+  // Each slot is written by a different worker, so keep them on separate cache lines.
+  struct alignas(64) HandlerSlot {
+    std::atomic<BalancedConnectionHandler*> handler_{nullptr};
+    // The number of pickTargetHandler() calls reading the handler.
+    std::atomic<uint32_t> readers_{0};
+  };
+
+  static uint64_t load(const BalancedConnectionHandler& handler);
+
+  const uint32_t num_slots_;
+  const std::unique_ptr<HandlerSlot[]> slots_;
+};
+
 /**
  * A NOP connection balancer implementation that always continues execution after incrementing
  * the handler's connection count.
@@ -764,6 +764,10 @@ void ConnectionImpl::onWriteReady() {
   ASSERT(!result.end_stream_read_); // The interface guarantees that only read operations set this.
   uint64_t new_buffer_size = write_buffer_->length();
   updateWriteBufferStats(result.bytes_processed_, new_buffer_size);
+  if (connection_stats_ != nullptr && connection_stats_->write_calls_ != nullptr &&
+      result.write_calls_ > 0) {
+    connection_stats_->write_calls_->add(result.write_calls_);
+  }
 
   // The socket is closed immediately when receiving RST.
   if (result.err_code_.has_value() &&
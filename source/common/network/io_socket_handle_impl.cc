@@ -1,5 +1,7 @@
 #include "source/common/network/io_socket_handle_impl.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include "envoy/buffer/buffer.h"
@@ -136,6 +138,9 @@ Api::IoCallUint64Result IoSocketHandleImpl::writev(const Buffer::RawSlice* slice
 
 Api::IoCallUint64Result IoSocketHandleImpl::write(Buffer::Instance& buffer) {
   constexpr uint64_t MaxSlices = 16;
+  if (coalesce_small_writes_) {
+    return writeCoalesced(buffer, MaxSlices);
+  }
   Buffer::RawSliceVector slices = buffer.getRawSlices(MaxSlices);
   Api::IoCallUint64Result result = writev(slices.begin(), slices.size());
   if (result.ok() && result.return_value_ > 0) {
@@ -144,6 +149,62 @@ Api::IoCallUint64Result IoSocketHandleImpl::write(Buffer::Instance& buffer) {
   return result;
 }
 
+Api::IoCallUint64Result IoSocketHandleImpl::writeCoalesced(Buffer::Instance& buffer,
+                                                           uint64_t max_iovecs) {
+  // Slices up to this size are copied together with the small slices next to them, so that one
+  // writev() covers many of them. Larger slices are written from where they are.
+  constexpr uint64_t MaxCoalescedSliceSize = 1024;
+  // The slab only has to hold the copies for the duration of the writev(), so it is kept on the
+  // stack rather than with the connection.
+  constexpr uint64_t SlabSize = 16384;
+  constexpr uint64_t MaxSlices = 128;
+
+  Buffer::RawSliceVector slices = buffer.getRawSlices(MaxSlices);
+  absl::FixedArray<Buffer::RawSlice> iovecs(std::min<uint64_t>(max_iovecs, slices.size()));
+  uint8_t slab[SlabSize];
+  uint64_t slab_used = 0;
+  uint64_t num_iovecs = 0;
+  // Whether the last iovec holds a small slice, which may be extended with the next one, and
+  // whether it has been copied into the slab already.
+  bool last_small = false;
+  bool last_in_slab = false;
+  for (const Buffer::RawSlice& slice : slices) {
+    if (slice.len_ == 0) {
+      continue;
+    }
+    const bool small = slice.len_ <= MaxCoalescedSliceSize;
+    if (small && last_small) {
+      Buffer::RawSlice& run = iovecs[num_iovecs - 1];
+      const uint64_t needed = slice.len_ + (last_in_slab ? 0 : run.len_);
+      if (slab_used + needed <= SlabSize) {
+        if (!last_in_slab) {
+          // A second small slice follows the first, so start a run in the slab.
+          memcpy(slab + slab_used, run.mem_, run.len_);
+          run.mem_ = slab + slab_used;
+          slab_used += run.len_;
+          last_in_slab = true;
+        }
+        memcpy(slab + slab_used, slice.mem_, slice.len_);
+        slab_used += slice.len_;
+        run.len_ += slice.len_;
+        continue;
+      }
+    }
+    if (num_iovecs == iovecs.size()) {
+      break;
+    }
+    iovecs[num_iovecs++] = slice;
+    last_small = small;
+    last_in_slab = false;
+  }
+
+  Api::IoCallUint64Result result = writev(iovecs.begin(), num_iovecs);
+  if (result.ok() && result.return_value_ > 0) {
+    buffer.drain(static_cast<uint64_t>(result.return_value_));
+  }
+  return result;
+}
+
 Api::IoCallUint64Result IoSocketHandleImpl::sendmsg(const Buffer::RawSlice* slices,
                                                     uint64_t num_slice, int flags,
                                                     const Address::Ip* self_ip,
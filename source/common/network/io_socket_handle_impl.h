@@ -34,7 +34,9 @@ public:
       : IoSocketHandleBaseImpl(fd, socket_v6only, domain),
         udp_read_normalize_addresses_(
             Runtime::runtimeFeatureEnabled("envoy.restart_features.udp_read_normalize_addresses")),
-        receive_ecn_(Runtime::runtimeFeatureEnabled("envoy.reloadable_features.quic_receive_ecn")) {
+        receive_ecn_(Runtime::runtimeFeatureEnabled("envoy.reloadable_features.quic_receive_ecn")),
+        coalesce_small_writes_(Runtime::runtimeFeatureEnabled(
+            "envoy.reloadable_features.coalesce_small_write_slices")) {
     if (address_cache_max_capacity > 0) {
       recent_received_addresses_ =
           std::make_unique<AddressInstanceLRUCache>(address_cache_max_capacity);
@@ -113,6 +115,10 @@ protected:
   // Latches a copy of the runtime feature "envoy.reloadable_features.quic_receive_ecn".
   const bool receive_ecn_;
 
+  // Latches a copy of the runtime feature
+  // "envoy.reloadable_features.coalesce_small_write_slices".
+  const bool coalesce_small_writes_;
+
   size_t addressCacheMaxSize() const {
     return recent_received_addresses_ == nullptr ? 0 : recent_received_addresses_->MaxSize();
   }
@@ -126,6 +132,10 @@ private:
   Address::InstanceConstSharedPtr getOrCreateEnvoyAddressInstance(sockaddr_storage ss,
                                                                   socklen_t ss_len);
 
+  // Writes the start of the buffer with up to max_iovecs iovecs, copying runs of small slices
+  // together so that each iovec covers several of them.
+  Api::IoCallUint64Result writeCoalesced(Buffer::Instance& buffer, uint64_t max_iovecs);
+
   // Caches the address instances of the most recently received packets on this socket.
   // Should only be used by UDP sockets to avoid creating multiple address instances for the same
   // address in each read operation. Only be instantiated if the non-zero address_cache_max_capacity
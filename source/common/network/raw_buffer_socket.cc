@@ -51,6 +51,7 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
 IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
   PostIoAction action;
   uint64_t bytes_written = 0;
+  uint64_t write_calls = 0;
   absl::optional<Api::IoError::IoErrorCode> err = absl::nullopt;
   ASSERT(!shutdown_ || buffer.length() == 0);
   do {
@@ -65,6 +66,7 @@ IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
       break;
     }
     Api::IoCallUint64Result result = callbacks_->ioHandle().write(buffer);
+    write_calls++;
 
     if (result.ok()) {
       ENVOY_CONN_LOG(trace, "write returns: {}", callbacks_->connection(), result.return_value_);
@@ -82,7 +84,9 @@ IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
     }
   } while (true);
 
-  return {action, bytes_written, false, err};
+  IoResult result{action, bytes_written, false, err};
+  result.write_calls_ = write_calls;
+  return result;
 }
 
 std::string RawBufferSocket::protocol() const { return EMPTY_STRING; }
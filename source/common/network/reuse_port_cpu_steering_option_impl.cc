@@ -0,0 +1,85 @@
+#include "source/common/network/reuse_port_cpu_steering_option_impl.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/scalar_to_byte_vector.h"
+#include "source/common/common/utility.h"
+#include "source/common/network/socket_option_impl.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Network {
+
+ReusePortCpuSteeringOptionImpl::ReusePortCpuSteeringOptionImpl(uint32_t socket_count)
+    : socket_count_(socket_count) {
+  ASSERT(socket_count_ > 0);
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  // The program returns an index into the sockets of the group, which are in the order the
+  // workers bound them. The kernel falls back to its flow hash when the index is beyond them, as
+  // it may be while the sockets of a listener are being replaced.
+  // SPELLCHECKER(off)
+  filter_ = {
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)}, // ld cpu
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, socket_count_}, // mod #socket_count
+      {BPF_RET | BPF_A, 0, 0, 0},                       // ret a
+  };
+  // SPELLCHECKER(on)
+#endif
+}
+
+bool ReusePortCpuSteeringOptionImpl::setOption(
+    Socket& socket, envoy::config::core::v3::SocketOption::SocketState state) const {
+  if (state != in_state_) {
+    return true;
+  }
+  if (socket.socketType() != Socket::Type::Stream) {
+    ENVOY_LOG(info, "Skipping inapplicable socket option SO_ATTACH_REUSEPORT_CBPF");
+    return true;
+  }
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  sock_fprog prog;
+  prog.len = filter_.size();
+  prog.filter = const_cast<sock_filter*>(filter_.data());
+  const Api::SysCallIntResult result = SocketOptionImpl::setSocketOption(
+      socket, ENVOY_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog));
+  if (result.return_value_ != 0) {
+    ENVOY_LOG(warn, "Setting SO_ATTACH_REUSEPORT_CBPF option on socket failed: {}",
+              errorDetails(result.errno_));
+    return false;
+  }
+  return true;
+#else
+  ENVOY_LOG(warn, "Failed to set unsupported option on socket");
+  return false;
+#endif
+}
+
+void ReusePortCpuSteeringOptionImpl::hashKey(std::vector<uint8_t>& hash_key) const {
+  if (isSupported()) {
+    pushScalarToByteVector(ENVOY_ATTACH_REUSEPORT_CBPF.level(), hash_key);
+    pushScalarToByteVector(ENVOY_ATTACH_REUSEPORT_CBPF.option(), hash_key);
+    pushScalarToByteVector(socket_count_, hash_key);
+  }
+}
+
+absl::optional<Socket::Option::Details> ReusePortCpuSteeringOptionImpl::getOptionDetails(
+    const Socket&, envoy::config::core::v3::SocketOption::SocketState state) const {
+  if (state != in_state_ || !isSupported()) {
+    return absl::nullopt;
+  }
+  Socket::Option::Details info;
+  info.name_ = ENVOY_ATTACH_REUSEPORT_CBPF;
+  info.value_ = absl::StrCat("cpu % ", socket_count_);
+  return absl::make_optional(std::move(info));
+}
+
+bool ReusePortCpuSteeringOptionImpl::isSupported() const {
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+#include "envoy/common/platform.h"
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/network/listen_socket.h"
+
+#include "source/common/common/logger.h"
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * Attaches a classic BPF program to the SO_REUSEPORT group of a bound TCP listen socket, which
+ * selects the socket of the group by the CPU the connection arrived on, modulo the number of
+ * sockets. Each worker then accepts the connections whose packets are received on one CPU, rather
+ * than those selected by the kernel's flow hash. This mirrors the steering of QUIC packets to the
+ * worker owning their connection ID.
+ *
+ * Classic BPF needs no privileges. The program applies to the whole group, so it is enough for it
+ * to be attached to any one socket, and attaching it to each of them replaces it with an identical
+ * one.
+ */
+class ReusePortCpuSteeringOptionImpl : public Socket::Option,
+                                       Logger::Loggable<Logger::Id::connection> {
+public:
+  explicit ReusePortCpuSteeringOptionImpl(uint32_t socket_count);
+
+  // Socket::Option
+  bool setOption(Socket& socket,
+                 envoy::config::core::v3::SocketOption::SocketState state) const override;
+  void hashKey(std::vector<uint8_t>& hash_key) const override;
+  absl::optional<Details>
+  getOptionDetails(const Socket& socket,
+                   envoy::config::core::v3::SocketOption::SocketState state) const override;
+  bool isSupported() const override;
+
+private:
+  static constexpr envoy::config::core::v3::SocketOption::SocketState in_state_ =
+      envoy::config::core::v3::SocketOption::STATE_BOUND;
+  const uint32_t socket_count_;
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  // The program, which has to outlive the sock_fprog referring to it.
+  std::vector<sock_filter> filter_;
+#endif
+};
+
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,204 @@
+#include "source/common/network/udp_batch_writer.h"
+
+#include <cstring>
+
+#include "envoy/api/os_sys_calls.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/network/io_socket_error_impl.h"
+
+namespace Envoy {
+namespace Network {
+
+UdpBatchWriter::UdpBatchWriter(IoHandle& io_handle)
+    : UdpBatchWriter(io_handle, Api::OsSysCallsSingleton::get().supportsUdpGso(),
+                     Api::OsSysCallsSingleton::get().supportsMmsg()) {}
+
+UdpBatchWriter::UdpBatchWriter(IoHandle& io_handle, bool gso_enabled, bool mmsg_enabled)
+    : io_handle_(io_handle), gso_enabled_(gso_enabled), mmsg_enabled_(mmsg_enabled) {}
+
+Api::IoCallUint64Result UdpBatchWriter::writePacket(const Buffer::Instance& buffer,
+                                                    const Address::Ip* local_ip,
+                                                    const Address::Instance& peer_address) {
+  const auto* address_base = dynamic_cast<const Address::InstanceBase*>(&peer_address);
+  if (address_base == nullptr || address_base->sockAddr() == nullptr) {
+    return IoSocketError::ioResultSocketInvalidAddress();
+  }
+
+  BufferedPacket& packet = packets_.emplace_back();
+  packet.offset_ = buffer_.size();
+  packet.length_ = buffer.length();
+  memcpy(&packet.peer_address_, address_base->sockAddr(), address_base->sockAddrLen());
+  packet.peer_address_length_ = address_base->sockAddrLen();
+  packet.has_local_ip_ = local_ip != nullptr;
+  if (local_ip != nullptr) {
+    packet.local_ip_version_ = local_ip->version();
+    packet.local_ip_address_ = local_ip->version() == Address::IpVersion::v4
+                                   ? local_ip->ipv4()->address()
+                                   : local_ip->ipv6()->address();
+  }
+  buffer_.resize(buffer_.size() + packet.length_);
+  buffer.copyOut(0, packet.length_, buffer_.data() + packet.offset_);
+  return {packet.length_, Api::IoError::none()};
+}
+
+Api::IoCallUint64Result UdpBatchWriter::flush() {
+  write_blocked_ = false;
+  last_flush_packets_sent_ = 0;
+  Api::IoCallUint64Result result{0, Api::IoError::none()};
+  uint64_t bytes_sent = 0;
+  size_t next_packet = 0;
+  while (next_packet < packets_.size() && result.ok()) {
+    size_t num_messages = 0;
+    while (next_packet < packets_.size() && num_messages < MaxMessagesPerSend) {
+      // A GSO message carries segments of the size of its first one, except that the last one may
+      // be shorter.
+      const BufferedPacket& first = packets_[next_packet];
+      size_t last = next_packet + 1;
+      uint64_t gso_bytes = first.length_;
+      if (gso_enabled_ && first.length_ > 0 && first.length_ <= UdpMaxOutgoingPacketSize) {
+        while (last < packets_.size() && last - next_packet < MaxGsoSegments &&
+               packets_[last].length_ > 0 && packets_[last].length_ <= first.length_ &&
+               gso_bytes + packets_[last].length_ <= MaxGsoMessageSize &&
+               sameSourceAndDestination(first, packets_[last])) {
+          gso_bytes += packets_[last].length_;
+          if (packets_[last++].length_ < first.length_) {
+            break;
+          }
+        }
+      }
+      prepareMessage(num_messages++, next_packet, last);
+      next_packet = last;
+    }
+    const uint64_t messages_sent = sendMessages(num_messages, result);
+    for (size_t i = 0; i < messages_sent; i++) {
+      last_flush_packets_sent_ += message_packets_[i];
+      bytes_sent += iovecs_[i].iov_len;
+    }
+  }
+
+  buffer_.clear();
+  packets_.clear();
+  if (!result.ok()) {
+    if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+      write_blocked_ = true;
+    }
+    return result;
+  }
+  return {bytes_sent, Api::IoError::none()};
+}
+
+bool UdpBatchWriter::sameSourceAndDestination(const BufferedPacket& a, const BufferedPacket& b) {
+  if (a.has_local_ip_ != b.has_local_ip_ ||
+      (a.has_local_ip_ && (a.local_ip_version_ != b.local_ip_version_ ||
+                           a.local_ip_address_ != b.local_ip_address_))) {
+    return false;
+  }
+  return a.peer_address_length_ == b.peer_address_length_ &&
+         memcmp(&a.peer_address_, &b.peer_address_, a.peer_address_length_) == 0;
+}
+
+void UdpBatchWriter::prepareMessage(size_t message_index, size_t first, size_t last) {
+  const BufferedPacket& packet = packets_[first];
+  const uint64_t length = packets_[last - 1].offset_ + packets_[last - 1].length_ - packet.offset_;
+  iovec& iov = iovecs_[message_index];
+  iov.iov_base = buffer_.data() + packet.offset_;
+  iov.iov_len = length;
+  message_packets_[message_index] = last - first;
+
+  msghdr& message = messages_[message_index].msg_hdr;
+  message.msg_name = const_cast<sockaddr_storage*>(&packet.peer_address_);
+  message.msg_namelen = packet.peer_address_length_;
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_flags = 0;
+  message.msg_control = nullptr;
+  message.msg_controllen = 0;
+  messages_[message_index].msg_len = 0;
+  const bool gso = last - first > 1;
+  if (!packet.has_local_ip_ && !gso) {
+    return;
+  }
+
+  ControlBuffer& control = control_buffers_[message_index];
+  memset(control.data_, 0, sizeof(control.data_));
+  message.msg_control = control.data_;
+  message.msg_controllen = sizeof(control.data_);
+  size_t control_length = 0;
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  if (packet.has_local_ip_) {
+    if (packet.local_ip_version_ == Address::IpVersion::v4) {
+      cmsg->cmsg_level = IPPROTO_IP;
+#ifndef IP_SENDSRCADDR
+      cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+      cmsg->cmsg_type = IP_PKTINFO;
+      auto pktinfo = reinterpret_cast<in_pktinfo*>(CMSG_DATA(cmsg));
+      pktinfo->ipi_ifindex = 0;
+#ifdef WIN32
+      pktinfo->ipi_addr.s_addr = static_cast<uint32_t>(packet.local_ip_address_);
+#else
+      pktinfo->ipi_spec_dst.s_addr = static_cast<uint32_t>(packet.local_ip_address_);
+#endif
+      control_length += CMSG_SPACE(sizeof(in_pktinfo));
+#else
+      cmsg->cmsg_type = IP_SENDSRCADDR;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(in_addr));
+      reinterpret_cast<in_addr*>(CMSG_DATA(cmsg))->s_addr =
+          static_cast<uint32_t>(packet.local_ip_address_);
+      control_length += CMSG_SPACE(sizeof(in_addr));
+#endif
+    } else {
+      cmsg->cmsg_len = CMSG_LEN(sizeof(in6_pktinfo));
+      cmsg->cmsg_level = IPPROTO_IPV6;
+      cmsg->cmsg_type = IPV6_PKTINFO;
+      auto pktinfo = reinterpret_cast<in6_pktinfo*>(CMSG_DATA(cmsg));
+      pktinfo->ipi6_ifindex = 0;
+      memcpy(pktinfo->ipi6_addr.s6_addr, &packet.local_ip_address_,
+             sizeof(pktinfo->ipi6_addr.s6_addr));
+      control_length += CMSG_SPACE(sizeof(in6_pktinfo));
+    }
+    cmsg = CMSG_NXTHDR(&message, cmsg);
+  }
+#if UDP_GSO_BATCH_WRITER_COMPILETIME_SUPPORT
+  if (gso) {
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    const uint16_t segment_size = packet.length_;
+    memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+    control_length += CMSG_SPACE(sizeof(uint16_t));
+  }
+#endif
+  message.msg_controllen = control_length;
+}
+
+uint64_t UdpBatchWriter::sendMessages(size_t num_messages, Api::IoCallUint64Result& result) {
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  const os_fd_t fd = io_handle_.fdDoNotUse();
+  size_t sent = 0;
+  while (sent < num_messages) {
+    if (mmsg_enabled_ && num_messages - sent > 1) {
+      const Api::SysCallIntResult rc =
+          os_sys_calls.sendmmsg(fd, &messages_[sent], num_messages - sent, 0);
+      if (rc.return_value_ <= 0) {
+        result = {0, rc.errno_ == SOCKET_ERROR_AGAIN ? IoSocketError::getIoSocketEagainError()
+                                                     : IoSocketError::create(rc.errno_)};
+        break;
+      }
+      sent += rc.return_value_;
+    } else {
+      const Api::SysCallSizeResult rc = os_sys_calls.sendmsg(fd, &messages_[sent].msg_hdr, 0);
+      if (rc.return_value_ < 0) {
+        result = {0, rc.errno_ == SOCKET_ERROR_AGAIN ? IoSocketError::getIoSocketEagainError()
+                                                     : IoSocketError::create(rc.errno_)};
+        break;
+      }
+      sent++;
+    }
+  }
+  return sent;
+}
+
+} // namespace Network
+} // namespace Envoy
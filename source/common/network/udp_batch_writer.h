@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "envoy/common/platform.h"
+#include "envoy/network/address.h"
+#include "envoy/network/io_handle.h"
+#include "envoy/network/udp_packet_writer_handler.h"
+
+#include "absl/numeric/int128.h"
+
+#if !defined(UDP_GSO_BATCH_WRITER_COMPILETIME_SUPPORT)
+#if !defined(__linux__) || defined(__ANDROID_API__)
+#define UDP_GSO_BATCH_WRITER_COMPILETIME_SUPPORT 0
+#else
+#define UDP_GSO_BATCH_WRITER_COMPILETIME_SUPPORT 1
+#endif
+#endif
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * A batch mode UdpPacketWriter which does not depend on QUICHE. Packets are copied into a
+ * contiguous buffer by writePacket() and sent by flush(). Runs of packets with the same source and
+ * destination are sent as a single GSO message where the kernel supports UDP GSO, and the messages
+ * of a flush are handed to the kernel with sendmmsg() where it is supported, falling back to one
+ * sendmsg() per message otherwise.
+ */
+class UdpBatchWriter : public UdpPacketWriter {
+public:
+  explicit UdpBatchWriter(IoHandle& io_handle);
+  UdpBatchWriter(IoHandle& io_handle, bool gso_enabled, bool mmsg_enabled);
+
+  // UdpPacketWriter
+  Api::IoCallUint64Result writePacket(const Buffer::Instance& buffer, const Address::Ip* local_ip,
+                                      const Address::Instance& peer_address) override;
+  bool isWriteBlocked() const override { return write_blocked_; }
+  void setWritable() override { write_blocked_ = false; }
+  uint64_t getMaxPacketSize(const Address::Instance& /*peer_address*/) const override {
+    return UdpMaxOutgoingPacketSize;
+  }
+  bool isBatchMode() const override { return true; }
+  UdpPacketWriterBuffer getNextWriteLocation(const Address::Ip* /*local_ip*/,
+                                             const Address::Instance& /*peer_address*/) override {
+    return {nullptr, 0, nullptr};
+  }
+  // Sends the buffered packets in order. Sending stops at the first failed system call and the
+  // packets which were not sent are dropped. On success the result holds the number of bytes sent.
+  Api::IoCallUint64Result flush() override;
+
+  /**
+   * @return the number of packets sent by the last flush(). As packets are sent in order, these
+   * are the first packets written since the flush before it.
+   */
+  uint64_t lastFlushPacketsSent() const { return last_flush_packets_sent_; }
+
+  /**
+   * @return the number of packets written and not yet flushed.
+   */
+  uint64_t bufferedPackets() const { return packets_.size(); }
+
+private:
+  struct BufferedPacket {
+    uint64_t offset_;
+    uint64_t length_;
+    sockaddr_storage peer_address_;
+    socklen_t peer_address_length_;
+    bool has_local_ip_;
+    Address::IpVersion local_ip_version_;
+    absl::uint128 local_ip_address_;
+  };
+
+  // Room for a packet info control message of either IP version and a GSO segment size.
+  struct ControlBuffer {
+    alignas(cmsghdr) char data_[CMSG_SPACE(sizeof(in6_pktinfo)) + CMSG_SPACE(sizeof(uint16_t))];
+  };
+
+  // The most messages handed to the kernel by one sendmmsg().
+  static constexpr size_t MaxMessagesPerSend = 64;
+  // The kernel accepts at most 64 segments in one GSO message.
+  static constexpr uint64_t MaxGsoSegments = 64;
+  // A GSO message must fit in a single UDP datagram, headers included.
+  static constexpr uint64_t MaxGsoMessageSize = 65535 - 40 - 8;
+
+  static bool sameSourceAndDestination(const BufferedPacket& a, const BufferedPacket& b);
+  // Fills in the message sending packets [first, last), which are contiguous in buffer_.
+  void prepareMessage(size_t message_index, size_t first, size_t last);
+  // Sends messages [0, num_messages), returning how many of them were sent.
+  uint64_t sendMessages(size_t num_messages, Api::IoCallUint64Result& result);
+
+  IoHandle& io_handle_;
+  const bool gso_enabled_;
+  const bool mmsg_enabled_;
+  bool write_blocked_{false};
+  uint64_t last_flush_packets_sent_{0};
+  std::vector<uint8_t> buffer_;
+  std::vector<BufferedPacket> packets_;
+  std::array<mmsghdr, MaxMessagesPerSend> messages_;
+  std::array<iovec, MaxMessagesPerSend> iovecs_;
+  std::array<ControlBuffer, MaxMessagesPerSend> control_buffers_;
+  std::array<uint64_t, MaxMessagesPerSend> message_packets_;
+};
+
+class UdpBatchWriterFactory : public UdpPacketWriterFactory {
+public:
+  UdpPacketWriterPtr createUdpPacketWriter(IoHandle& io_handle, Stats::Scope&) override {
+    return std::make_unique<UdpBatchWriter>(io_handle);
+  }
+};
+
+} // namespace Network
+} // namespace Envoy
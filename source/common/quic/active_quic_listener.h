@@ -52,6 +52,7 @@ public:
 
   // Network::UdpListenerCallbacks
   void onReadReady() override;
+  void onReadComplete() override {}
   void onWriteReady(const Network::Socket& socket) override;
   void onReceiveError(Api::IoError::IoErrorCode /*error_code*/) override {
     // No-op. Quic can't do anything upon listener error.
@@ -53,6 +53,7 @@
 #include "source/extensions/path/match/uri_template/uri_template_match.h"
 #include "source/extensions/path/rewrite/uri_template/uri_template_rewrite.h"
 
+#include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 
 namespace Envoy {
@@ -120,6 +121,8 @@ public:
 namespace {
 
 constexpr uint32_t DEFAULT_MAX_DIRECT_RESPONSE_BODY_SIZE_BYTES = 4096;
+// Below this many routes a linear walk is as fast as an index lookup.
+constexpr size_t MIN_ROUTES_FOR_ROUTE_INDEX = 8;
 
 void mergeTransforms(Http::HeaderTransforms& dest, const Http::HeaderTransforms& src) {
   dest.headers_to_append_or_add.insert(dest.headers_to_append_or_add.end(),
@@ -1934,6 +1937,42 @@ VirtualHostImpl::VirtualHostImpl(
       SET_AND_RETURN_IF_NOT_OK(route_or_error.status(), creation_status);
       routes_.emplace_back(route_or_error.value());
     }
+    if (routes_.size() >= MIN_ROUTES_FOR_ROUTE_INDEX &&
+        Runtime::runtimeFeatureEnabled("envoy.reloadable_features.router_compiled_route_index")) {
+      buildRouteIndex();
+    }
+  }
+}
+
+void VirtualHostImpl::buildRouteIndex() {
+  route_index_ = std::make_unique<CompiledRouteIndex>();
+  for (uint32_t i = 0; i < routes_.size(); ++i) {
+    const RouteEntryImplBase& route = *routes_[i];
+    const std::string& matcher = route.matcher();
+    // Case-insensitive matchers can only be indexed if case folding cannot change the outcome.
+    const bool indexable =
+        route.case_sensitive() ||
+        std::none_of(matcher.begin(), matcher.end(), [](char c) { return absl::ascii_isalpha(c); });
+    switch (route.matchType()) {
+    case PathMatchType::Prefix:
+    case PathMatchType::PathSeparatedPrefix:
+      if (indexable) {
+        route_index_->addPrefix(matcher, i);
+        continue;
+      }
+      break;
+    case PathMatchType::Exact:
+      if (indexable) {
+        route_index_->addExact(matcher, i);
+        continue;
+      }
+      break;
+    case PathMatchType::None:
+    case PathMatchType::Regex:
+    case PathMatchType::Template:
+      break;
+    }
+    route_index_->addFallback(i);
   }
 }
 
@@ -1977,6 +2016,29 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
   return nullptr;
 }
 
+RouteConstSharedPtr VirtualHostImpl::getRouteFromIndex(const Http::RequestHeaderMap& headers,
+                                                       const StreamInfo::StreamInfo& stream_info,
+                                                       uint64_t random_value) const {
+  // Normalize the path the same way the prefix and exact matchers do before comparing.
+  absl::string_view path = Http::PathUtil::removeQueryAndFragment(headers.getPathValue());
+  if (shared_virtual_host_->globalRouteConfig().ignorePathParametersInPathMatching()) {
+    const size_t pos = path.find_first_of(';');
+    if (pos != absl::string_view::npos) {
+      path.remove_suffix(path.length() - pos);
+    }
+  }
+
+  RouteConstSharedPtr route_entry;
+  route_index_->forEachCandidate(path, [&](uint32_t ordinal) {
+    route_entry = routes_[ordinal]->matches(headers, stream_info, random_value);
+    return route_entry == nullptr;
+  });
+  if (route_entry == nullptr) {
+    ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  }
+  return route_entry;
+}
+
 RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb,
                                                          const Http::RequestHeaderMap& headers,
                                                          const StreamInfo::StreamInfo& stream_info,
@@ -2025,6 +2087,12 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     return nullptr;
   }
 
+  // The index only yields the first matching route, so route callbacks that may continue past a
+  // match, and pathless requests, always take the linear walk.
+  if (route_index_ != nullptr && cb == nullptr && headers.Path() != nullptr) {
+    return getRouteFromIndex(headers, stream_info, random_value);
+  }
+
   // Check for a route that matches the request.
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
@@ -0,0 +1,122 @@
+#include "source/common/router/route_index.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+
+#include "absl/strings/match.h"
+
+namespace Envoy {
+namespace Router {
+
+CompiledRouteIndex::CompiledRouteIndex() : root_(std::make_unique<RadixNode>()) {}
+
+CompiledRouteIndex::RadixNode* CompiledRouteIndex::RadixNode::findChild(char c) const {
+  auto it = std::lower_bound(
+      children_.begin(), children_.end(), c,
+      [](const std::unique_ptr<RadixNode>& child, char value) { return child->label_[0] < value; });
+  if (it != children_.end() && (*it)->label_[0] == c) {
+    return it->get();
+  }
+  return nullptr;
+}
+
+std::unique_ptr<CompiledRouteIndex::RadixNode>&
+CompiledRouteIndex::RadixNode::insertChild(std::unique_ptr<RadixNode> child) {
+  ASSERT(!child->label_.empty());
+  auto it = std::lower_bound(children_.begin(), children_.end(), child->label_[0],
+                             [](const std::unique_ptr<RadixNode>& existing, char value) {
+                               return existing->label_[0] < value;
+                             });
+  ASSERT(it == children_.end() || (*it)->label_[0] != child->label_[0]);
+  return *children_.insert(it, std::move(child));
+}
+
+void CompiledRouteIndex::addPrefix(absl::string_view prefix, uint32_t ordinal) {
+  RadixNode* node = root_.get();
+  while (!prefix.empty()) {
+    RadixNode* child = node->findChild(prefix[0]);
+    if (child == nullptr) {
+      auto leaf = std::make_unique<RadixNode>();
+      leaf->label_ = std::string(prefix);
+      node = node->insertChild(std::move(leaf)).get();
+      prefix = {};
+      break;
+    }
+
+    const absl::string_view label = child->label_;
+    size_t common = 0;
+    const size_t max_common = std::min(label.size(), prefix.size());
+    while (common < max_common && label[common] == prefix[common]) {
+      ++common;
+    }
+
+    if (common < label.size()) {
+      // Split the edge: the existing child keeps the tail of its label under a new intermediate
+      // node that owns the shared part.
+      auto intermediate = std::make_unique<RadixNode>();
+      intermediate->label_ = std::string(label.substr(0, common));
+      auto it = std::find_if(
+          node->children_.begin(), node->children_.end(),
+          [child](const std::unique_ptr<RadixNode>& existing) { return existing.get() == child; });
+      ASSERT(it != node->children_.end());
+      std::unique_ptr<RadixNode> existing = std::move(*it);
+      existing->label_.erase(0, common);
+      intermediate->children_.push_back(std::move(existing));
+      *it = std::move(intermediate);
+      child = it->get();
+    }
+
+    node = child;
+    prefix.remove_prefix(common);
+  }
+
+  ASSERT(node->ordinals_.empty() || node->ordinals_.back() < ordinal);
+  node->ordinals_.push_back(ordinal);
+  ++size_;
+}
+
+void CompiledRouteIndex::addExact(absl::string_view path, uint32_t ordinal) {
+  OrdinalList& ordinals = exact_[path];
+  ASSERT(ordinals.empty() || ordinals.back() < ordinal);
+  ordinals.push_back(ordinal);
+  ++size_;
+}
+
+void CompiledRouteIndex::addFallback(uint32_t ordinal) {
+  ASSERT(fallback_.empty() || fallback_.back() < ordinal);
+  fallback_.push_back(ordinal);
+  ++size_;
+}
+
+void CompiledRouteIndex::collectCandidates(absl::string_view path, CandidateLists& lists) const {
+  if (!fallback_.empty()) {
+    lists.emplace_back(fallback_);
+  }
+
+  if (!exact_.empty()) {
+    auto it = exact_.find(path);
+    if (it != exact_.end()) {
+      lists.emplace_back(it->second);
+    }
+  }
+
+  const RadixNode* node = root_.get();
+  while (true) {
+    if (!node->ordinals_.empty()) {
+      lists.emplace_back(node->ordinals_);
+    }
+    if (path.empty()) {
+      return;
+    }
+    const RadixNode* child = node->findChild(path[0]);
+    if (child == nullptr || !absl::StartsWith(path, child->label_)) {
+      return;
+    }
+    path.remove_prefix(child->label_.size());
+    node = child;
+  }
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * A path index over the ordered route list of a virtual host. Each route is identified by its
+ * ordinal (its position in the route list) and registered as one of:
+ *  - a prefix route, which may match any path that starts with the prefix,
+ *  - an exact route, which may only match a path equal to the registered path,
+ *  - a fallback route, which may match any path (regex, template, case-insensitive, ...).
+ *
+ * Prefixes are stored in a radix tree, so looking up the candidates for a path costs
+ * O(length of the path) regardless of how many routes are registered. The index only narrows the
+ * set of routes which could match on path alone; callers still run the full route match on each
+ * candidate, in ascending ordinal order, which preserves first-match semantics.
+ */
+class CompiledRouteIndex {
+public:
+  CompiledRouteIndex();
+
+  void addPrefix(absl::string_view prefix, uint32_t ordinal);
+  void addExact(absl::string_view path, uint32_t ordinal);
+  void addFallback(uint32_t ordinal);
+
+  /**
+   * Visit every route that may match the given path, in ascending ordinal order.
+   * @param path supplies the path, with the query string, fragment and any ignored path
+   *        parameters already removed.
+   * @param cb supplies the callback, invoked with each candidate ordinal. Iteration stops once the
+   *        callback returns false.
+   */
+  template <class Callback> void forEachCandidate(absl::string_view path, Callback cb) const {
+    CandidateLists lists;
+    collectCandidates(path, lists);
+    // The number of lists is bounded by the depth of the radix tree walk plus two, so a linear
+    // scan for the smallest head is cheaper than maintaining a heap.
+    while (true) {
+      size_t best = lists.size();
+      for (size_t i = 0; i < lists.size(); ++i) {
+        if (!lists[i].empty() && (best == lists.size() || lists[i][0] < lists[best][0])) {
+          best = i;
+        }
+      }
+      if (best == lists.size()) {
+        return;
+      }
+      const uint32_t ordinal = lists[best][0];
+      lists[best].remove_prefix(1);
+      if (!cb(ordinal)) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @return the number of routes registered with the index.
+   */
+  uint32_t size() const { return size_; }
+
+private:
+  using OrdinalList = std::vector<uint32_t>;
+  using CandidateLists = absl::InlinedVector<absl::Span<const uint32_t>, 8>;
+
+  struct RadixNode {
+    // The edge label leading to this node from its parent.
+    std::string label_;
+    // Prefix routes whose prefix ends exactly at this node, in ascending ordinal order.
+    OrdinalList ordinals_;
+    // Children, sorted by the first byte of their label. Labels of siblings never share a first
+    // byte.
+    std::vector<std::unique_ptr<RadixNode>> children_;
+
+    RadixNode* findChild(char c) const;
+    std::unique_ptr<RadixNode>& insertChild(std::unique_ptr<RadixNode> child);
+  };
+
+  void collectCandidates(absl::string_view path, CandidateLists& lists) const;
+
+  std::unique_ptr<RadixNode> root_;
+  absl::flat_hash_map<std::string, OrdinalList> exact_;
+  OrdinalList fallback_;
+  uint32_t size_{};
+};
+
+using CompiledRouteIndexPtr = std::unique_ptr<CompiledRouteIndex>;
+
+} // namespace Router
+} // namespace Envoy
@@ -88,6 +88,7 @@ RUNTIME_GUARD(envoy_reloadable_features_stateful_session_encode_ttl_in_cookie);
 RUNTIME_GUARD(envoy_reloadable_features_strict_duration_validation);
 RUNTIME_GUARD(envoy_reloadable_features_tcp_tunneling_send_downstream_fin_on_upstream_trailers);
 RUNTIME_GUARD(envoy_reloadable_features_test_feature_true);
+RUNTIME_GUARD(envoy_reloadable_features_udp_proxy_batch_upstream_writes);
 RUNTIME_GUARD(envoy_reloadable_features_udp_socket_apply_aggregated_read_limit);
 RUNTIME_GUARD(envoy_reloadable_features_uhv_allow_malformed_url_encoding);
 RUNTIME_GUARD(envoy_reloadable_features_upstream_allow_connect_with_2xx);
@@ -150,6 +151,15 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_reresolve_null_addresses);
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_reresolve_if_no_connections);
 // TODO(adisuissa): flip to true after this is out of alpha mode.
 FALSE_RUNTIME_GUARD(envoy_restart_features_xds_failover_support);
+// TODO(hwyuan): flip to true once the compiled route index has soaked on large route tables.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_router_compiled_route_index);
+// Keeps the timers of worker dispatchers in a timing wheel rather than in libevent.
+FALSE_RUNTIME_GUARD(envoy_restart_features_worker_timer_wheel);
+// Copies runs of small buffer slices together before writing them to a socket.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_coalesce_small_write_slices);
+// Keeps the EDF schedule of unchanged hosts across host updates. Flip to true once the exact pick
+// sequences of the load balancer tests are covered for the in-place path.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_edf_lb_update_weights_in_place);
 
 // A flag to set the maximum TLS version for google_grpc client to TLS1.2, when needed for
 // compliance restrictions.
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "envoy/stats/sink.h"
+
+namespace Envoy {
+namespace Stats {
+
+/**
+ * Wraps a sink so that it is only flushed metrics that changed since the previous flush.
+ * @see Sink::changedMetricsOnly().
+ */
+class ChangedMetricsSink : public Sink {
+public:
+  explicit ChangedMetricsSink(SinkPtr&& sink) : sink_(std::move(sink)) {}
+
+  // Stats::Sink
+  void flush(MetricSnapshot& snapshot) override { sink_->flush(snapshot); }
+  void onHistogramComplete(const Histogram& histogram, uint64_t value) override {
+    sink_->onHistogramComplete(histogram, value);
+  }
+  bool changedMetricsOnly() const override { return true; }
+
+private:
+  const SinkPtr sink_;
+};
+
+/**
+ * @return the sink wrapped in a ChangedMetricsSink if changed_only is set, otherwise the sink
+ *         itself.
+ */
+inline SinkPtr maybeChangedMetricsOnly(SinkPtr&& sink, bool changed_only) {
+  if (changed_only) {
+    return std::make_unique<ChangedMetricsSink>(std::move(sink));
+  }
+  return std::move(sink);
+}
+
+} // namespace Stats
+} // namespace Envoy
@@ -1,6 +1,7 @@
 #include "source/common/stats/symbol_table.h"
 
 #include <algorithm>
+#include <bit>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -261,11 +262,8 @@ bool StatName::startsWith(StatName prefix) const {
 
 std::vector<absl::string_view> SymbolTable::decodeStrings(StatName stat_name) const {
   std::vector<absl::string_view> strings;
-  Thread::LockGuard lock(lock_);
   Encoding::decodeTokens(
-      stat_name,
-      [this, &strings](Symbol symbol)
-          ABSL_NO_THREAD_SAFETY_ANALYSIS { strings.push_back(fromSymbol(symbol)); },
+      stat_name, [this, &strings](Symbol symbol) { strings.push_back(fromSymbol(symbol)); },
       [&strings](absl::string_view str) { strings.push_back(str); });
   return strings;
 }
@@ -286,6 +284,79 @@ void SymbolTable::Encoding::appendToMemBlock(StatName stat_name,
   }
 }
 
+SymbolTable::DecodeTable::~DecodeTable() {
+  for (uint32_t chunk = 0; chunk < NumChunks; ++chunk) {
+    Entry* entries = chunks_[chunk].load(std::memory_order_relaxed);
+    if (entries == nullptr) {
+      continue;
+    }
+    for (uint64_t i = 0; i < chunkSize(chunk); ++i) {
+      delete entries[i].load(std::memory_order_relaxed);
+    }
+    delete[] entries;
+  }
+}
+
+std::pair<uint32_t, uint64_t> SymbolTable::DecodeTable::locate(Symbol symbol) {
+  // Offsetting the symbol by the size of the first chunk makes the position of
+  // its top bit the index of its chunk, plus FirstChunkBits.
+  const uint64_t offset_symbol = uint64_t(symbol) + chunkSize(0);
+  const uint32_t top_bit = static_cast<uint32_t>(std::bit_width(offset_symbol)) - 1;
+  return {top_bit - FirstChunkBits, offset_symbol - (uint64_t(1) << top_bit)};
+}
+
+const InlineString* SymbolTable::DecodeTable::find(Symbol symbol) const {
+  const auto [chunk, index] = locate(symbol);
+  const Entry* entries = chunks_[chunk].load(std::memory_order_acquire);
+  if (entries == nullptr) {
+    return nullptr;
+  }
+  return entries[index].load(std::memory_order_acquire);
+}
+
+void SymbolTable::DecodeTable::insert(Symbol symbol, InlineStringPtr str) {
+  const auto [chunk, index] = locate(symbol);
+  Entry* entries = chunks_[chunk].load(std::memory_order_relaxed);
+  if (entries == nullptr) {
+    const uint64_t size = chunkSize(chunk);
+    entries = new Entry[size];
+    for (uint64_t i = 0; i < size; ++i) {
+      entries[i].store(nullptr, std::memory_order_relaxed);
+    }
+    chunks_[chunk].store(entries, std::memory_order_release);
+  }
+  ASSERT(entries[index].load(std::memory_order_relaxed) == nullptr);
+  entries[index].store(str.release(), std::memory_order_release);
+  ++size_;
+}
+
+void SymbolTable::DecodeTable::erase(Symbol symbol) {
+  const auto [chunk, index] = locate(symbol);
+  Entry* entries = chunks_[chunk].load(std::memory_order_relaxed);
+  ASSERT(entries != nullptr);
+  InlineStringPtr str(entries[index].exchange(nullptr, std::memory_order_relaxed));
+  ASSERT(str != nullptr);
+  --size_;
+}
+
+void SymbolTable::DecodeTable::forEach(
+    const std::function<void(Symbol, const InlineString&)>& fn) const {
+  for (uint32_t chunk = 0; chunk < NumChunks; ++chunk) {
+    const Entry* entries = chunks_[chunk].load(std::memory_order_acquire);
+    if (entries == nullptr) {
+      continue;
+    }
+    // The chunks before this one hold chunkSize(chunk) - chunkSize(0) symbols.
+    const uint64_t first_symbol = chunkSize(chunk) - chunkSize(0);
+    for (uint64_t i = 0; i < chunkSize(chunk); ++i) {
+      const InlineString* str = entries[i].load(std::memory_order_acquire);
+      if (str != nullptr) {
+        fn(first_symbol + i, *str);
+      }
+    }
+  }
+}
+
 SymbolTable::SymbolTable()
     // Have to be explicitly initialized, if we want to use the ABSL_GUARDED_BY macro.
     : next_symbol_(FirstValidSymbol), monotonic_counter_(FirstValidSymbol) {}
@@ -332,7 +403,7 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
 
 uint64_t SymbolTable::numSymbols() const {
   Thread::LockGuard lock(lock_);
-  ASSERT(encode_map_.size() == decode_map_.size());
+  ASSERT(encode_map_.size() == decode_table_.size());
   return encode_map_.size();
 }
 
@@ -346,13 +417,13 @@ void SymbolTable::incRefCount(const StatName& stat_name) {
 
   Thread::LockGuard lock(lock_);
   for (Symbol symbol : symbols) {
-    auto decode_search = decode_map_.find(symbol);
+    const InlineString* decode_search = decode_table_.find(symbol);
 
-    ASSERT(decode_search != decode_map_.end(),
+    ASSERT(decode_search != nullptr,
            "Please see "
            "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
            "debugging-symbol-table-assertions");
-    auto encode_search = encode_map_.find(decode_search->second->toStringView());
+    auto encode_search = encode_map_.find(decode_search->toStringView());
     ASSERT(encode_search != encode_map_.end(),
            "Please see "
            "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
@@ -368,10 +439,10 @@ void SymbolTable::free(const StatName& stat_name) {
 
   Thread::LockGuard lock(lock_);
   for (Symbol symbol : symbols) {
-    auto decode_search = decode_map_.find(symbol);
-    ASSERT(decode_search != decode_map_.end());
+    const InlineString* decode_search = decode_table_.find(symbol);
+    ASSERT(decode_search != nullptr);
 
-    auto encode_search = encode_map_.find(decode_search->second->toStringView());
+    auto encode_search = encode_map_.find(decode_search->toStringView());
     ASSERT(encode_search != encode_map_.end());
 
     // If that was the last remaining client usage of the symbol, erase the
@@ -381,8 +452,9 @@ void SymbolTable::free(const StatName& stat_name) {
     // symbol_table_speed_test.cc, relative to breaking out the decrement into a
     // separate step, likely due to the non-trivial dereferences in EXPR.
     if (--encode_search->second.ref_count_ == 0) {
-      decode_map_.erase(decode_search);
+      // The encode map's key refers to the string, so it is erased first.
       encode_map_.erase(encode_search);
+      decode_table_.erase(symbol);
       pool_.push(symbol);
     }
   }
@@ -470,15 +542,13 @@ Symbol SymbolTable::toSymbol(absl::string_view sv) {
   auto encode_find = encode_map_.find(sv);
   // If the string segment doesn't already exist,
   if (encode_find == encode_map_.end()) {
-    // We create the actual string, place it in the decode_map_, and then insert
+    // We create the actual string, place it in the decode_table_, and then insert
     // a string_view pointing to it in the encode_map_. This allows us to only
-    // store the string once. We use unique_ptr so copies are not made as
-    // flat_hash_map moves values around.
+    // store the string once.
     InlineStringPtr str = InlineString::create(sv);
     auto encode_insert = encode_map_.insert({str->toStringView(), SharedSymbol(next_symbol_)});
     ASSERT(encode_insert.second);
-    auto decode_insert = decode_map_.insert({next_symbol_, std::move(str)});
-    ASSERT(decode_insert.second);
+    decode_table_.insert(next_symbol_, std::move(str));
 
     result = next_symbol_;
     newSymbol();
@@ -491,11 +561,10 @@ Symbol SymbolTable::toSymbol(absl::string_view sv) {
   return result;
 }
 
-absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
-  auto search = decode_map_.find(symbol);
-  RELEASE_ASSERT(search != decode_map_.end(), "no such symbol");
-  return search->second->toStringView();
+absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const {
+  const InlineString* search = decode_table_.find(symbol);
+  RELEASE_ASSERT(search != nullptr, "no such symbol");
+  return search->toStringView();
 }
 
 void SymbolTable::newSymbol() ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
@@ -510,15 +579,6 @@ void SymbolTable::newSymbol() ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
 }
 
 bool SymbolTable::lessThan(const StatName& a, const StatName& b) const {
-  // Proactively take the table lock in anticipation that we'll need to
-  // convert at least one symbol to a string_view, and it's easier not to
-  // bother to lazily take the lock.
-  Thread::LockGuard lock(lock_);
-  return lessThanLockHeld(a, b);
-}
-
-bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
   Encoding::TokenIter a_iter(a), b_iter(b);
   while (true) {
     Encoding::TokenIter::TokenType a_type = a_iter.next();
@@ -549,16 +609,13 @@ bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
 #ifndef ENVOY_CONFIG_COVERAGE
 void SymbolTable::debugPrint() const {
   Thread::LockGuard lock(lock_);
-  std::vector<Symbol> symbols;
-  for (const auto& p : decode_map_) {
-    symbols.push_back(p.first);
-  }
-  std::sort(symbols.begin(), symbols.end());
-  for (Symbol symbol : symbols) {
-    const InlineString& token = *decode_map_.find(symbol)->second;
-    const SharedSymbol& shared_symbol = encode_map_.find(token.toStringView())->second;
-    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(), shared_symbol.ref_count_);
-  }
+  decode_table_.forEach([this](Symbol symbol, const InlineString& token)
+                            ABSL_NO_THREAD_SAFETY_ANALYSIS {
+                              const SharedSymbol& shared_symbol =
+                                  encode_map_.find(token.toStringView())->second;
+                              ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(),
+                                             shared_symbol.ref_count_);
+                            });
 }
 #endif
 
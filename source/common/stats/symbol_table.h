@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -67,6 +69,9 @@ using SymbolVec = std::vector<Symbol>;
  * not own the storage or keep it alive via reference counts; the owner must
  * ensure the backing store lives as long as the StatName.
  *
+ * Decoding a StatName, as done by toString() and lessThan(), takes no lock.
+ * Encoding and freeing names, which change the symbols' reference counts, do.
+ *
  * The underlying Symbol / SymbolVec data structures are private to the
  * impl. One side effect of the non-monotonically-increasing symbol counter is
  * that if a string is encoded, the resulting stat is destroyed, and then that
@@ -324,8 +329,6 @@ public:
    */
   DynamicSpans getDynamicSpans(StatName stat_name) const;
 
-  bool lessThanLockHeld(const StatName& a, const StatName& b) const;
-
   template <class GetStatName, class Obj> struct StatNameCompare {
     StatNameCompare(const SymbolTable& symbol_table, GetStatName getter)
         : symbol_table_(symbol_table), getter_(getter) {}
@@ -337,9 +340,7 @@ public:
   };
 
   /**
-   * Sorts a range by StatName. This API is more efficient than
-   * calling std::sort directly as it takes a single lock for the
-   * entire sort, rather than locking on each comparison.
+   * Sorts a range by StatName.
    *
    * @param begin the beginning of the range to sort
    * @param end the end of the range to sort
@@ -347,9 +348,6 @@ public:
    */
   template <class Obj, class Iter, class GetStatName>
   void sortByStatNames(Iter begin, Iter end, GetStatName get_stat_name) const {
-    // Grab the lock once before sorting begins, so we don't have to re-take
-    // it on every comparison.
-    Thread::LockGuard lock(lock_);
     StatNameCompare<GetStatName, Obj> compare(*this, get_stat_name);
     std::sort(begin, end, compare);
   }
@@ -402,6 +400,61 @@ private:
     uint32_t ref_count_{1};
   };
 
+  /**
+   * Maps symbols to their strings. Symbols are allocated densely from 1, so
+   * they index an array. The array is split into chunks, each twice the size
+   * of the one before, so that it grows without moving its entries, and the
+   * chunks are only freed with the table. Thus the string of a symbol can be
+   * read without taking a lock while other threads add and remove symbols,
+   * which is done with lock_ held. A symbol being decoded cannot be removed
+   * meanwhile, as the StatName holding it keeps a reference to it.
+   */
+  class DecodeTable {
+  public:
+    DecodeTable() = default;
+    ~DecodeTable();
+
+    /**
+     * @return the string of a symbol, or nullptr if the symbol is not in the table.
+     */
+    const InlineString* find(Symbol symbol) const;
+
+    /**
+     * Adds a symbol which is not in the table.
+     */
+    void insert(Symbol symbol, InlineStringPtr str);
+
+    /**
+     * Removes a symbol which is in the table, freeing its string.
+     */
+    void erase(Symbol symbol);
+
+    /**
+     * @return the number of symbols in the table.
+     */
+    uint64_t size() const { return size_; }
+
+    /**
+     * Calls fn with each symbol in the table, in ascending order, and its string.
+     */
+    void forEach(const std::function<void(Symbol, const InlineString&)>& fn) const;
+
+  private:
+    using Entry = std::atomic<InlineString*>;
+
+    // The first chunk holds 256 symbols. There are enough chunks for every
+    // 32-bit symbol.
+    static constexpr uint32_t FirstChunkBits = 8;
+    static constexpr uint32_t NumChunks = 32 - FirstChunkBits + 1;
+
+    // Returns the index of the chunk holding a symbol, and of its entry in the chunk.
+    static std::pair<uint32_t, uint64_t> locate(Symbol symbol);
+    static uint64_t chunkSize(uint32_t chunk) { return uint64_t(1) << (chunk + FirstChunkBits); }
+
+    std::array<std::atomic<Entry*>, NumChunks> chunks_{};
+    uint64_t size_{0};
+  };
+
   // This must be held during both encode() and free().
   mutable Thread::MutexBasicLockable lock_;
 
@@ -429,12 +482,13 @@ private:
   Symbol toSymbol(absl::string_view sv) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   /**
-   * Convenience function for decode(), decoding one symbol at a time.
+   * Convenience function for decode(), decoding one symbol at a time. This
+   * does not require lock_.
    *
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(Symbol symbol) const;
 
   /**
    * Stages a new symbol for use. To be called after a successful insertion.
@@ -464,11 +518,11 @@ private:
 
   // Bitmap implementation.
   // The encode map stores both the symbol and the ref count of that symbol.
-  // Using absl::string_view lets us only store the complete string once, in the decode map.
+  // Using absl::string_view lets us only store the complete string once, in the decode table.
   using EncodeMap = absl::flat_hash_map<absl::string_view, SharedSymbol>;
-  using DecodeMap = absl::flat_hash_map<Symbol, InlineStringPtr>;
   EncodeMap encode_map_ ABSL_GUARDED_BY(lock_);
-  DecodeMap decode_map_ ABSL_GUARDED_BY(lock_);
+  // Read without lock_, but only changed with it held.
+  DecodeTable decode_table_;
 
   // Free pool of symbols for re-use.
   // TODO(ambuc): There might be an optimization here relating to storing ranges of freed symbols
@@ -1065,7 +1119,7 @@ template <class GetStatName, class Obj>
 bool SymbolTable::StatNameCompare<GetStatName, Obj>::operator()(const Obj& a, const Obj& b) const {
   StatName a_stat_name = getter_(a);
   StatName b_stat_name = getter_(b);
-  return symbol_table_.lessThanLockHeld(a_stat_name, b_stat_name);
+  return symbol_table_.lessThan(a_stat_name, b_stat_name);
 }
 
 using SymbolTablePtr = std::unique_ptr<SymbolTable>;
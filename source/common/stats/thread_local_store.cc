@@ -1,10 +1,13 @@
 #include "source/common/stats/thread_local_store.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "envoy/stats/allocator.h"
 #include "envoy/stats/histogram.h"
@@ -218,12 +221,22 @@ void ThreadLocalStoreImpl::shutdownThreading() {
     central_cache_entries_to_cleanup_.clear();
   }
 
-  Thread::LockGuard lock(hist_mutex_);
-  for (ParentHistogramImpl* histogram : histogram_set_) {
-    histogram->setShuttingDown(true);
+  {
+    Thread::LockGuard lock(hist_mutex_);
+    for (ParentHistogramImpl* histogram : histogram_set_) {
+      histogram->setShuttingDown(true);
+    }
+    histogram_set_.clear();
+    sinked_histograms_.clear();
+  }
+
+  // Dropping these references may take hist_mutex_, so it must not be held here.
+  std::vector<ParentHistogramImplSharedPtr> dirty_histograms;
+  {
+    Thread::LockGuard lock(dirty_histograms_mutex_);
+    dirty_histograms.swap(dirty_histograms_);
   }
-  histogram_set_.clear();
-  sinked_histograms_.clear();
+  histograms_merged_last_interval_.clear();
 }
 
 void ThreadLocalStoreImpl::mergeHistograms(PostMergeCb merge_complete_cb) {
@@ -231,10 +244,20 @@ void ThreadLocalStoreImpl::mergeHistograms(PostMergeCb merge_complete_cb) {
     ASSERT(!merge_in_progress_);
     merge_in_progress_ = true;
     tls_cache_->runOnAllThreads(
-        [](OptRef<TlsCache> tls_cache) {
-          for (const auto& id_hist : tls_cache->tls_histogram_cache_) {
-            const TlsHistogramSharedPtr& tls_hist = id_hist.second;
+        [this](OptRef<TlsCache> tls_cache) {
+          // Only histograms recorded into since the last merge have anything to swap out.
+          std::vector<ParentHistogramImplSharedPtr> parents;
+          parents.reserve(tls_cache->dirty_histograms_.size());
+          for (auto& [tls_hist, parent] : tls_cache->dirty_histograms_) {
             tls_hist->beginMerge();
+            parents.push_back(std::move(parent));
+          }
+          tls_cache->dirty_histograms_.clear();
+          if (!parents.empty()) {
+            Thread::LockGuard lock(dirty_histograms_mutex_);
+            dirty_histograms_.insert(dirty_histograms_.end(),
+                                     std::make_move_iterator(parents.begin()),
+                                     std::make_move_iterator(parents.end()));
           }
         },
         [this, merge_complete_cb]() -> void { mergeInternal(merge_complete_cb); });
@@ -246,7 +269,27 @@ void ThreadLocalStoreImpl::mergeHistograms(PostMergeCb merge_complete_cb) {
 
 void ThreadLocalStoreImpl::mergeInternal(PostMergeCb merge_complete_cb) {
   if (!shutting_down_) {
-    forEachHistogram(nullptr, [](ParentHistogram& histogram) { histogram.merge(); });
+    std::vector<ParentHistogramImplSharedPtr> dirty;
+    {
+      Thread::LockGuard lock(dirty_histograms_mutex_);
+      dirty.swap(dirty_histograms_);
+    }
+    const auto by_address = [](const ParentHistogramImplSharedPtr& a,
+                               const ParentHistogramImplSharedPtr& b) { return a.get() < b.get(); };
+    std::sort(dirty.begin(), dirty.end(), by_address);
+    dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+    // Histograms that were not recorded into this interval only need merging if they still hold
+    // data from the previous interval; every other histogram is already up to date.
+    for (const ParentHistogramImplSharedPtr& histogram : histograms_merged_last_interval_) {
+      if (!std::binary_search(dirty.begin(), dirty.end(), histogram, by_address)) {
+        histogram->merge();
+      }
+    }
+    for (const ParentHistogramImplSharedPtr& histogram : dirty) {
+      histogram->merge();
+    }
+    histograms_merged_last_interval_ = std::move(dirty);
     merge_complete_cb();
     merge_in_progress_ = false;
   }
@@ -777,8 +820,12 @@ Histogram& ThreadLocalStoreImpl::tlsHistogram(ParentHistogramImpl& parent, uint6
 
   TlsHistogramSharedPtr* tls_histogram = nullptr;
   if (!shutting_down_ && tls_cache_) {
-    tls_histogram = &(tlsCache().tls_histogram_cache_[id]);
+    TlsCache& tls_cache = tlsCache();
+    tls_histogram = &(tls_cache.tls_histogram_cache_[id]);
     if (*tls_histogram != nullptr) {
+      if ((*tls_histogram)->markDirty()) {
+        tls_cache.dirty_histograms_.emplace_back(*tls_histogram, &parent);
+      }
       return **tls_histogram;
     }
   }
@@ -793,6 +840,8 @@ Histogram& ThreadLocalStoreImpl::tlsHistogram(ParentHistogramImpl& parent, uint6
 
   if (tls_histogram != nullptr) {
     *tls_histogram = hist_tls_ptr;
+    hist_tls_ptr->markDirty();
+    tlsCache().dirty_histograms_.emplace_back(hist_tls_ptr, &parent);
   }
 
   return *hist_tls_ptr;
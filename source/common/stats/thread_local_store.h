@@ -6,6 +6,8 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "envoy/stats/tag.h"
 #include "envoy/thread_local/thread_local.h"
@@ -47,6 +49,17 @@ public:
     // This switches the current_active_ between 1 and 0.
     ASSERT(std::this_thread::get_id() == created_thread_id_);
     current_active_ = otherHistogramIndex();
+    dirty_ = false;
+  }
+
+  /**
+   * Marks the histogram as recorded into since the last call to beginMerge().
+   * @return true if the histogram was not already marked, in which case the caller must queue it
+   *         for the next merge.
+   */
+  bool markDirty() {
+    ASSERT(std::this_thread::get_id() == created_thread_id_);
+    return !std::exchange(dirty_, true);
   }
 
   // Stats::Histogram
@@ -67,6 +80,8 @@ private:
   uint64_t otherHistogramIndex() const { return 1 - current_active_; }
   uint64_t current_active_{0};
   histogram_t* histograms_[2];
+  // Only accessed on the owning thread.
+  bool dirty_{false};
   std::atomic<bool> used_;
   std::thread::id created_thread_id_;
   SymbolTable& symbol_table_;
@@ -197,6 +212,10 @@ public:
   void mergeHistograms(PostMergeCb merge_cb) override;
   void deliverHistogramToSinks(const Histogram& histogram, uint64_t value) override;
 
+  /**
+   * Returns the calling thread's histogram for recording into parent. The histogram is queued for
+   * the next merge on the calling thread, so only histograms with new values are merged.
+   */
   Histogram& tlsHistogram(ParentHistogramImpl& parent, uint64_t id);
 
   void forEachSinkedCounter(SizeFn f_size, StatFn<Counter> f_stat) const override;
@@ -459,6 +478,9 @@ private:
 
     // Maps from histogram ID (monotonically increasing) to a TLS histogram.
     absl::flat_hash_map<uint64_t, TlsHistogramSharedPtr> tls_histogram_cache_;
+
+    // TLS histograms recorded into on this thread since the last merge, with their parents.
+    std::vector<std::pair<TlsHistogramSharedPtr, ParentHistogramImplSharedPtr>> dirty_histograms_;
   };
 
   using ScopeImplSharedPtr = std::shared_ptr<ScopeImpl>;
@@ -559,6 +581,18 @@ private:
   // (e.g. when a scope is deleted), it is likely more efficient to batch their
   // cleanup, which would otherwise entail a post() per histogram per thread.
   std::vector<uint64_t> histograms_to_cleanup_ ABSL_GUARDED_BY(hist_mutex_);
+
+  // Parent histograms with values recorded since the last merge, collected from every thread's
+  // TlsCache at the start of a merge. A histogram recorded on several threads appears once per
+  // thread.
+  Thread::MutexBasicLockable dirty_histograms_mutex_;
+  std::vector<ParentHistogramImplSharedPtr>
+      dirty_histograms_ ABSL_GUARDED_BY(dirty_histograms_mutex_);
+
+  // Parent histograms whose interval histogram was non-empty after the previous merge. These must
+  // be merged once more even if they were not recorded into, so their interval data is cleared.
+  // Only accessed on the main thread.
+  std::vector<ParentHistogramImplSharedPtr> histograms_merged_last_interval_;
 };
 
 using ThreadLocalStoreImplPtr = std::unique_ptr<ThreadLocalStoreImpl>;
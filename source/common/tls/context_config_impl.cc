@@ -186,7 +186,8 @@ ContextConfigImpl::ContextConfigImpl(
                                                 default_min_protocol_version)),
       max_protocol_version_(tlsVersionFromProto(config.tls_params().tls_maximum_protocol_version(),
                                                 default_max_protocol_version)),
-      factory_context_(factory_context), tls_keylog_path_(config.key_log().path()) {
+      factory_context_(factory_context), tls_keylog_path_(config.key_log().path()),
+      kernel_tls_offload_(config.kernel_tls_offload()) {
   auto list_or_error = Network::Address::IpList::create(config.key_log().local_address_range());
   THROW_IF_STATUS_NOT_OK(list_or_error, throw);
   tls_keylog_local_ = std::move(list_or_error.value());
@@ -381,6 +382,10 @@ ClientContextConfigImpl::ClientContextConfigImpl(
        config.common_tls_context().tls_certificate_sds_secret_configs().size()) > 1) {
     throwEnvoyExceptionOrPanic("Multiple TLS certificates are not supported for client contexts");
   }
+  // Once the kernel encrypts the writes, the TLS library can no longer answer a renegotiation.
+  if (allow_renegotiation_ && config.common_tls_context().kernel_tls_offload()) {
+    throwEnvoyExceptionOrPanic("kernel_tls_offload cannot be used with allow_renegotiation");
+  }
 }
 
 const unsigned ServerContextConfigImpl::DEFAULT_MIN_VERSION = TLS1_2_VERSION;
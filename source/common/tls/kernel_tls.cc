@@ -0,0 +1,255 @@
+#include "source/common/tls/kernel_tls.h"
+
+#include <cstring>
+
+#include "envoy/common/platform.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "openssl/hkdf.h"
+#include "openssl/mem.h"
+#include "openssl/nid.h"
+#include "openssl/sha.h"
+
+#ifdef __linux__
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+namespace {
+
+#ifdef __linux__
+
+// The TLS alert record type, and the close_notify alert at warning level.
+constexpr uint8_t AlertRecordType = 21;
+constexpr uint8_t CloseNotifyAlert[] = {1, 0};
+
+// The keys of the write direction of a connection. The salt is the fixed part of the AEAD nonce.
+struct TransmitKeys {
+  ~TransmitKeys() {
+    OPENSSL_cleanse(key_.data(), key_.size());
+    OPENSSL_cleanse(salt_.data(), salt_.size());
+    OPENSSL_cleanse(iv_.data(), iv_.size());
+  }
+
+  std::vector<uint8_t> key_;
+  std::vector<uint8_t> salt_;
+  // The explicit (TLS 1.2) or remaining (TLS 1.3) part of the nonce.
+  std::vector<uint8_t> iv_;
+};
+
+absl::Status tls12TransmitKeys(SSL* ssl, size_t key_length, TransmitKeys& keys) {
+  // The key block of an AEAD cipher suite holds the client and server write keys followed by
+  // their fixed IVs, as it has no MAC keys.
+  constexpr size_t FixedIvLength = 4;
+  std::vector<uint8_t> key_block(SSL_get_key_block_len(ssl));
+  if (key_block.size() != 2 * (key_length + FixedIvLength)) {
+    return absl::FailedPreconditionError(
+        absl::StrCat("unexpected key block length ", key_block.size()));
+  }
+  if (!SSL_generate_key_block(ssl, key_block.data(), key_block.size())) {
+    return absl::InternalError("failed to generate the key block");
+  }
+  const size_t own = SSL_is_server(ssl) ? 1 : 0;
+  const uint8_t* key = key_block.data() + own * key_length;
+  const uint8_t* salt = key_block.data() + 2 * key_length + own * FixedIvLength;
+  keys.key_.assign(key, key + key_length);
+  keys.salt_.assign(salt, salt + FixedIvLength);
+  // The explicit part of the nonce only has to be unique. As BoringSSL does, use the sequence
+  // number, which the kernel advances along with it.
+  const uint64_t sequence = SSL_get_write_sequence(ssl);
+  for (int i = 7; i >= 0; i--) {
+    keys.iv_.push_back(static_cast<uint8_t>(sequence >> (8 * i)));
+  }
+  OPENSSL_cleanse(key_block.data(), key_block.size());
+  return absl::OkStatus();
+}
+
+absl::Status tls13TransmitKeys(SSL* ssl, const SSL_CIPHER* cipher, size_t key_length,
+                               TransmitKeys& keys) {
+  constexpr size_t SaltLength = 4;
+  constexpr size_t NonceLength = 12;
+  bssl::Span<const uint8_t> read_secret;
+  bssl::Span<const uint8_t> write_secret;
+  if (!bssl::SSL_get_traffic_secrets(ssl, &read_secret, &write_secret)) {
+    return absl::InternalError("failed to get the traffic secrets");
+  }
+  const EVP_MD* digest = EVP_get_digestbynid(SSL_CIPHER_get_prf_nid(cipher));
+  if (digest == nullptr) {
+    return absl::InternalError("unknown cipher suite digest");
+  }
+  const absl::Span<const uint8_t> secret(write_secret.data(), write_secret.size());
+  keys.key_ = hkdfExpandLabel(digest, secret, "key", key_length);
+  std::vector<uint8_t> nonce = hkdfExpandLabel(digest, secret, "iv", NonceLength);
+  if (keys.key_.empty() || nonce.empty()) {
+    return absl::InternalError("failed to derive the traffic keys");
+  }
+  keys.salt_.assign(nonce.begin(), nonce.begin() + SaltLength);
+  keys.iv_.assign(nonce.begin() + SaltLength, nonce.end());
+  OPENSSL_cleanse(nonce.data(), nonce.size());
+  return absl::OkStatus();
+}
+
+template <class CryptoInfo>
+absl::Status installTransmitKeys(Network::IoHandle& io_handle, uint16_t version,
+                                 uint16_t cipher_type, const TransmitKeys& keys,
+                                 uint64_t sequence) {
+  CryptoInfo crypto_info{};
+  crypto_info.info.version = version;
+  crypto_info.info.cipher_type = cipher_type;
+  ASSERT(keys.key_.size() == sizeof(crypto_info.key) &&
+         keys.salt_.size() == sizeof(crypto_info.salt) &&
+         keys.iv_.size() == sizeof(crypto_info.iv));
+  memcpy(crypto_info.key, keys.key_.data(), sizeof(crypto_info.key));
+  memcpy(crypto_info.salt, keys.salt_.data(), sizeof(crypto_info.salt));
+  memcpy(crypto_info.iv, keys.iv_.data(), sizeof(crypto_info.iv));
+  for (size_t i = 0; i < sizeof(crypto_info.rec_seq); i++) {
+    crypto_info.rec_seq[i] = static_cast<uint8_t>(sequence >> (8 * (7 - i)));
+  }
+
+  // Attaching the TLS upper layer protocol on its own leaves the socket working as before, so a
+  // failure to install the keys after it still leaves the connection usable.
+  static constexpr char Ulp[] = "tls";
+  Api::SysCallIntResult result = io_handle.setOption(IPPROTO_TCP, TCP_ULP, Ulp, sizeof(Ulp));
+  if (result.return_value_ == 0) {
+    result = io_handle.setOption(SOL_TLS, TLS_TX, &crypto_info, sizeof(crypto_info));
+  }
+  OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+  if (result.return_value_ != 0) {
+    return absl::UnavailableError(
+        absl::StrCat("kernel rejected the keys: ", errorDetails(result.errno_)));
+  }
+  return absl::OkStatus();
+}
+
+#endif
+
+} // namespace
+
+absl::Status enableTransmit(SSL* ssl, Network::IoHandle& io_handle) {
+#ifdef __linux__
+  const uint16_t ssl_version = SSL_version(ssl);
+  if (ssl_version != TLS1_2_VERSION && ssl_version != TLS1_3_VERSION) {
+    return absl::UnimplementedError(absl::StrCat("unsupported TLS version ", ssl_version));
+  }
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr) {
+    return absl::FailedPreconditionError("no cipher negotiated");
+  }
+  size_t key_length;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+  case NID_aes_128_gcm:
+    key_length = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+    break;
+  case NID_aes_256_gcm:
+    key_length = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+    break;
+  default:
+    return absl::UnimplementedError(
+        absl::StrCat("unsupported cipher ", SSL_CIPHER_get_name(cipher)));
+  }
+
+  TransmitKeys keys;
+  const absl::Status status = ssl_version == TLS1_2_VERSION
+                                  ? tls12TransmitKeys(ssl, key_length, keys)
+                                  : tls13TransmitKeys(ssl, cipher, key_length, keys);
+  if (!status.ok()) {
+    return status;
+  }
+  const uint16_t version = ssl_version == TLS1_2_VERSION ? TLS_1_2_VERSION : TLS_1_3_VERSION;
+  const uint64_t sequence = SSL_get_write_sequence(ssl);
+  if (key_length == TLS_CIPHER_AES_GCM_128_KEY_SIZE) {
+    return installTransmitKeys<tls12_crypto_info_aes_gcm_128>(
+        io_handle, version, TLS_CIPHER_AES_GCM_128, keys, sequence);
+  }
+  return installTransmitKeys<tls12_crypto_info_aes_gcm_256>(io_handle, version,
+                                                            TLS_CIPHER_AES_GCM_256, keys, sequence);
+#else
+  UNREFERENCED_PARAMETER(ssl);
+  UNREFERENCED_PARAMETER(io_handle);
+  return absl::UnimplementedError("kernel TLS is only supported on Linux");
+#endif
+}
+
+Api::SysCallSizeResult sendCloseNotify(Network::IoHandle& io_handle) {
+#ifdef __linux__
+  // The record type of what is written is passed in a control message. Without one, the kernel
+  // sends application data.
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(AlertRecordType))] = {};
+  iovec iov;
+  iov.iov_base = const_cast<uint8_t*>(CloseNotifyAlert);
+  iov.iov_len = sizeof(CloseNotifyAlert);
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(AlertRecordType));
+  *CMSG_DATA(cmsg) = AlertRecordType;
+  return Api::OsSysCallsSingleton::get().sendmsg(io_handle.fdDoNotUse(), &message, 0);
+#else
+  UNREFERENCED_PARAMETER(io_handle);
+  return {-1, SOCKET_ERROR_NOT_SUP};
+#endif
+}
+
+std::string writeKeysDigest(SSL* ssl) {
+  bssl::Span<const uint8_t> read_secret;
+  bssl::Span<const uint8_t> write_secret;
+  if (SSL_version(ssl) < TLS1_3_VERSION ||
+      !bssl::SSL_get_traffic_secrets(ssl, &read_secret, &write_secret)) {
+    return "";
+  }
+  // Only keep a digest, so that the secret itself does not outlive the TLS library's copy.
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  SHA256(write_secret.data(), write_secret.size(), digest);
+  return {reinterpret_cast<const char*>(digest), sizeof(digest)};
+}
+
+std::vector<uint8_t> hkdfExpandLabel(const EVP_MD* digest, absl::Span<const uint8_t> secret,
+                                     absl::string_view label, size_t length) {
+  // struct {
+  //   uint16 length;
+  //   opaque label<7..255> = "tls13 " + label;
+  //   opaque context<0..255>;
+  // } HkdfLabel;
+  const std::string full_label = absl::StrCat("tls13 ", label);
+  std::vector<uint8_t> info;
+  info.push_back(static_cast<uint8_t>(length >> 8));
+  info.push_back(static_cast<uint8_t>(length));
+  info.push_back(static_cast<uint8_t>(full_label.size()));
+  info.insert(info.end(), full_label.begin(), full_label.end());
+  info.push_back(0);
+
+  std::vector<uint8_t> out(length);
+  if (!HKDF_expand(out.data(), out.size(), digest, secret.data(), secret.size(), info.data(),
+                   info.size())) {
+    return {};
+  }
+  return out;
+}
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
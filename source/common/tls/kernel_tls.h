@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "envoy/api/os_sys_calls_common.h"
+#include "envoy/network/io_handle.h"
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+/**
+ * Hands the encryption of the records written by a connection over to the kernel (kTLS), by
+ * installing the keys negotiated in its completed handshake on the socket. Afterwards plaintext
+ * written to the socket goes out as TLS records continuing the write sequence of the handshake,
+ * and must not be passed to SSL_write(). Reading is unaffected, and still goes through the SSL
+ * object.
+ *
+ * Only TLS 1.2 and TLS 1.3 connections using AES-GCM can be offloaded, on Linux kernels with TLS
+ * support.
+ * @param ssl the connection, whose handshake has completed and whose writes have been flushed.
+ * @param io_handle the socket of the connection.
+ * @return absl::OkStatus() if the kernel now encrypts the writes of the connection, or the reason
+ *         it does not, in which case the connection is left as it was.
+ */
+absl::Status enableTransmit(SSL* ssl, Network::IoHandle& io_handle);
+
+/**
+ * Identifies the write keys the TLS library holds for a connection, so that a change the kernel
+ * does not follow can be noticed. The TLS library replaces the write keys of a TLS 1.3 connection
+ * when the peer requests a key update.
+ * @param ssl the connection, whose handshake has completed.
+ * @return a digest of the write traffic secret of a TLS 1.3 connection, or an empty string for
+ *         earlier versions, whose keys do not change after the handshake.
+ */
+std::string writeKeysDigest(SSL* ssl);
+
+/**
+ * Sends a close_notify alert on a socket whose writes are encrypted by the kernel.
+ * @param io_handle the socket.
+ * @return the result of the system call.
+ */
+Api::SysCallSizeResult sendCloseNotify(Network::IoHandle& io_handle);
+
+/**
+ * The TLS 1.3 HKDF-Expand-Label function of RFC 8446 section 7.1, with an empty context.
+ * Exposed for testing.
+ * @param digest the hash function of the cipher suite.
+ * @param secret the secret to expand.
+ * @param label the label, without the "tls13 " prefix.
+ * @param length the number of bytes to derive.
+ * @return the derived bytes, or an empty vector on failure.
+ */
+std::vector<uint8_t> hkdfExpandLabel(const EVP_MD* digest, absl::Span<const uint8_t> secret,
+                                     absl::string_view label, size_t length);
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
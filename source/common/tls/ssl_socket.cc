@@ -8,6 +8,7 @@
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/tls/io_handle_bio.h"
+#include "source/common/tls/kernel_tls.h"
 #include "source/common/tls/ssl_handshaker.h"
 #include "source/common/tls/utility.h"
 
@@ -166,6 +167,28 @@ Network::IoResult SslSocket::doRead(Buffer::Instance& read_buffer) {
     bytes_read += bytes_read_this_iteration;
   }
 
+  if (kernel_tls_tx_) {
+    // Records the TLS library produces while reading cannot be sent, as the kernel now owns the
+    // write sequence. They land in the memory BIO, or for the reply to a key update request stay
+    // queued in the library, which switches to write keys the kernel does not have. The alerts
+    // sent on errors come with errors that close the connection anyway. Anything else answers a
+    // request of the peer, so close the connection rather than leave the request unanswered.
+    BIO* wbio = SSL_get_wbio(rawSsl());
+    const size_t pending = BIO_pending(wbio);
+    if (pending > 0) {
+      ENVOY_CONN_LOG(debug, "dropping {} bytes written by the TLS library after kernel TLS offload",
+                     callbacks_->connection(), pending);
+      BIO_reset(wbio);
+    }
+    if (action == PostIoAction::KeepOpen &&
+        (pending > 0 || KernelTls::writeKeysDigest(rawSsl()) != kernel_tls_write_keys_)) {
+      ENVOY_CONN_LOG(debug, "TLS library has a record to send after kernel TLS offload",
+                     callbacks_->connection());
+      ctx_->stats().kernel_tls_tx_record_dropped_.inc();
+      action = PostIoAction::Close;
+    }
+  }
+
   ENVOY_CONN_LOG(trace, "ssl read {} bytes", callbacks_->connection(), bytes_read);
 
   return {action, bytes_read, end_stream};
@@ -200,9 +223,27 @@ void SslSocket::onSuccess(SSL* ssl) {
     callbacks_->connection().streamInfo().downstreamTiming().onDownstreamHandshakeComplete(
         callbacks_->connection().dispatcher().timeSource());
   }
+  if (ctx_->kernelTlsOffload()) {
+    enableKernelTls();
+  }
   callbacks_->raiseEvent(Network::ConnectionEvent::Connected);
 }
 
+void SslSocket::enableKernelTls() {
+  const absl::Status status = KernelTls::enableTransmit(rawSsl(), callbacks_->ioHandle());
+  if (!status.ok()) {
+    ENVOY_CONN_LOG(debug, "kernel TLS offload unavailable: {}", callbacks_->connection(),
+                   status.message());
+    ctx_->stats().kernel_tls_tx_unavailable_.inc();
+    return;
+  }
+  // The TLS library must not write to the socket any more, so catch what it writes in memory.
+  SSL_set_bio(rawSsl(), SSL_get_rbio(rawSsl()), BIO_new(BIO_s_mem()));
+  kernel_tls_tx_ = true;
+  kernel_tls_write_keys_ = KernelTls::writeKeysDigest(rawSsl());
+  ctx_->stats().kernel_tls_tx_offloaded_.inc();
+}
+
 void SslSocket::onFailure() { drainErrorQueue(); }
 
 PostIoAction SslSocket::doHandshake() { return info_->doHandshake(); }
@@ -262,6 +303,10 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     }
   }
 
+  if (kernel_tls_tx_) {
+    return doKernelTlsWrite(write_buffer, end_stream);
+  }
+
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
     bytes_to_write = bytes_to_retry_;
@@ -312,6 +357,37 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
   return {PostIoAction::KeepOpen, total_bytes_written, false};
 }
 
+Network::IoResult SslSocket::doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream) {
+  uint64_t total_bytes_written = 0;
+  uint64_t write_calls = 0;
+  PostIoAction action = PostIoAction::KeepOpen;
+  absl::optional<Api::IoError::IoErrorCode> err;
+  while (write_buffer.length() > 0) {
+    Api::IoCallUint64Result result = callbacks_->ioHandle().write(write_buffer);
+    write_calls++;
+    if (!result.ok()) {
+      ENVOY_CONN_LOG(trace, "kernel TLS write error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      if (result.err_->getErrorCode() != Api::IoError::IoErrorCode::Again) {
+        err = result.err_->getErrorCode();
+        action = PostIoAction::Close;
+      }
+      break;
+    }
+    ENVOY_CONN_LOG(trace, "kernel TLS write returns: {}", callbacks_->connection(),
+                   result.return_value_);
+    total_bytes_written += result.return_value_;
+  }
+
+  if (action == PostIoAction::KeepOpen && write_buffer.length() == 0 && end_stream) {
+    shutdownSsl();
+  }
+
+  Network::IoResult io_result{action, total_bytes_written, false, err};
+  io_result.write_calls_ = write_calls;
+  return io_result;
+}
+
 void SslSocket::onConnected() { ASSERT(info_->state() == Ssl::SocketState::PreHandshake); }
 
 Ssl::ConnectionInfoConstSharedPtr SslSocket::ssl() const { return info_; }
@@ -320,6 +396,20 @@ void SslSocket::shutdownSsl() {
   ASSERT(info_->state() != Ssl::SocketState::PreHandshake);
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
+    if (kernel_tls_tx_) {
+      // SSL_shutdown() would write the alert itself, so have the kernel send it instead.
+      const Api::SysCallSizeResult result = KernelTls::sendCloseNotify(callbacks_->ioHandle());
+      ENVOY_CONN_LOG(debug, "SSL shutdown through kernel TLS: rc={} errno={}",
+                     callbacks_->connection(), result.return_value_, result.errno_);
+      if (result.return_value_ < 0) {
+        // The socket may be full, and nothing calls back here once it drains. Shut down the write
+        // side instead, so the peer still sees the end of the stream if not the alert.
+        ctx_->stats().kernel_tls_tx_close_notify_failed_.inc();
+        callbacks_->ioHandle().shutdown(ENVOY_SHUT_WR);
+      }
+      info_->setState(Ssl::SocketState::ShutdownSent);
+      return;
+    }
     int rc = SSL_shutdown(rawSsl());
     if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
       // Windows operate under `EmulatedEdge`. These are level events that are artificially
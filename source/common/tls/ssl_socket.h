@@ -91,6 +91,9 @@ private:
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
 
   Network::PostIoAction doHandshake();
+  // Hands the encryption of writes over to the kernel, if the connection allows it.
+  void enableKernelTls();
+  Network::IoResult doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream);
   void drainErrorQueue();
   void shutdownSsl();
   void shutdownBasic();
@@ -101,6 +104,10 @@ private:
   ContextImplSharedPtr ctx_;
   uint64_t bytes_to_retry_{};
   std::string failure_reason_;
+  // Whether the kernel encrypts the writes of the connection, which then bypass the SSL object.
+  bool kernel_tls_tx_{false};
+  // The KernelTls::writeKeysDigest() of the keys handed to the kernel.
+  std::string kernel_tls_write_keys_;
 
   SslHandshakerImplSharedPtr info_;
 };
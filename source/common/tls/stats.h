@@ -21,7 +21,11 @@ namespace Tls {
   COUNTER(ocsp_staple_omitted)                                                                     \
   COUNTER(ocsp_staple_responses)                                                                   \
   COUNTER(ocsp_staple_requests)                                                                    \
-  COUNTER(was_key_usage_invalid)
+  COUNTER(was_key_usage_invalid)                                                                   \
+  COUNTER(kernel_tls_tx_offloaded)                                                                 \
+  COUNTER(kernel_tls_tx_unavailable)                                                               \
+  COUNTER(kernel_tls_tx_record_dropped)                                                            \
+  COUNTER(kernel_tls_tx_close_notify_failed)
 
 /**
  * Wrapper struct for SSL stats. @see stats_macros.h
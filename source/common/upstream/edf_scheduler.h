@@ -1,12 +1,16 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <queue>
+#include <vector>
 
 #include "envoy/upstream/scheduler.h"
 
 #include "source/common/common/assert.h"
 
+#include "absl/container/flat_hash_set.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -60,12 +64,56 @@ public:
     const double deadline = current_time_ + 1.0 / weight;
     EDF_TRACE("Insertion {} in queue with deadline {} and weight {}.",
               static_cast<const void*>(entry.get()), deadline, weight);
-    queue_.push({deadline, order_offset_++, entry});
+    queue_.push({deadline, weight, order_offset_++, entry});
     ASSERT(queue_.top().deadline_ >= current_time_);
   }
 
   bool empty() const override { return queue_.empty(); }
 
+  /**
+   * Updates the weights of the scheduled entries in place, without moving the schedule back to its
+   * start: an entry that has half of its current 1 / weight period left still has half of the new
+   * period left. This takes O(n) time and emulates no picks, so it is cheaper than creating a new
+   * scheduler when only the weights changed.
+   *
+   * @param entries the entries the scheduler is expected to hold.
+   * @param calculate_weight returns the new weight of an entry.
+   * @return false, leaving the scheduler unchanged, if it does not hold exactly the given entries.
+   */
+  bool updateWeights(const std::vector<std::shared_ptr<C>>& entries,
+                     std::function<double(const C&)> calculate_weight) {
+    std::vector<EdfEntry>& queue_entries = queue_.entries();
+    if (queue_entries.size() != entries.size()) {
+      return false;
+    }
+    absl::flat_hash_set<const C*> expected;
+    expected.reserve(entries.size());
+    for (const auto& entry : entries) {
+      expected.insert(entry.get());
+    }
+    // Entries that are still alive can be matched by address.
+    std::vector<double> weights;
+    weights.reserve(queue_entries.size());
+    for (const EdfEntry& edf_entry : queue_entries) {
+      const std::shared_ptr<C> entry = edf_entry.entry_.lock();
+      if (entry == nullptr || expected.erase(entry.get()) == 0) {
+        return false;
+      }
+      weights.push_back(calculate_weight(*entry));
+      ASSERT(weights.back() > 0);
+    }
+
+    for (size_t i = 0; i < queue_entries.size(); ++i) {
+      EdfEntry& edf_entry = queue_entries[i];
+      edf_entry.deadline_ =
+          current_time_ + (edf_entry.deadline_ - current_time_) * edf_entry.weight_ / weights[i];
+      edf_entry.weight_ = weights[i];
+    }
+    queue_.reheap();
+    EDF_TRACE("Updated the weights of {} entries in place.", queue_entries.size());
+    return true;
+  }
+
   // Creates an EdfScheduler with the given weights and their corresponding
   // entries, and emulating a number of initial picks to be performed. Note that
   // the internal state of the scheduler will be very similar to creating an empty
@@ -149,7 +197,7 @@ public:
       const double deadline = (floor_picks[i] + 1) / weight;
       EDF_TRACE("Insertion {} in queue with emualted {} picks, deadline {} and weight {}.",
                 static_cast<const void*>(entries[i].get()), floor_picks[i], deadline, weight);
-      scheduler_entries.emplace_back(EdfEntry{deadline, i, entries[i]});
+      scheduler_entries.emplace_back(EdfEntry{deadline, weight, i, entries[i]});
       max_pick_time = std::max(max_pick_time, pick_time);
       picks_so_far += floor_picks[i];
     }
@@ -198,6 +246,8 @@ private:
 
   struct EdfEntry {
     double deadline_;
+    // The weight the deadline was computed with.
+    double weight_;
     // Tie breaker for entries with the same deadline. This is used to provide FIFO behavior.
     uint64_t order_offset_;
     // We only hold a weak pointer, since we don't support a remove operator. This allows entries to
@@ -211,10 +261,22 @@ private:
     }
   };
 
+  // Min priority queue for EDF, with access to its entries so they can be updated in place.
+  class EdfQueue : public std::priority_queue<EdfEntry> {
+  public:
+    EdfQueue() = default;
+    EdfQueue(std::vector<EdfEntry>&& entries)
+        : std::priority_queue<EdfEntry>(std::less<EdfEntry>(), std::move(entries)) {}
+
+    std::vector<EdfEntry>& entries() { return this->c; }
+    // Restores the heap property after entries() were modified.
+    void reheap() { std::make_heap(this->c.begin(), this->c.end(), this->comp); }
+  };
+
   EdfScheduler(std::vector<EdfEntry>&& scheduler_entries, double current_time,
                uint32_t order_offset)
       : current_time_(current_time), order_offset_(order_offset),
-        queue_(scheduler_entries.cbegin(), scheduler_entries.cend()) {}
+        queue_(std::move(scheduler_entries)) {}
 
   // Current time in EDF scheduler.
   // TODO(htuch): Is it worth the small extra complexity to use integer time for performance
@@ -223,8 +285,7 @@ private:
   // Offset used during addition to break ties when entries have the same weight but should reflect
   // FIFO insertion order in picks.
   uint64_t order_offset_{};
-  // Min priority queue for EDF.
-  std::priority_queue<EdfEntry> queue_;
+  EdfQueue queue_;
   std::list<std::weak_ptr<C>> prepick_list_;
 };
 
@@ -262,6 +262,7 @@ DnsFilter::DnsFilter(Network::UdpReadFilterCallbacks& callbacks,
 }
 
 Network::FilterStatus DnsFilter::onData(Network::UdpRecvData& client_request) {
+  in_read_batch_ = true;
   config_->stats().downstream_rx_bytes_.recordValue(client_request.buffer_->length());
   config_->stats().downstream_rx_queries_.inc();
 
@@ -304,6 +305,9 @@ void DnsFilter::sendDnsResponse(DnsQueryContextPtr query_context) {
   Network::UdpSendData response_data{query_context->local_->ip(), *(query_context->peer_),
                                      response};
   listener_.send(response_data);
+  if (!in_read_batch_) {
+    listener_.flush();
+  }
 }
 
 DnsLookupResponseCode DnsFilter::getResponseForQuery(DnsQueryContextPtr& context) {
@@ -605,6 +609,11 @@ Network::FilterStatus DnsFilter::onReceiveError(Api::IoError::IoErrorCode error_
   return Network::FilterStatus::StopIteration;
 }
 
+void DnsFilter::onReadComplete() {
+  in_read_batch_ = false;
+  listener_.flush();
+}
+
 } // namespace DnsFilter
 } // namespace UdpFilters
 } // namespace Extensions
@@ -151,6 +151,7 @@ public:
   // Network::UdpListenerReadFilter callbacks
   Network::FilterStatus onData(Network::UdpRecvData& client_request) override;
   Network::FilterStatus onReceiveError(Api::IoError::IoErrorCode error_code) override;
+  void onReadComplete() override;
 
   /**
    * @return bool true if the domain_name is a known domain for which we respond to queries
@@ -379,6 +380,9 @@ private:
   Network::Address::InstanceConstSharedPtr local_;
   Network::Address::InstanceConstSharedPtr peer_;
   DnsFilterResolverCallback resolver_callback_;
+  // Set while a batch of datagrams is delivered. Responses sent meanwhile are flushed together by
+  // a batching listener writer once the batch is complete.
+  bool in_read_batch_{};
 };
 
 } // namespace DnsFilter
@@ -4,6 +4,7 @@
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/network/socket_option_factory.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -13,6 +14,8 @@ namespace UdpProxy {
 UdpProxyFilter::UdpProxyFilter(Network::UdpReadFilterCallbacks& callbacks,
                                const UdpProxyFilterConfigSharedPtr& config)
     : UdpListenerReadFilter(callbacks), config_(config),
+      batch_upstream_writes_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.udp_proxy_batch_upstream_writes")),
       cluster_update_callbacks_(
           config->clusterManager().addThreadLocalClusterUpdateCallbacks(*this)) {
   for (const auto& entry : config_->allClusterNames()) {
@@ -67,6 +70,7 @@ void UdpProxyFilter::onClusterRemoval(const std::string& cluster) {
 }
 
 Network::FilterStatus UdpProxyFilter::onData(Network::UdpRecvData& data) {
+  in_read_batch_ = batch_upstream_writes_;
   const std::string& route = config_->route(*data.addresses_.local_, *data.addresses_.peer_);
   if (!cluster_infos_.contains(route)) {
     config_->stats().downstream_sess_no_route_.inc();
@@ -76,6 +80,14 @@ Network::FilterStatus UdpProxyFilter::onData(Network::UdpRecvData& data) {
   return cluster_infos_[route]->onData(data);
 }
 
+void UdpProxyFilter::onReadComplete() {
+  in_read_batch_ = false;
+  for (UdpActiveSession* session : sessions_with_pending_datagrams_) {
+    session->flushPendingDatagrams();
+  }
+  sessions_with_pending_datagrams_.clear();
+}
+
 Network::FilterStatus UdpProxyFilter::onReceiveError(Api::IoError::IoErrorCode) {
   config_->stats().downstream_sess_rx_errors_.inc();
 
@@ -303,6 +315,15 @@ UdpProxyFilter::UdpActiveSession::UdpActiveSession(
     : ActiveSession(cluster, std::move(addresses), std::move(host)),
       use_original_src_ip_(cluster.filter_.config_->usingOriginalSrcIp()) {}
 
+UdpProxyFilter::UdpActiveSession::~UdpActiveSession() {
+  if (!pending_datagrams_.empty()) {
+    // Removed in the middle of a batch.
+    flushPendingDatagrams();
+    auto& sessions = cluster_.filter_.sessions_with_pending_datagrams_;
+    sessions.erase(std::find(sessions.begin(), sessions.end(), this));
+  }
+}
+
 UdpProxyFilter::ActiveSession::~ActiveSession() {
   ENVOY_BUG(on_session_complete_called_, "onSessionComplete() not called");
 }
@@ -495,14 +516,59 @@ void UdpProxyFilter::UdpActiveSession::writeUpstream(Network::UdpRecvData& data)
 
   ASSERT((connected_ || use_original_src_ip_) && udp_socket_ && host_);
 
-  const uint64_t tx_buffer_length = data.buffer_->length();
+  if (cluster_.filter_.in_read_batch_) {
+    // The rest of the batch may carry more datagrams for this session, so take over the datagram
+    // and send them all once the batch is complete.
+    if (pending_datagrams_.empty()) {
+      cluster_.filter_.sessions_with_pending_datagrams_.push_back(this);
+    }
+    pending_datagrams_.push_back(std::move(data.buffer_));
+    return;
+  }
+
+  writeDatagram(*data.buffer_);
+}
+
+void UdpProxyFilter::UdpActiveSession::flushPendingDatagrams() {
+  if (pending_datagrams_.size() == 1) {
+    writeDatagram(*pending_datagrams_.front());
+    pending_datagrams_.clear();
+    return;
+  }
+
+  if (batch_writer_ == nullptr) {
+    batch_writer_ = std::make_unique<Network::UdpBatchWriter>(udp_socket_->ioHandle());
+  }
+  const Network::Address::Ip* local_ip = use_original_src_ip_ ? addresses_.peer_->ip() : nullptr;
+  for (const Buffer::InstancePtr& buffer : pending_datagrams_) {
+    ENVOY_LOG(trace, "writing {} byte datagram upstream: downstream={} local={} upstream={}",
+              buffer->length(), addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
+              host_->address()->asStringView());
+    batch_writer_->writePacket(*buffer, local_ip, *host_->address());
+  }
+  batch_writer_->flush();
+
+  // Datagrams are sent in order and the ones after a failed send are dropped.
+  const uint64_t datagrams_sent = batch_writer_->lastFlushPacketsSent();
+  uint64_t tx_bytes = 0;
+  for (uint64_t i = 0; i < datagrams_sent; i++) {
+    tx_bytes += pending_datagrams_[i]->length();
+  }
+  cluster_.cluster_stats_.sess_tx_datagrams_.add(datagrams_sent);
+  cluster_.cluster_stats_.sess_tx_errors_.add(pending_datagrams_.size() - datagrams_sent);
+  cluster_.cluster_.info()->trafficStats()->upstream_cx_tx_bytes_total_.add(tx_bytes);
+  pending_datagrams_.clear();
+}
+
+void UdpProxyFilter::UdpActiveSession::writeDatagram(const Buffer::Instance& buffer) {
+  const uint64_t tx_buffer_length = buffer.length();
   ENVOY_LOG(trace, "writing {} byte datagram upstream: downstream={} local={} upstream={}",
             tx_buffer_length, addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
             host_->address()->asStringView());
 
   const Network::Address::Ip* local_ip = use_original_src_ip_ ? addresses_.peer_->ip() : nullptr;
-  Api::IoCallUint64Result rc = Network::Utility::writeToSocket(
-      udp_socket_->ioHandle(), *data.buffer_, local_ip, *host_->address());
+  Api::IoCallUint64Result rc = Network::Utility::writeToSocket(udp_socket_->ioHandle(), buffer,
+                                                               local_ip, *host_->address());
 
   if (!rc.ok()) {
     cluster_.cluster_stats_.sess_tx_errors_.inc();
@@ -561,6 +627,7 @@ bool UdpProxyFilter::UdpActiveSession::createUpstream() {
 void UdpProxyFilter::UdpActiveSession::createUdpSocket(const Upstream::HostConstSharedPtr& host) {
   // NOTE: The socket call can only fail due to memory/fd exhaustion. No local ephemeral port
   //       is bound until the first packet is sent to the upstream host.
+  batch_writer_.reset();
   udp_socket_ = cluster_.filter_.createUdpSocket(host);
   udp_socket_->ioHandle().initializeFileEvent(
       cluster_.filter_.read_callbacks_->udpListener().dispatcher(),
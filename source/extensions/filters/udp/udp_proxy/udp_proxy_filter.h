@@ -24,6 +24,7 @@
 #include "source/common/http/utility.h"
 #include "source/common/network/socket_impl.h"
 #include "source/common/network/socket_interface.h"
+#include "source/common/network/udp_batch_writer.h"
 #include "source/common/network/utility.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/header_parser.h"
@@ -471,10 +472,12 @@ public:
   // Network::UdpListenerReadFilter
   Network::FilterStatus onData(Network::UdpRecvData& data) override;
   Network::FilterStatus onReceiveError(Api::IoError::IoErrorCode error_code) override;
+  void onReadComplete() override;
 
 private:
   class ActiveSession;
   class ClusterInfo;
+  class UdpActiveSession;
 
   struct ActiveReadFilter : public virtual ReadFilterCallbacks, LinkedObject<ActiveReadFilter> {
     ActiveReadFilter(ActiveSession& parent, ReadFilterSharedPtr filter)
@@ -628,7 +631,10 @@ private:
   public:
     UdpActiveSession(ClusterInfo& parent, Network::UdpRecvData::LocalPeerAddresses&& addresses,
                      const Upstream::HostConstSharedPtr& host);
-    ~UdpActiveSession() override = default;
+    ~UdpActiveSession() override;
+
+    // Sends the datagrams held while a batch of downstream datagrams was delivered.
+    void flushPendingDatagrams();
 
     // ActiveSession
     bool createUpstream() override;
@@ -657,6 +663,7 @@ private:
   private:
     void onReadReady();
     void createUdpSocket(const Upstream::HostConstSharedPtr& host);
+    void writeDatagram(const Buffer::Instance& buffer);
 
     // The socket is used for writing packets to the selected upstream host as well as receiving
     // packets from the upstream host. Note that a a local ephemeral port is bound on the first
@@ -665,6 +672,11 @@ private:
     // The socket has been connected to avoid port exhaustion.
     bool connected_{};
     const bool use_original_src_ip_;
+    // Datagrams received during the current batch, sent by flushPendingDatagrams().
+    std::vector<Buffer::InstancePtr> pending_datagrams_;
+    // Sends the pending datagrams together when there is more than one of them. Created on first
+    // use for the current socket.
+    std::unique_ptr<Network::UdpBatchWriter> batch_writer_;
   };
 
   /**
@@ -868,6 +880,12 @@ private:
   void onClusterRemoval(const std::string& cluster_name) override;
 
   const UdpProxyFilterConfigSharedPtr config_;
+  // Whether datagrams for UDP upstreams are held by their session while a batch of downstream
+  // datagrams is delivered, and sent together once the batch is complete.
+  const bool batch_upstream_writes_;
+  bool in_read_batch_{};
+  // Declared ahead of cluster_infos_ since sessions remove themselves on destruction.
+  std::vector<UdpActiveSession*> sessions_with_pending_datagrams_;
   const Upstream::ClusterUpdateCallbacksHandlePtr cluster_update_callbacks_;
   // Map for looking up cluster info with its name.
   absl::flat_hash_map<std::string, ClusterInfoPtr> cluster_infos_;
@@ -1,11 +1,16 @@
 #include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
 
+#include <limits>
+
+#include "envoy/common/exception.h"
 #include "envoy/extensions/http/cache/simple_http_cache/v3/config.pb.h"
 #include "envoy/registry/registry.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/http/header_map_impl.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -135,8 +140,42 @@ private:
   bool committed_ = false;
   Http::ResponseTrailerMapPtr trailers_;
 };
+
+constexpr uint32_t DefaultShards = 16;
+
+uint64_t entrySizeBytes(const Key& key, const Http::ResponseHeaderMap& response_headers,
+                        const std::string& body, const Http::ResponseTrailerMap* trailers) {
+  return key.ByteSizeLong() + response_headers.byteSize() + body.size() +
+         (trailers != nullptr ? trailers->byteSize() : 0);
+}
+
 } // namespace
 
+SimpleHttpCache::Shard::Shard(Stats::Scope& scope, const std::string& prefix)
+    : clock_hand_(clock_.end()),
+      stats_({ALL_SIMPLE_HTTP_CACHE_STATS(POOL_COUNTER_PREFIX(scope, prefix),
+                                          POOL_GAUGE_PREFIX(scope, prefix))}) {}
+
+SimpleHttpCache::SimpleHttpCache(const ConfigProto& config, Stats::ScopeSharedPtr scope)
+    : scope_(std::move(scope)),
+      max_shard_size_bytes_(config.has_max_cache_size_bytes()
+                                ? config.max_cache_size_bytes().value() / shardCount(config)
+                                : std::numeric_limits<uint64_t>::max()) {
+  const uint32_t shards = shardCount(config);
+  shards_.reserve(shards);
+  for (uint32_t i = 0; i < shards; ++i) {
+    shards_.push_back(std::make_unique<Shard>(*scope_, absl::StrCat("shard_", i, ".")));
+  }
+}
+
+uint32_t SimpleHttpCache::shardCount(const ConfigProto& config) {
+  return config.shards() > 0 ? config.shards() : DefaultShards;
+}
+
+SimpleHttpCache::Shard& SimpleHttpCache::shardFor(const Key& key) const {
+  return *shards_[MessageUtil::hash(key) % shards_.size()];
+}
+
 LookupContextPtr SimpleHttpCache::makeLookupContext(LookupRequest&& request,
                                                     Http::StreamDecoderFilterCallbacks&) {
   return std::make_unique<SimpleLookupContext>(*this, std::move(request));
@@ -147,88 +186,144 @@ void SimpleHttpCache::updateHeaders(const LookupContext& lookup_context,
                                     const ResponseMetadata& metadata,
                                     std::function<void(bool)> on_complete) {
   const auto& simple_lookup_context = static_cast<const SimpleLookupContext&>(lookup_context);
-  const Key& key = simple_lookup_context.request().key();
-  absl::WriterMutexLock lock(&mutex_);
-  auto iter = map_.find(key);
-  if (iter == map_.end() || !iter->second.response_headers_) {
-    on_complete(false);
-    return;
-  }
-  if (VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
-    absl::optional<Key> varied_key =
-        variedRequestKey(simple_lookup_context.request(), *iter->second.response_headers_);
-    if (!varied_key.has_value()) {
+  Key key = simple_lookup_context.request().key();
+  {
+    Shard& shard = shardFor(key);
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    auto iter = shard.map_.find(key);
+    if (iter == shard.map_.end() || !iter->second.entry_.response_headers_) {
       on_complete(false);
       return;
     }
-    iter = map_.find(varied_key.value());
-    if (iter == map_.end() || !iter->second.response_headers_) {
-      on_complete(false);
-      return;
+    const Http::ResponseHeaderMap& cached_headers = *iter->second.entry_.response_headers_;
+    if (VaryHeaderUtils::hasVary(cached_headers)) {
+      absl::optional<Key> varied_key =
+          variedRequestKey(simple_lookup_context.request(), cached_headers);
+      if (!varied_key.has_value()) {
+        on_complete(false);
+        return;
+      }
+      key = std::move(varied_key.value());
     }
   }
-  Entry& entry = iter->second;
+
+  // The varied entry may live in a different shard from its vary marker.
+  Shard& shard = shardFor(key);
+  absl::WriterMutexLock lock(&shard.mutex_);
+  auto iter = shard.map_.find(key);
+  if (iter == shard.map_.end() || !iter->second.entry_.response_headers_) {
+    on_complete(false);
+    return;
+  }
+  StoredEntry& stored = iter->second;
+  Entry& entry = stored.entry_;
 
   applyHeaderUpdate(response_headers, *entry.response_headers_);
   entry.metadata_ = metadata;
+
+  const uint64_t size_bytes =
+      entrySizeBytes(iter->first, *entry.response_headers_, entry.body_, entry.trailers_.get());
+  shard.size_bytes_ = shard.size_bytes_ - stored.size_bytes_ + size_bytes;
+  shard.stats_.size_bytes_.set(shard.size_bytes_);
+  stored.size_bytes_ = size_bytes;
+  evictLocked(shard);
   on_complete(true);
 }
 
-SimpleHttpCache::Entry SimpleHttpCache::lookup(const LookupRequest& request) {
-  absl::ReaderMutexLock lock(&mutex_);
-  auto iter = map_.find(request.key());
-  if (iter == map_.end()) {
+SimpleHttpCache::Entry SimpleHttpCache::lookupKey(const Key& key) {
+  Shard& shard = shardFor(key);
+  absl::ReaderMutexLock lock(&shard.mutex_);
+  auto iter = shard.map_.find(key);
+  if (iter == shard.map_.end()) {
     return Entry{};
   }
-  ASSERT(iter->second.response_headers_);
-
-  if (VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
-    return varyLookup(request, iter->second.response_headers_);
-  } else {
-    Http::ResponseTrailerMapPtr trailers_map;
-    if (iter->second.trailers_) {
-      trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*iter->second.trailers_);
-    }
-    return SimpleHttpCache::Entry{
-        Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*iter->second.response_headers_),
-        iter->second.metadata_, iter->second.body_, std::move(trailers_map)};
+  const StoredEntry& stored = iter->second;
+  ASSERT(stored.entry_.response_headers_);
+  iter->second.referenced_.store(true, std::memory_order_relaxed);
+
+  Http::ResponseTrailerMapPtr trailers_map;
+  if (stored.entry_.trailers_) {
+    trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*stored.entry_.trailers_);
+  }
+  return SimpleHttpCache::Entry{
+      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*stored.entry_.response_headers_),
+      stored.entry_.metadata_, stored.entry_.body_, std::move(trailers_map)};
+}
+
+SimpleHttpCache::Entry SimpleHttpCache::lookup(const LookupRequest& request) {
+  Entry entry = lookupKey(request.key());
+  if (entry.response_headers_ && VaryHeaderUtils::hasVary(*entry.response_headers_)) {
+    return varyLookup(request, entry.response_headers_);
   }
+  return entry;
 }
 
 bool SimpleHttpCache::insert(const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
                              ResponseMetadata&& metadata, std::string&& body,
                              Http::ResponseTrailerMapPtr&& trailers) {
-  absl::WriterMutexLock lock(&mutex_);
-  map_[key] = SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
-                                     std::move(body), std::move(trailers)};
+  return insertEntry(key, SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
+                                                 std::move(body), std::move(trailers)});
+}
+
+bool SimpleHttpCache::insertEntry(const Key& key, Entry&& entry) {
+  ASSERT(entry.response_headers_);
+  Shard& shard = shardFor(key);
+  const uint64_t size_bytes =
+      entrySizeBytes(key, *entry.response_headers_, entry.body_, entry.trailers_.get());
+  if (size_bytes > max_shard_size_bytes_) {
+    shard.stats_.inserts_rejected_.inc();
+    return false;
+  }
+
+  absl::WriterMutexLock lock(&shard.mutex_);
+  auto [iter, inserted] = shard.map_.try_emplace(key);
+  StoredEntry& stored = iter->second;
+  if (inserted) {
+    stored.clock_position_ =
+        shard.clock_.insert(shard.clock_hand_, ClockSlot{&iter->first, &stored});
+    shard.stats_.entries_.inc();
+  }
+  shard.size_bytes_ = shard.size_bytes_ - stored.size_bytes_ + size_bytes;
+  shard.stats_.size_bytes_.set(shard.size_bytes_);
+  stored.entry_ = std::move(entry);
+  stored.size_bytes_ = size_bytes;
+  shard.stats_.inserts_.inc();
+  evictLocked(shard);
   return true;
 }
 
+void SimpleHttpCache::evictLocked(Shard& shard) {
+  while (shard.size_bytes_ > max_shard_size_bytes_) {
+    ASSERT(!shard.clock_.empty());
+    if (shard.clock_hand_ == shard.clock_.end()) {
+      shard.clock_hand_ = shard.clock_.begin();
+    }
+    StoredEntry& stored = *shard.clock_hand_->entry_;
+    if (stored.referenced_.exchange(false, std::memory_order_relaxed)) {
+      ++shard.clock_hand_;
+      continue;
+    }
+
+    // Erasing from the map invalidates the key the slot points at, so find the node first.
+    auto iter = shard.map_.find(*shard.clock_hand_->key_);
+    ASSERT(iter != shard.map_.end());
+    shard.clock_hand_ = shard.clock_.erase(shard.clock_hand_);
+    shard.size_bytes_ -= stored.size_bytes_;
+    shard.map_.erase(iter);
+    shard.stats_.evictions_.inc();
+    shard.stats_.entries_.dec();
+  }
+  shard.stats_.size_bytes_.set(shard.size_bytes_);
+}
+
 SimpleHttpCache::Entry
 SimpleHttpCache::varyLookup(const LookupRequest& request,
                             const Http::ResponseHeaderMapPtr& response_headers) {
-  // This method should be called from lookup, which holds the mutex for reading.
-  mutex_.AssertReaderHeld();
-
   absl::optional<Key> varied_key = variedRequestKey(request, *response_headers);
   if (!varied_key.has_value()) {
     return SimpleHttpCache::Entry{};
   }
-  Key& varied_request_key = varied_key.value();
-
-  auto iter = map_.find(varied_request_key);
-  if (iter == map_.end()) {
-    return SimpleHttpCache::Entry{};
-  }
-  ASSERT(iter->second.response_headers_);
-  Http::ResponseTrailerMapPtr trailers_map;
-  if (iter->second.trailers_) {
-    trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*iter->second.trailers_);
-  }
-
-  return SimpleHttpCache::Entry{
-      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*iter->second.response_headers_),
-      iter->second.metadata_, iter->second.body_, std::move(trailers_map)};
+  return lookupKey(varied_key.value());
 }
 
 bool SimpleHttpCache::varyInsert(const Key& request_key,
@@ -237,8 +332,6 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
                                  const Http::RequestHeaderMap& request_headers,
                                  const VaryAllowList& vary_allow_list,
                                  Http::ResponseTrailerMapPtr&& trailers) {
-  absl::WriterMutexLock lock(&mutex_);
-
   absl::btree_set<absl::string_view> vary_header_values =
       VaryHeaderUtils::getVaryValues(*response_headers);
   ASSERT(!vary_header_values.empty());
@@ -251,26 +344,37 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
     // Skip the insert if we are unable to create a vary key.
     return false;
   }
+  // The vary marker built below borrows the vary values from the response headers, so build it
+  // before they are moved into the cache.
+  Envoy::Http::ResponseHeaderMapPtr vary_only_map =
+      Envoy::Http::createHeaderMap<Envoy::Http::ResponseHeaderMapImpl>({});
+  vary_only_map->setCopy(Envoy::Http::CustomHeaders::get().Vary,
+                         absl::StrJoin(vary_header_values, ","));
 
   varied_request_key.add_custom_fields(vary_identifier.value());
-  map_[varied_request_key] = SimpleHttpCache::Entry{
-      std::move(response_headers), std::move(metadata), std::move(body), std::move(trailers)};
-
-  // Add a special entry to flag that this request generates varied responses.
-  auto iter = map_.find(request_key);
-  if (iter == map_.end()) {
-    Envoy::Http::ResponseHeaderMapPtr vary_only_map =
-        Envoy::Http::createHeaderMap<Envoy::Http::ResponseHeaderMapImpl>({});
-    vary_only_map->setCopy(Envoy::Http::CustomHeaders::get().Vary,
-                           absl::StrJoin(vary_header_values, ","));
-    // TODO(cbdm): In a cache that evicts entries, we could maintain a list of the "varykey"s that
-    // we have inserted as the body for this first lookup. This way, we would know which keys we
-    // have inserted for that resource. For the first entry simply use vary_identifier as the
-    // entry_list; for future entries append vary_identifier to existing list.
-    std::string entry_list;
-    map_[request_key] =
-        SimpleHttpCache::Entry{std::move(vary_only_map), {}, std::move(entry_list), {}};
+  if (!insertEntry(varied_request_key,
+                   SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
+                                          std::move(body), std::move(trailers)})) {
+    return false;
   }
+
+  // Add a special entry to flag that this request generates varied responses. The marker and the
+  // varied response may live in different shards, so a concurrent lookup can briefly see one
+  // without the other; either way it is treated as a miss.
+  {
+    Shard& shard = shardFor(request_key);
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    if (shard.map_.contains(request_key)) {
+      return true;
+    }
+  }
+  // TODO(cbdm): In a cache that evicts entries, we could maintain a list of the "varykey"s that
+  // we have inserted as the body for this first lookup. This way, we would know which keys we
+  // have inserted for that resource. For the first entry simply use vary_identifier as the
+  // entry_list; for future entries append vary_identifier to existing list.
+  std::string entry_list;
+  insertEntry(request_key,
+              SimpleHttpCache::Entry{std::move(vary_only_map), {}, std::move(entry_list), {}});
   return true;
 }
 
@@ -288,6 +392,36 @@ CacheInfo SimpleHttpCache::cacheInfo() const {
   return cache_info;
 }
 
+/**
+ * A singleton that hands out one SimpleHttpCache per distinct config, so filters configured
+ * identically share cached responses. Each cache keeps the singleton alive, and the singleton only
+ * holds weak references to the caches. The stats of each cache are prefixed with the hash of its
+ * config, so caches with different configs do not share them.
+ */
+class SimpleHttpCacheSingleton : public Singleton::Instance {
+public:
+  std::shared_ptr<SimpleHttpCache> get(std::shared_ptr<SimpleHttpCacheSingleton> singleton,
+                                       const SimpleHttpCache::ConfigProto& config,
+                                       Stats::Scope& scope) {
+    const uint64_t key = MessageUtil::hash(config);
+    absl::MutexLock lock(&mu_);
+    std::shared_ptr<SimpleHttpCache> cache = caches_[key].lock();
+    if (cache == nullptr) {
+      Stats::ScopeSharedPtr cache_scope = scope.createScope(
+          absl::StrCat("simple_http_cache.", absl::Hex(key, absl::kZeroPad16), "."));
+      cache = std::shared_ptr<SimpleHttpCache>(
+          new SimpleHttpCache(config, std::move(cache_scope)),
+          [singleton = std::move(singleton)](SimpleHttpCache* cache) { delete cache; });
+      caches_[key] = cache;
+    }
+    return cache;
+  }
+
+private:
+  absl::Mutex mu_;
+  absl::flat_hash_map<uint64_t, std::weak_ptr<SimpleHttpCache>> caches_ ABSL_GUARDED_BY(mu_);
+};
+
 SINGLETON_MANAGER_REGISTRATION(simple_http_cache_singleton);
 
 class SimpleHttpCacheFactory : public HttpCacheFactory {
@@ -296,20 +430,28 @@ public:
   std::string name() const override { return std::string(Name); }
   // From TypedFactory
   ProtobufTypes::MessagePtr createEmptyConfigProto() override {
-    return std::make_unique<
-        envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig>();
+    return std::make_unique<SimpleHttpCache::ConfigProto>();
   }
   // From HttpCacheFactory
   std::shared_ptr<HttpCache>
-  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig&,
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
            Server::Configuration::FactoryContext& context) override {
-    return context.serverFactoryContext().singletonManager().getTyped<SimpleHttpCache>(
-        SINGLETON_MANAGER_REGISTERED_NAME(simple_http_cache_singleton), &createCache);
-  }
-
-private:
-  static std::shared_ptr<Singleton::Instance> createCache() {
-    return std::make_shared<SimpleHttpCache>();
+    const auto config = MessageUtil::anyConvertAndValidate<SimpleHttpCache::ConfigProto>(
+        filter_config.typed_config(), context.messageValidationVisitor());
+    // Each shard gets an equal share of the budget, so a smaller budget would reject every insert.
+    if (config.has_max_cache_size_bytes() &&
+        config.max_cache_size_bytes().value() < SimpleHttpCache::shardCount(config)) {
+      throw EnvoyException(fmt::format(
+          "simple_http_cache: max_cache_size_bytes ({}) must be at least the number of shards ({})",
+          config.max_cache_size_bytes().value(), SimpleHttpCache::shardCount(config)));
+    }
+    std::shared_ptr<SimpleHttpCacheSingleton> caches =
+        context.serverFactoryContext().singletonManager().getTyped<SimpleHttpCacheSingleton>(
+            SINGLETON_MANAGER_REGISTERED_NAME(simple_http_cache_singleton),
+            [] { return std::make_shared<SimpleHttpCacheSingleton>(); });
+    // Caches are shared across listeners, so their stats live in the server scope rather than in
+    // the scope of whichever listener created them first.
+    return caches->get(caches, config, context.serverFactoryContext().scope());
   }
 };
 
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <atomic>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "envoy/extensions/http/cache/simple_http_cache/v3/config.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
 
 #include "absl/base/thread_annotations.h"
-#include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
 #include "absl/synchronization/mutex.h"
 
 namespace Envoy {
@@ -12,8 +21,27 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Cache {
 
-// Example cache backend that never evicts. Not suitable for production use.
-class SimpleHttpCache : public HttpCache, public Singleton::Instance {
+/**
+ * All stats for one shard of the simple http cache. @see stats_macros.h
+ */
+#define ALL_SIMPLE_HTTP_CACHE_STATS(COUNTER, GAUGE)                                                \
+  COUNTER(evictions)                                                                               \
+  COUNTER(inserts)                                                                                 \
+  COUNTER(inserts_rejected)                                                                        \
+  GAUGE(entries, NeverImport)                                                                      \
+  GAUGE(size_bytes, NeverImport)
+
+/**
+ * Struct definition for the stats of one shard of the simple http cache. @see stats_macros.h
+ */
+struct SimpleHttpCacheStats {
+  ALL_SIMPLE_HTTP_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+// In-memory cache backend. Entries are spread over independently locked shards by key hash, and
+// each shard evicts with the CLOCK algorithm once it exceeds its share of the configured byte
+// budget. Lookups only take a shard's lock for reading.
+class SimpleHttpCache : public HttpCache {
 private:
   struct Entry {
     Http::ResponseHeaderMapPtr response_headers_;
@@ -22,6 +50,43 @@ private:
     Http::ResponseTrailerMapPtr trailers_;
   };
 
+  struct StoredEntry;
+
+  // A position in a shard's clock. Both pointers are into the owning node_hash_map node, which is
+  // stable until the entry is erased.
+  struct ClockSlot {
+    const Key* key_;
+    StoredEntry* entry_;
+  };
+  using Clock = std::list<ClockSlot>;
+
+  struct StoredEntry {
+    Entry entry_;
+    uint64_t size_bytes_{};
+    Clock::iterator clock_position_;
+    // Set by lookups under the shared lock and cleared by the clock hand; an entry is only
+    // evicted when the hand finds it clear.
+    std::atomic<bool> referenced_{false};
+  };
+
+  struct Shard {
+    Shard(Stats::Scope& scope, const std::string& prefix);
+
+    absl::Mutex mutex_;
+    absl::node_hash_map<Key, StoredEntry, MessageUtil, MessageUtil> map_ ABSL_GUARDED_BY(mutex_);
+    // Every entry in map_, in insertion order. New entries are placed just behind the hand so they
+    // are the last to be considered for eviction.
+    Clock clock_ ABSL_GUARDED_BY(mutex_);
+    Clock::iterator clock_hand_ ABSL_GUARDED_BY(mutex_);
+    uint64_t size_bytes_ ABSL_GUARDED_BY(mutex_){};
+    SimpleHttpCacheStats stats_;
+  };
+
+  Shard& shardFor(const Key& key) const;
+  Entry lookupKey(const Key& key);
+  bool insertEntry(const Key& key, Entry&& entry);
+  void evictLocked(Shard& shard) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
   // Looks for a response that has been varied. Only called from lookup.
   Entry varyLookup(const LookupRequest& request,
                    const Http::ResponseHeaderMapPtr& response_headers);
@@ -33,6 +98,15 @@ private:
   static const absl::flat_hash_set<Http::LowerCaseString> headersNotToUpdate();
 
 public:
+  using ConfigProto = envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig;
+
+  // The shard stats are created in `scope`, which the cache keeps alive. Caches with different
+  // configs must not share a scope, since each shard sets its gauges to its own values.
+  SimpleHttpCache(const ConfigProto& config, Stats::ScopeSharedPtr scope);
+
+  // The number of shards a config splits the cache into.
+  static uint32_t shardCount(const ConfigProto& config);
+
   // HttpCache
   LookupContextPtr makeLookupContext(LookupRequest&& request,
                                      Http::StreamDecoderFilterCallbacks& callbacks) override;
@@ -55,8 +129,13 @@ public:
                   const Http::RequestHeaderMap& request_headers,
                   const VaryAllowList& vary_allow_list, Http::ResponseTrailerMapPtr&& trailers);
 
-  absl::Mutex mutex_;
-  absl::flat_hash_map<Key, Entry, MessageUtil, MessageUtil> map_ ABSL_GUARDED_BY(mutex_);
+  // The byte budget of a single shard.
+  uint64_t maxShardSizeBytes() const { return max_shard_size_bytes_; }
+
+private:
+  const Stats::ScopeSharedPtr scope_;
+  const uint64_t max_shard_size_bytes_;
+  std::vector<std::unique_ptr<Shard>> shards_;
 };
 
 } // namespace Cache
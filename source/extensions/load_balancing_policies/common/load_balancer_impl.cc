@@ -906,8 +906,10 @@ void EdfLoadBalancerBase::recalculateHostsInSlowStart(const HostVector& hosts) {
 
 void EdfLoadBalancerBase::refresh(uint32_t priority) {
   const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts) {
-    // Nuke existing scheduler if it exists.
-    auto& scheduler = scheduler_[source] = Scheduler{};
+    // Take the existing scheduler, if any, and nuke it.
+    auto& scheduler = scheduler_[source];
+    std::unique_ptr<EdfScheduler<Host>> previous_edf = std::move(scheduler.edf_);
+    scheduler = Scheduler{};
     refreshHostSource(source);
     if (isSlowStartEnabled()) {
       recalculateHostsInSlowStart(hosts);
@@ -931,6 +933,18 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
         return;
       }
 
+      // Every source of the priority is refreshed on any update to it, and weight changes are
+      // delivered as updates too. If this source still has the same hosts, keep its schedule and
+      // only update the weights.
+      if (previous_edf != nullptr &&
+          Runtime::runtimeFeatureEnabled(
+              "envoy.reloadable_features.edf_lb_update_weights_in_place") &&
+          previous_edf->updateWeights(hosts,
+                                      [this](const Host& host) { return hostWeight(host); })) {
+        scheduler.edf_ = std::move(previous_edf);
+        return;
+      }
+
       // Populate the scheduler with the host list with a randomized starting point.
       // TODO(mattklein123): We must build the EDF schedule even if all of the hosts are currently
       // weighted 1. This is because currently we don't refresh host sets if only weights change.
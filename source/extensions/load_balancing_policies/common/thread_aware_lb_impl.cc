@@ -3,6 +3,8 @@
 #include <memory>
 #include <random>
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -132,8 +134,9 @@ absl::Status ThreadAwareLoadBalancerBase::refresh() {
                                            normalized_host_weights, min_normalized_weight,
                                            max_normalized_weight, locality_weighted_balancing_);
     RETURN_IF_NOT_OK(status);
-    per_priority_state->current_lb_ = createLoadBalancer(
-        std::move(normalized_host_weights), min_normalized_weight, max_normalized_weight);
+    per_priority_state->current_lb_ =
+        createLoadBalancer(priority, std::move(normalized_host_weights), min_normalized_weight,
+                           max_normalized_weight);
   }
 
   {
@@ -258,10 +261,14 @@ ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost(uint64_t
   // next one in the ring. The random sequence is seeded by the hash, so the same input gets the
   // same sequence of hosts all the time.
   const uint32_t num_hosts = normalized_host_weights_.size();
-  auto host_index = std::vector<uint32_t>(num_hosts);
-  for (uint32_t i = 0; i < num_hosts; i++) {
-    host_index[i] = i;
-  }
+  // The shuffle is only carried out as far as the probe goes, so rather than materializing a
+  // permutation of all hosts, only the positions that have been swapped are recorded. Any other
+  // position still holds its own index.
+  absl::flat_hash_map<uint32_t, uint32_t> swapped_host_index;
+  auto host_index = [&swapped_host_index](uint32_t position) {
+    const auto it = swapped_host_index.find(position);
+    return it == swapped_host_index.end() ? position : it->second;
+  };
 
   // Not using Random::RandomGenerator as it does not take a seed. Seeded RNG is a requirement
   // here as we need the same shuffle sequence for the same hash every time.
@@ -282,11 +289,12 @@ ThreadAwareLoadBalancerBase::BoundedLoadHashingLoadBalancer::chooseHost(uint64_t
   HostConstSharedPtr alt_host, least_overloaded_host = host;
   double least_overload_factor = overload_factor;
   for (uint32_t i = 0; i < num_hosts; i++) {
-    // The random shuffle algorithm
+    // The random shuffle algorithm. Position i is not looked at again, so only position i + j
+    // needs to record the swap.
     const uint32_t j = uniform_int(random, num_hosts - i);
-    std::swap(host_index[i], host_index[i + j]);
+    const uint32_t k = host_index(i + j);
+    swapped_host_index[i + j] = host_index(i);
 
-    const uint32_t k = host_index[i];
     alt_host = normalized_host_weights_[k].first;
     if (alt_host == host) {
       continue;
@@ -70,12 +70,22 @@ LegacyMaglevLbConfig::LegacyMaglevLbConfig(const ClusterProto& cluster) {
 TypedMaglevLbConfig::TypedMaglevLbConfig(const MaglevLbProto& lb_config) : lb_config_(lb_config) {}
 
 ThreadAwareLoadBalancerBase::HashingLoadBalancerSharedPtr
-MaglevLoadBalancer::createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+MaglevLoadBalancer::createLoadBalancer(uint32_t priority,
+                                       const NormalizedHostWeightVector& normalized_host_weights,
                                        double /* min_normalized_weight */,
                                        double max_normalized_weight) {
-  HashingLoadBalancerSharedPtr maglev_lb =
-      MaglevFactory::createMaglevTable(normalized_host_weights, max_normalized_weight, table_size_,
-                                       use_hostname_for_hashing_, stats_);
+  if (tables_.size() <= priority) {
+    tables_.resize(priority + 1);
+  }
+  // Every priority is refreshed on any host update, so most of the time a priority's hosts are
+  // the same as when its table was last built.
+  MaglevTableSharedPtr& table = tables_[priority];
+  if (table == nullptr || !table->isBuiltFrom(normalized_host_weights, max_normalized_weight,
+                                              use_hostname_for_hashing_)) {
+    table = MaglevFactory::createMaglevTable(normalized_host_weights, max_normalized_weight,
+                                             table_size_, use_hostname_for_hashing_, stats_);
+  }
+  HashingLoadBalancerSharedPtr maglev_lb = table;
 
   if (hash_balance_factor_ == 0) {
     return maglev_lb;
@@ -85,19 +95,13 @@ MaglevLoadBalancer::createLoadBalancer(const NormalizedHostWeightVector& normali
       maglev_lb, std::move(normalized_host_weights), hash_balance_factor_);
 }
 
-void MaglevTable::constructMaglevTableInternal(
-    const NormalizedHostWeightVector& normalized_host_weights, double max_normalized_weight,
-    bool use_hostname_for_hashing) {
-  // We can't do anything sensible with no hosts.
-  if (normalized_host_weights.empty()) {
-    ENVOY_LOG(debug, "maglev: normalized hosts weights is empty, skipping building table");
-    return;
-  }
-
+MaglevTable::SortedHostWeights
+MaglevTable::sortHostWeights(const NormalizedHostWeightVector& normalized_host_weights,
+                             bool use_hostname_for_hashing) const {
   // Prepare stable (sorted) vector of host_weight.
   // Maglev requires stable order of table_build_entries because the hash table will be filled in
   // the order. Unstable table_build_entries results the change of backend assignment.
-  std::vector<std::tuple<absl::string_view, HostConstSharedPtr, double>> sorted_host_weights;
+  SortedHostWeights sorted_host_weights;
   sorted_host_weights.reserve(normalized_host_weights.size());
   for (const auto& host_weight : normalized_host_weights) {
     const auto& host = host_weight.first;
@@ -108,18 +112,55 @@ void MaglevTable::constructMaglevTableInternal(
   }
 
   std::sort(sorted_host_weights.begin(), sorted_host_weights.end());
+  return sorted_host_weights;
+}
+
+MaglevTable::HostPermutation
+MaglevTable::hostPermutation(const SortedHostWeights::value_type& host_weight) const {
+  const auto& key_to_hash = std::get<0>(host_weight);
+  return {std::get<1>(host_weight), HashUtil::xxHash64(key_to_hash) % table_size_,
+          (HashUtil::xxHash64(key_to_hash, 1) % (table_size_ - 1)) + 1, std::get<2>(host_weight)};
+}
+
+bool MaglevTable::isBuiltFrom(const NormalizedHostWeightVector& normalized_host_weights,
+                              double max_normalized_weight, bool use_hostname_for_hashing) const {
+  // The table only depends on the order hosts take turns in and on each host's permutation and
+  // weight. Holding on to the hosts makes comparing them by address safe.
+  if (max_normalized_weight != max_normalized_weight_ ||
+      normalized_host_weights.size() != host_permutations_.size()) {
+    return false;
+  }
+  const SortedHostWeights sorted_host_weights =
+      sortHostWeights(normalized_host_weights, use_hostname_for_hashing);
+  for (size_t i = 0; i < sorted_host_weights.size(); ++i) {
+    if (hostPermutation(sorted_host_weights[i]) != host_permutations_[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void MaglevTable::constructMaglevTableInternal(
+    const NormalizedHostWeightVector& normalized_host_weights, double max_normalized_weight,
+    bool use_hostname_for_hashing) {
+  max_normalized_weight_ = max_normalized_weight;
+
+  // We can't do anything sensible with no hosts.
+  if (normalized_host_weights.empty()) {
+    ENVOY_LOG(debug, "maglev: normalized hosts weights is empty, skipping building table");
+    return;
+  }
+
+  const SortedHostWeights sorted_host_weights =
+      sortHostWeights(normalized_host_weights, use_hostname_for_hashing);
 
   // Implementation of pseudocode listing 1 in the paper (see header file for more info).
   std::vector<TableBuildEntry> table_build_entries;
-  table_build_entries.reserve(normalized_host_weights.size());
+  table_build_entries.reserve(sorted_host_weights.size());
+  host_permutations_.reserve(sorted_host_weights.size());
   for (const auto& sorted_host_weight : sorted_host_weights) {
-    const auto& key_to_hash = std::get<0>(sorted_host_weight);
-    const auto& host = std::get<1>(sorted_host_weight);
-    const auto& weight = std::get<2>(sorted_host_weight);
-
-    table_build_entries.emplace_back(host, HashUtil::xxHash64(key_to_hash) % table_size_,
-                                     (HashUtil::xxHash64(key_to_hash, 1) % (table_size_ - 1)) + 1,
-                                     weight);
+    host_permutations_.push_back(hostPermutation(sorted_host_weight));
+    table_build_entries.emplace_back(host_permutations_.back());
   }
 
   constructImplementationInternals(table_build_entries, max_normalized_weight);
@@ -157,14 +198,12 @@ void OriginalMaglevTable::constructImplementationInternals(
         continue;
       }
       entry.target_weight_ += max_normalized_weight;
-      uint64_t c = permutation(entry);
+      uint64_t c = nextPosition(entry);
       while (table_[c] != nullptr) {
-        entry.next_++;
-        c = permutation(entry);
+        c = nextPosition(entry);
       }
 
       table_[c] = entry.host_;
-      entry.next_++;
       entry.count_++;
       table_index++;
     }
@@ -209,17 +248,15 @@ void CompactMaglevTable::constructImplementationInternals(
       entry.target_weight_ += max_normalized_weight;
       // As we're using the compact implementation, our table size is limited to
       // 32-bit, hence static_cast here should be safe.
-      uint32_t c = static_cast<uint32_t>(permutation(entry));
+      uint32_t c = static_cast<uint32_t>(nextPosition(entry));
       while (occupied[c]) {
-        entry.next_++;
-        c = static_cast<uint32_t>(permutation(entry));
+        c = static_cast<uint32_t>(nextPosition(entry));
       }
 
       // Record the index of the given host.
       table_.set(c, i);
       occupied[c] = true;
 
-      entry.next_++;
       entry.count_++;
       table_index++;
     }
@@ -282,10 +319,6 @@ HostConstSharedPtr CompactMaglevTable::chooseHost(uint64_t hash, uint32_t attemp
   return host_table_[index];
 }
 
-uint64_t MaglevTable::permutation(const TableBuildEntry& entry) {
-  return (entry.offset_ + (entry.skip_ * entry.next_)) % table_size_;
-}
-
 MaglevLoadBalancer::MaglevLoadBalancer(
     const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
     Runtime::Loader& runtime, Random::RandomGenerator& random,
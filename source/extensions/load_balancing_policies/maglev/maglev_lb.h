@@ -1,5 +1,8 @@
 #pragma once
 
+#include <tuple>
+#include <vector>
+
 #include "envoy/common/pure.h"
 #include "envoy/common/random_generator.h"
 #include "envoy/config/cluster/v3/cluster.pb.h"
@@ -80,21 +83,61 @@ public:
   static constexpr uint64_t DefaultTableSize = 65537;
   static constexpr uint64_t MaxNumberOfHostsForCompactMaglev = (static_cast<uint64_t>(1) << 32) - 1;
 
+  /**
+   * @return true if building a table from the given hosts and weights would give this same table,
+   *         so that it can be reused instead of being rebuilt.
+   */
+  bool isBuiltFrom(const NormalizedHostWeightVector& normalized_host_weights,
+                   double max_normalized_weight, bool use_hostname_for_hashing) const;
+
 protected:
+  // The order in which a host probes the table: offset_, offset_ + skip_, offset_ + 2 * skip_, ...
+  // modulo the table size. Hosts take turns in the order of their hash keys.
+  struct HostPermutation {
+    bool operator==(const HostPermutation& other) const = default;
+
+    HostConstSharedPtr host_;
+    uint64_t offset_;
+    uint64_t skip_;
+    double weight_;
+  };
+
   struct TableBuildEntry {
-    TableBuildEntry(const HostConstSharedPtr& host, uint64_t offset, uint64_t skip, double weight)
-        : host_(host), offset_(offset), skip_(skip), weight_(weight) {}
+    explicit TableBuildEntry(const HostPermutation& permutation)
+        : host_(permutation.host_), skip_(permutation.skip_), weight_(permutation.weight_),
+          position_(permutation.offset_) {}
 
     HostConstSharedPtr host_;
-    const uint64_t offset_;
     const uint64_t skip_;
     const double weight_;
     double target_weight_{};
-    uint64_t next_{};
+    // The next slot of the host's permutation.
+    uint64_t position_;
     uint64_t count_{};
   };
 
-  uint64_t permutation(const TableBuildEntry& entry);
+  using SortedHostWeights = std::vector<std::tuple<absl::string_view, HostConstSharedPtr, double>>;
+
+  /**
+   * @return the hosts with their hash keys and weights, in the order they fill the table.
+   */
+  SortedHostWeights sortHostWeights(const NormalizedHostWeightVector& normalized_host_weights,
+                                    bool use_hostname_for_hashing) const;
+  HostPermutation hostPermutation(const SortedHostWeights::value_type& host_weight) const;
+
+  /**
+   * Returns the slot the entry's permutation is at and moves it on to the next one. Stepping by
+   * skip_ visits the same slots as computing (offset + skip * i) % table_size_ for each i, without
+   * a division per probe.
+   */
+  uint64_t nextPosition(TableBuildEntry& entry) const {
+    const uint64_t position = entry.position_;
+    entry.position_ += entry.skip_;
+    if (entry.position_ >= table_size_) {
+      entry.position_ -= table_size_;
+    }
+    return position;
+  }
 
   /**
    * Template method for constructing the Maglev table.
@@ -106,6 +149,10 @@ protected:
   MaglevLoadBalancerStats& stats_;
 
 private:
+  // What the table was built from, see isBuiltFrom().
+  double max_normalized_weight_{};
+  std::vector<HostPermutation> host_permutations_;
+
   /**
    * Implementation specific construction of data structures to represent the
    * Maglev Table.
@@ -194,7 +241,7 @@ public:
 private:
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
                      double /* min_normalized_weight */, double max_normalized_weight) override;
   static MaglevLoadBalancerStats generateStats(Stats::Scope& scope);
 
@@ -203,6 +250,9 @@ private:
   const uint64_t table_size_;
   const bool use_hostname_for_hashing_;
   const uint32_t hash_balance_factor_;
+  // The last table built for each priority. Rebuilding a priority whose hosts and weights did not
+  // change reuses its table.
+  std::vector<MaglevTableSharedPtr> tables_;
 };
 
 } // namespace Upstream
@@ -1,7 +1,10 @@
 #include "source/extensions/load_balancing_policies/ring_hash/ring_hash_lb.h"
 
+#include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -89,60 +92,58 @@ RingHashLoadBalancerStats RingHashLoadBalancer::generateStats(Stats::Scope& scop
   return {ALL_RING_HASH_LOAD_BALANCER_STATS(POOL_GAUGE(scope))};
 }
 
+uint64_t RingHashLoadBalancer::Ring::findEntry(uint64_t hash) const {
+  // The bucket's end is the first entry of the next bucket, whose hash is larger than any hash in
+  // this one, so searching up to and including it always finds the answer unless it wraps around.
+  // This picks the same entry as the ketama binary search this replaced
+  // (https://github.com/RJ/ketama/blob/master/libketama/ketama.c, ketama_get_server).
+  const uint64_t bucket = hash >> bucket_shift_;
+  const auto it = std::lower_bound(
+      ring_.begin() + bucket_start_[bucket], ring_.begin() + bucket_start_[bucket + 1], hash,
+      [](const RingEntry& entry, uint64_t hash) { return entry.hash_ < hash; });
+  return it == ring_.end() ? 0 : it - ring_.begin();
+}
+
 HostConstSharedPtr RingHashLoadBalancer::Ring::chooseHost(uint64_t h, uint32_t attempt) const {
   if (ring_.empty()) {
     return nullptr;
   }
 
-  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c (ketama_get_server)
-  // I've generally kept the variable names to make the code easier to compare.
-  // NOTE: The algorithm depends on using signed integers for lowp, midp, and highp. Do not
-  //       change them!
-  int64_t lowp = 0;
-  int64_t highp = ring_.size();
-  int64_t midp = 0;
-  while (true) {
-    midp = (lowp + highp) / 2;
-
-    if (midp == static_cast<int64_t>(ring_.size())) {
-      midp = 0;
-      break;
-    }
-
-    uint64_t midval = ring_[midp].hash_;
-    uint64_t midval1 = midp == 0 ? 0 : ring_[midp - 1].hash_;
-
-    if (h <= midval && h > midval1) {
-      break;
-    }
-
-    if (midval < h) {
-      lowp = midp + 1;
-    } else {
-      highp = midp - 1;
-    }
-
-    if (lowp > highp) {
-      midp = 0;
-      break;
-    }
-  }
+  uint64_t index = findEntry(h);
 
   // If a retry host predicate is being applied, behave as if this host was not in the ring.
   // Note that this does not guarantee a different host: e.g., attempt == ring_.size() or
   // when the offset causes us to select the same host at another location in the ring.
   if (attempt > 0) {
-    midp = (midp + attempt) % ring_.size();
+    index = (index + attempt) % ring_.size();
   }
 
-  return ring_[midp].host_;
+  return ring_[index].host_;
+}
+
+void RingHashLoadBalancer::Ring::buildIndex() {
+  // Aim for about four entries per bucket, with at least two buckets.
+  const uint32_t bucket_bits =
+      std::max<uint32_t>(1, std::bit_width(static_cast<uint64_t>(ring_.size() / 4)));
+  bucket_shift_ = 64 - bucket_bits;
+  const uint64_t num_buckets = uint64_t(1) << bucket_bits;
+  bucket_start_.resize(num_buckets + 1);
+  uint64_t entry = 0;
+  for (uint64_t bucket = 0; bucket < num_buckets; ++bucket) {
+    while (entry < ring_.size() && (ring_[entry].hash_ >> bucket_shift_) < bucket) {
+      ++entry;
+    }
+    bucket_start_[bucket] = entry;
+  }
+  bucket_start_[num_buckets] = ring_.size();
 }
 
 using HashFunction = envoy::config::cluster::v3::Cluster::RingHashLbConfig::HashFunction;
 RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_host_weights,
                                  double min_normalized_weight, uint64_t min_ring_size,
                                  uint64_t max_ring_size, HashFunction hash_function,
-                                 bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats)
+                                 bool use_hostname_for_hashing, const Ring* previous,
+                                 RingHashLoadBalancerStats& stats)
     : stats_(stats) {
   ENVOY_LOG(trace, "ring hash: building ring");
 
@@ -160,11 +161,9 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
       std::min(std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
                static_cast<double>(max_ring_size));
 
-  // Reserve memory for the entire ring up front.
   const uint64_t ring_size = std::ceil(scale);
-  ring_.reserve(ring_size);
 
-  // Populate the hash ring by walking through the (host, weight) pairs in
+  // Work out the number of hashes each host gets by walking through the (host, weight) pairs in
   // normalized_host_weights, and generating (scale * weight) hashes for each host. Since these
   // aren't necessarily whole numbers, we maintain running sums -- current_hashes and
   // target_hashes -- which allows us to populate the ring in a mostly stable way.
@@ -181,28 +180,34 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
   // For stats reporting, keep track of the minimum and maximum actual number of hashes per host.
   // Users should hopefully pay attention to these numbers and alert if min_hashes_per_host is too
   // low, since that implies an inaccurate request distribution.
-
-  absl::InlinedVector<char, 196> hash_key_buffer;
   double current_hashes = 0.0;
   double target_hashes = 0.0;
   uint64_t min_hashes_per_host = ring_size;
   uint64_t max_hashes_per_host = 0;
+  std::vector<uint64_t> hashes_per_host;
+  hashes_per_host.reserve(normalized_host_weights.size());
   for (const auto& entry : normalized_host_weights) {
-    const auto& host = entry.first;
-    const absl::string_view key_to_hash = hashKey(host, use_hostname_for_hashing);
-    ASSERT(!key_to_hash.empty());
-
-    hash_key_buffer.assign(key_to_hash.begin(), key_to_hash.end());
-    hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
-
-    // As noted above: maintain current_hashes and target_hashes as running sums across the entire
-    // host set. `i` is needed only to construct the hash key, and tally min/max hashes per host.
     target_hashes += scale * entry.second;
     uint64_t i = 0;
     while (current_hashes < target_hashes) {
+      ++i;
+      ++current_hashes;
+    }
+    hashes_per_host.push_back(i);
+    min_hashes_per_host = std::min(i, min_hashes_per_host);
+    max_hashes_per_host = std::max(i, max_hashes_per_host);
+  }
+
+  // Hash i of a host is the hash of "<hash key>_<i>".
+  absl::InlinedVector<char, 196> hash_key_buffer;
+  auto generate_hashes = [&](absl::string_view key_to_hash, uint64_t begin, uint64_t end,
+                             const std::function<void(uint64_t)>& on_hash) {
+    hash_key_buffer.assign(key_to_hash.begin(), key_to_hash.end());
+    hash_key_buffer.emplace_back('_');
+    const size_t offset = hash_key_buffer.size();
+    for (uint64_t i = begin; i < end; ++i) {
       const std::string i_str = absl::StrCat("", i);
-      hash_key_buffer.insert(offset_start, i_str.begin(), i_str.end());
+      hash_key_buffer.insert(hash_key_buffer.begin() + offset, i_str.begin(), i_str.end());
 
       absl::string_view hash_key(static_cast<char*>(hash_key_buffer.data()),
                                  hash_key_buffer.size());
@@ -213,18 +218,83 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
               : HashUtil::xxHash64(hash_key);
 
       ENVOY_LOG(trace, "ring hash: hash_key={} hash={}", hash_key, hash);
-      ring_.push_back({hash, host});
-      ++i;
-      ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
+      on_hash(hash);
+      hash_key_buffer.erase(hash_key_buffer.begin() + offset, hash_key_buffer.end());
     }
-    min_hashes_per_host = std::min(i, min_hashes_per_host);
-    max_hashes_per_host = std::max(i, max_hashes_per_host);
+  };
+  auto ring_entry_less = [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
+    return lhs.hash_ < rhs.hash_;
+  };
+
+  if (previous == nullptr || previous->ring_.empty()) {
+    // Reserve memory for the entire ring up front.
+    ring_.reserve(ring_size);
+    for (size_t i = 0; i < normalized_host_weights.size(); ++i) {
+      const auto& host = normalized_host_weights[i].first;
+      const absl::string_view key_to_hash = hashKey(host, use_hostname_for_hashing);
+      ASSERT(!key_to_hash.empty());
+      generate_hashes(key_to_hash, 0, hashes_per_host[i],
+                      [this, &host](uint64_t hash) { ring_.push_back({hash, host}); });
+      if (hashes_per_host[i] > 0) {
+        host_hashes_[host.get()] = {std::string(key_to_hash), hashes_per_host[i]};
+      }
+    }
+    std::sort(ring_.begin(), ring_.end(), ring_entry_less);
+  } else {
+    // Compare each host's hashes with what it had on the previous ring. Hosts that kept their key
+    // keep the entries they already have, up to the new count.
+    std::vector<RingEntry> added;
+    // Previous ring entries to drop, for hosts that now get fewer hashes.
+    absl::flat_hash_map<std::pair<const Host*, uint64_t>, uint32_t> dropped;
+    // Hosts whose entries on the previous ring may be kept.
+    absl::flat_hash_map<const Host*, bool> kept_hosts;
+    for (size_t i = 0; i < normalized_host_weights.size(); ++i) {
+      const auto& host = normalized_host_weights[i].first;
+      const absl::string_view key_to_hash = hashKey(host, use_hostname_for_hashing);
+      ASSERT(!key_to_hash.empty());
+      uint64_t previous_count = 0;
+      const auto it = previous->host_hashes_.find(host.get());
+      if (it != previous->host_hashes_.end() && it->second.hash_key_ == key_to_hash) {
+        previous_count = it->second.count_;
+        kept_hosts[host.get()] = true;
+      }
+      const uint64_t count = hashes_per_host[i];
+      generate_hashes(key_to_hash, previous_count, count,
+                      [&added, &host](uint64_t hash) { added.push_back({hash, host}); });
+      generate_hashes(key_to_hash, count, previous_count, [&dropped, &host](uint64_t hash) {
+        ++dropped[std::make_pair(host.get(), hash)];
+      });
+      if (count > 0) {
+        host_hashes_[host.get()] = {std::string(key_to_hash), count};
+      }
+    }
+
+    std::vector<RingEntry> kept;
+    kept.reserve(previous->ring_.size());
+    for (const RingEntry& entry : previous->ring_) {
+      if (!kept_hosts.contains(entry.host_.get())) {
+        continue;
+      }
+      if (!dropped.empty()) {
+        const auto it = dropped.find(std::make_pair(entry.host_.get(), entry.hash_));
+        if (it != dropped.end()) {
+          if (--it->second == 0) {
+            dropped.erase(it);
+          }
+          continue;
+        }
+      }
+      kept.push_back(entry);
+    }
+
+    std::sort(added.begin(), added.end(), ring_entry_less);
+    ring_.reserve(kept.size() + added.size());
+    std::merge(kept.begin(), kept.end(), added.begin(), added.end(), std::back_inserter(ring_),
+               ring_entry_less);
   }
 
-  std::sort(ring_.begin(), ring_.end(), [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
-    return lhs.hash_ < rhs.hash_;
-  });
+  buildIndex();
+
   if (ENVOY_LOG_CHECK_LEVEL(trace)) {
     for (const auto& entry : ring_) {
       const absl::string_view key_to_hash = hashKey(entry.host_, use_hostname_for_hashing);
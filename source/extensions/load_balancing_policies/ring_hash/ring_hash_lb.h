@@ -13,6 +13,8 @@
 #include "source/common/common/logger.h"
 #include "source/extensions/load_balancing_policies/common/thread_aware_lb_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -94,15 +96,36 @@ private:
     HostConstSharedPtr host_;
   };
 
+  // The hashes a host was given on a ring. Hash i of a host is always derived from the same key, so
+  // a host keeping its key between rings keeps the hashes it had and only gains or loses some at
+  // the end.
+  struct HostHashes {
+    std::string hash_key_;
+    uint64_t count_;
+  };
+
   struct Ring : public HashingLoadBalancer {
+    // If previous is set, the ring is built by patching it: entries of hosts that are gone or were
+    // given fewer hashes are dropped and only the new entries are hashed and merged in. This gives
+    // the same ring as building from scratch, in linear time.
     Ring(const NormalizedHostWeightVector& normalized_host_weights, double min_normalized_weight,
          uint64_t min_ring_size, uint64_t max_ring_size, HashFunction hash_function,
-         bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats);
+         bool use_hostname_for_hashing, const Ring* previous, RingHashLoadBalancerStats& stats);
 
     // ThreadAwareLoadBalancerBase::HashingLoadBalancer
     HostConstSharedPtr chooseHost(uint64_t hash, uint32_t attempt) const override;
 
+    // Returns the index of the first entry with a hash >= hash, wrapping around to 0.
+    uint64_t findEntry(uint64_t hash) const;
+    void buildIndex();
+
     std::vector<RingEntry> ring_;
+    // A jump table over ring_ keyed by the top bits of the hash: the entries whose hash starts with
+    // b are ring_[bucket_start_[b], bucket_start_[b + 1]). There are about four entries per bucket,
+    // so a lookup is one table read and a search over a few adjacent entries.
+    std::vector<uint32_t> bucket_start_;
+    uint32_t bucket_shift_{63};
+    absl::flat_hash_map<const Host*, HostHashes> host_hashes_;
 
     RingHashLoadBalancerStats& stats_;
   };
@@ -110,11 +133,16 @@ private:
 
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
                      double min_normalized_weight, double /* max_normalized_weight */) override {
-    HashingLoadBalancerSharedPtr ring_hash_lb =
-        std::make_shared<Ring>(normalized_host_weights, min_normalized_weight, min_ring_size_,
-                               max_ring_size_, hash_function_, use_hostname_for_hashing_, stats_);
+    if (rings_.size() <= priority) {
+      rings_.resize(priority + 1);
+    }
+    auto ring = std::make_shared<Ring>(normalized_host_weights, min_normalized_weight,
+                                       min_ring_size_, max_ring_size_, hash_function_,
+                                       use_hostname_for_hashing_, rings_[priority].get(), stats_);
+    rings_[priority] = ring;
+    HashingLoadBalancerSharedPtr ring_hash_lb = std::move(ring);
     if (hash_balance_factor_ == 0) {
       return ring_hash_lb;
     }
@@ -135,6 +163,8 @@ private:
   const HashFunction hash_function_;
   const bool use_hostname_for_hashing_;
   const uint32_t hash_balance_factor_;
+  // The most recent ring built for each priority, from which the next one is built.
+  std::vector<RingConstSharedPtr> rings_;
 };
 
 } // namespace Upstream
@@ -8,6 +8,7 @@
 #include "source/common/config/utility.h"
 #include "source/common/grpc/async_client_impl.h"
 #include "source/common/network/resolver_impl.h"
+#include "source/common/stats/changed_metrics_sink.h"
 #include "source/extensions/stat_sinks/metrics_service/grpc_metrics_proto_descriptors.h"
 #include "source/extensions/stat_sinks/metrics_service/grpc_metrics_service_impl.h"
 
@@ -36,11 +37,13 @@ MetricsServiceSinkFactory::createStatsSink(const Protobuf::Message& config,
       grpc_metrics_streamer =
           std::make_shared<GrpcMetricsStreamerImpl>(client_or_error.value(), server.localInfo());
 
-  return std::make_unique<MetricsServiceSink<envoy::service::metrics::v3::StreamMetricsMessage,
-                                             envoy::service::metrics::v3::StreamMetricsResponse>>(
-      grpc_metrics_streamer,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, report_counters_as_deltas, false),
-      sink_config.emit_tags_as_labels(), sink_config.histogram_emit_mode());
+  return Stats::maybeChangedMetricsOnly(
+      std::make_unique<MetricsServiceSink<envoy::service::metrics::v3::StreamMetricsMessage,
+                                          envoy::service::metrics::v3::StreamMetricsResponse>>(
+          grpc_metrics_streamer,
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, report_counters_as_deltas, false),
+          sink_config.emit_tags_as_labels(), sink_config.histogram_emit_mode()),
+      sink_config.report_changed_metrics_only());
 }
 
 ProtobufTypes::MessagePtr MetricsServiceSinkFactory::createEmptyConfigProto() {
@@ -2,6 +2,8 @@
 
 #include "envoy/registry/registry.h"
 
+#include "source/common/stats/changed_metrics_sink.h"
+
 #include "source/extensions/stat_sinks/open_telemetry/open_telemetry_impl.h"
 #include "source/extensions/stat_sinks/open_telemetry/open_telemetry_proto_descriptors.h"
 
@@ -34,7 +36,9 @@ OpenTelemetrySinkFactory::createStatsSink(const Protobuf::Message& config,
         std::make_shared<OpenTelemetryGrpcMetricsExporterImpl>(otlp_options,
                                                                client_or_error.value());
 
-    return std::make_unique<OpenTelemetryGrpcSink>(otlp_metrics_flusher, grpc_metrics_exporter);
+    return Stats::maybeChangedMetricsOnly(
+        std::make_unique<OpenTelemetryGrpcSink>(otlp_metrics_flusher, grpc_metrics_exporter),
+        sink_config.report_changed_metrics_only());
   }
 
   default:
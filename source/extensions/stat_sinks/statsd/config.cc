@@ -7,6 +7,7 @@
 #include "envoy/registry/registry.h"
 
 #include "source/common/network/resolver_impl.h"
+#include "source/common/stats/changed_metrics_sink.h"
 #include "source/extensions/stat_sinks/common/statsd/statsd.h"
 
 namespace Envoy {
@@ -27,14 +28,18 @@ StatsdSinkFactory::createStatsSink(const Protobuf::Message& config,
     THROW_IF_STATUS_NOT_OK(address_or_error, throw);
     Network::Address::InstanceConstSharedPtr address = address_or_error.value();
     ENVOY_LOG(debug, "statsd UDP ip address: {}", address->asString());
-    return std::make_unique<Common::Statsd::UdpStatsdSink>(server.threadLocal(), std::move(address),
-                                                           false, statsd_sink.prefix());
+    return Stats::maybeChangedMetricsOnly(
+        std::make_unique<Common::Statsd::UdpStatsdSink>(server.threadLocal(), std::move(address),
+                                                        false, statsd_sink.prefix()),
+        statsd_sink.report_changed_metrics_only());
   }
   case envoy::config::metrics::v3::StatsdSink::StatsdSpecifierCase::kTcpClusterName:
     ENVOY_LOG(debug, "statsd TCP cluster: {}", statsd_sink.tcp_cluster_name());
-    return std::make_unique<Common::Statsd::TcpStatsdSink>(
-        server.localInfo(), statsd_sink.tcp_cluster_name(), server.threadLocal(),
-        server.clusterManager(), server.scope(), statsd_sink.prefix());
+    return Stats::maybeChangedMetricsOnly(
+        std::make_unique<Common::Statsd::TcpStatsdSink>(
+            server.localInfo(), statsd_sink.tcp_cluster_name(), server.threadLocal(),
+            server.clusterManager(), server.scope(), statsd_sink.prefix()),
+        statsd_sink.report_changed_metrics_only());
   case envoy::config::metrics::v3::StatsdSink::StatsdSpecifierCase::STATSD_SPECIFIER_NOT_SET:
     break; // Fall through to PANIC
   }
@@ -6,6 +6,8 @@
 
 #ifdef ENVOY_ENABLE_QUIC
 #include "source/common/quic/udp_gso_batch_writer.h"
+#else
+#include "source/common/network/udp_batch_writer.h"
 #endif
 
 #if UDP_GSO_BATCH_WRITER_COMPILETIME_SUPPORT
@@ -21,7 +23,7 @@ public:
 #ifdef ENVOY_ENABLE_QUIC
     return std::make_unique<UdpGsoBatchWriterFactory>();
 #else
-    return {};
+    return std::make_unique<Network::UdpBatchWriterFactory>();
 #endif
   }
   ProtobufTypes::MessagePtr createEmptyConfigProto() override {
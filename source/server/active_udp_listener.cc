@@ -40,6 +40,7 @@ void ActiveUdpListenerBase::post(Network::UdpRecvData&& data) {
     Network::UdpListenerCallbacksOptRef listener = parent.getUdpListenerCallbacks(tag, *address);
     if (listener.has_value()) {
       listener->get().onDataWorker(std::move(data));
+      listener->get().onReadComplete();
     }
   });
 }
@@ -112,6 +113,12 @@ void ActiveRawUdpListener::onDataWorker(Network::UdpRecvData&& data) {
 
 void ActiveRawUdpListener::onReadReady() {}
 
+void ActiveRawUdpListener::onReadComplete() {
+  for (auto& read_filter : read_filters_) {
+    read_filter->onReadComplete();
+  }
+}
+
 void ActiveRawUdpListener::onWriteReady(const Network::Socket&) {
   // TODO(sumukhs): This is not used now. When write filters are implemented, this is a
   // trigger to invoke the on write ready API on the filters which is when they can write
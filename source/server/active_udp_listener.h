@@ -80,6 +80,7 @@ public:
 
   // Network::UdpListenerCallbacks
   void onReadReady() override;
+  void onReadComplete() override;
   void onWriteReady(const Network::Socket& socket) override;
   void onReceiveError(Api::IoError::IoErrorCode error_code) override;
   Network::UdpPacketWriter& udpPacketWriter() override { return *udp_packet_writer_; }
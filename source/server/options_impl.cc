@@ -134,6 +134,18 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   TCLAP::ValueArg<uint32_t> file_flush_interval_msec("", "file-flush-interval-msec",
                                                      "Interval for log flushing in msec", false,
                                                      10000, "uint32_t", cmd);
+  TCLAP::ValueArg<uint64_t> file_flush_max_buffered_bytes(
+      "", "file-flush-max-buffered-bytes",
+      "Maximum bytes buffered for each log file awaiting a flush, beyond which writes are dropped. "
+      "0 means no limit",
+      false, 0, "uint64_t", cmd);
+  TCLAP::SwitchArg file_flush_single_thread(
+      "", "file-flush-single-thread",
+      "Flush all log files from a single thread rather than a thread per file", cmd, false);
+  TCLAP::ValueArg<uint64_t> buffer_slice_cache_bytes_per_thread(
+      "", "buffer-slice-cache-bytes-per-thread",
+      "Maximum bytes of freed buffer slice storage each thread keeps for reuse. 0 disables reuse",
+      false, Buffer::SlicePool::DefaultMaxCachedBytesPerThread, "uint64_t", cmd);
   TCLAP::ValueArg<uint32_t> drain_time_s("", "drain-time-s",
                                          "Hot restart and LDS removal drain time in seconds", false,
                                          600, "uint32_t", cmd);
@@ -280,6 +292,9 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   service_node_ = service_node.getValue();
   service_zone_ = service_zone.getValue();
   file_flush_interval_msec_ = std::chrono::milliseconds(file_flush_interval_msec.getValue());
+  file_flush_max_buffered_bytes_ = file_flush_max_buffered_bytes.getValue();
+  file_flush_single_thread_ = file_flush_single_thread.getValue();
+  buffer_slice_cache_bytes_per_thread_ = buffer_slice_cache_bytes_per_thread.getValue();
   drain_time_ = std::chrono::seconds(drain_time_s.getValue());
   parent_shutdown_time_ = std::chrono::seconds(parent_shutdown_time_s.getValue());
   socket_path_ = socket_path.getValue();
@@ -420,6 +435,9 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   }
   command_line_options->mutable_file_flush_interval()->MergeFrom(
       Protobuf::util::TimeUtil::MillisecondsToDuration(fileFlushIntervalMsec().count()));
+  command_line_options->set_file_flush_max_buffered_bytes(fileFlushMaxBufferedBytes());
+  command_line_options->set_file_flush_single_thread(fileFlushSingleThread());
+  command_line_options->set_buffer_slice_cache_bytes_per_thread(bufferSliceCacheBytesPerThread());
 
   command_line_options->mutable_drain_time()->MergeFrom(
       Protobuf::util::TimeUtil::SecondsToDuration(drainTime().count()));
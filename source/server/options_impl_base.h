@@ -9,6 +9,7 @@
 #include "envoy/registry/registry.h"
 #include "envoy/server/options.h"
 
+#include "source/common/buffer/slice_pool.h"
 #include "source/common/common/logger.h"
 #include "source/common/config/well_known_names.h"
 
@@ -67,6 +68,15 @@ public:
   void setFileFlushIntervalMsec(std::chrono::milliseconds file_flush_interval_msec) {
     file_flush_interval_msec_ = file_flush_interval_msec;
   }
+  void setFileFlushMaxBufferedBytes(uint64_t file_flush_max_buffered_bytes) {
+    file_flush_max_buffered_bytes_ = file_flush_max_buffered_bytes;
+  }
+  void setFileFlushSingleThread(bool file_flush_single_thread) {
+    file_flush_single_thread_ = file_flush_single_thread;
+  }
+  void setBufferSliceCacheBytesPerThread(uint64_t buffer_slice_cache_bytes_per_thread) {
+    buffer_slice_cache_bytes_per_thread_ = buffer_slice_cache_bytes_per_thread;
+  }
   void setServiceClusterName(const std::string& service_cluster) {
     service_cluster_ = service_cluster;
   }
@@ -133,6 +143,11 @@ public:
   std::chrono::milliseconds fileFlushIntervalMsec() const override {
     return file_flush_interval_msec_;
   }
+  uint64_t fileFlushMaxBufferedBytes() const override { return file_flush_max_buffered_bytes_; }
+  bool fileFlushSingleThread() const override { return file_flush_single_thread_; }
+  uint64_t bufferSliceCacheBytesPerThread() const override {
+    return buffer_slice_cache_bytes_per_thread_;
+  }
   const std::string& serviceClusterName() const override { return service_cluster_; }
   const std::string& serviceNodeName() const override { return service_node_; }
   const std::string& serviceZone() const override { return service_zone_; }
@@ -196,6 +211,9 @@ private:
   std::string service_node_;
   std::string service_zone_;
   std::chrono::milliseconds file_flush_interval_msec_{10000};
+  uint64_t file_flush_max_buffered_bytes_{0};
+  bool file_flush_single_thread_{false};
+  uint64_t buffer_slice_cache_bytes_per_thread_{Buffer::SlicePool::DefaultMaxCachedBytesPerThread};
   std::chrono::seconds drain_time_{600};
   std::chrono::seconds parent_shutdown_time_{900};
   Server::DrainStrategy drain_strategy_{Server::DrainStrategy::Gradual};
@@ -134,12 +134,9 @@ Event::ScaledTimerType parseTimerType(
   }
 }
 
-Event::ScaledTimerTypeMap
-parseTimerMinimums(const ProtobufWkt::Any& typed_config,
-                   ProtobufMessage::ValidationVisitor& validation_visitor) {
+Event::ScaledTimerTypeMap parseTimerMinimums(
+    const envoy::config::overload::v3::ScaleTimersOverloadActionConfig& action_config) {
   using Config = envoy::config::overload::v3::ScaleTimersOverloadActionConfig;
-  const Config action_config =
-      MessageUtil::anyConvertAndValidate<Config>(typed_config, validation_visitor);
 
   Event::ScaledTimerTypeMap timer_map;
 
@@ -443,8 +440,13 @@ OverloadManagerImpl::OverloadManagerImpl(Event::Dispatcher& dispatcher, Stats::S
     }
 
     if (name == OverloadActionNames::get().ReduceTimeouts) {
-      timer_minimums_ = std::make_shared<const Event::ScaledTimerTypeMap>(
-          parseTimerMinimums(action.typed_config(), validation_visitor));
+      const auto action_config = MessageUtil::anyConvertAndValidate<
+          envoy::config::overload::v3::ScaleTimersOverloadActionConfig>(action.typed_config(),
+                                                                        validation_visitor);
+      timer_minimums_ =
+          std::make_shared<const Event::ScaledTimerTypeMap>(parseTimerMinimums(action_config));
+      timer_coalescing_window_ = std::chrono::milliseconds(
+          PROTOBUF_GET_MS_OR_DEFAULT(action_config, coalescing_window, 0));
     } else if (name == OverloadActionNames::get().ResetStreams) {
       if (!config.has_buffer_factory_config()) {
         throw EnvoyException(
@@ -584,7 +586,8 @@ LoadShedPoint* OverloadManagerImpl::getLoadShedPoint(absl::string_view point_nam
 Event::ScaledRangeTimerManagerPtr OverloadManagerImpl::createScaledRangeTimerManager(
     Event::Dispatcher& dispatcher,
     const Event::ScaledTimerTypeMapConstSharedPtr& timer_minimums) const {
-  return std::make_unique<Event::ScaledRangeTimerManagerImpl>(dispatcher, timer_minimums);
+  return std::make_unique<Event::ScaledRangeTimerManagerImpl>(dispatcher, timer_minimums,
+                                                              timer_coalescing_window_);
 }
 
 void OverloadManagerImpl::updateResourcePressure(const std::string& resource, double pressure,
@@ -223,6 +223,8 @@ private:
   absl::flat_hash_map<std::string, std::unique_ptr<LoadShedPointImpl>> loadshed_points_;
 
   Event::ScaledTimerTypeMapConstSharedPtr timer_minimums_;
+  // Zero unless the scaled timers are to be triggered in batches.
+  std::chrono::milliseconds timer_coalescing_window_{0};
 
   absl::flat_hash_map<NamedOverloadActionSymbolTable::Symbol, OverloadActionState>
       state_updates_to_flush_;
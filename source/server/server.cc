@@ -26,6 +26,7 @@
 
 #include "source/common/api/api_impl.h"
 #include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/slice_pool.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/mutex_tracer_impl.h"
 #include "source/common/common/utility.h"
@@ -95,7 +96,8 @@ InstanceBase::InstanceBase(Init::Manager& init_manager, const Options& options,
           watermark_factory)),
       dispatcher_(api_->allocateDispatcher("main_thread")),
       access_log_manager_(options.fileFlushIntervalMsec(), *api_, *dispatcher_, access_log_lock,
-                          store),
+                          store, options.fileFlushMaxBufferedBytes(),
+                          options.fileFlushSingleThread()),
       handler_(getHandler(*dispatcher_)), worker_factory_(thread_local_, *api_, hooks),
       mutex_tracer_(options.mutexTracingEnabled() ? &Envoy::MutexTracerImpl::getOrCreateTracer()
                                                   : nullptr),
@@ -176,10 +178,12 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
       [this](std::size_t size) {
         snapped_gauges_.reserve(size);
         gauges_.reserve(size);
+        gauges_changed_.reserve(size);
       },
       [this](Stats::Gauge& gauge) {
         snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
         gauges_.push_back(gauge);
+        gauges_changed_.push_back(gauge.latchChanged());
       });
 
   store.forEachSinkedHistogram(
@@ -214,6 +218,31 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
   snapshot_time_ = time_source.systemTime();
 }
 
+ChangedMetricSnapshotImpl::ChangedMetricSnapshotImpl(const MetricSnapshotImpl& snapshot)
+    : text_readouts_(snapshot.text_readouts_), host_gauges_(snapshot.host_gauges_),
+      snapshot_time_(snapshot.snapshot_time_) {
+  for (const CounterSnapshot& counter : snapshot.counters_) {
+    if (counter.delta_ > 0) {
+      counters_.push_back(counter);
+    }
+  }
+  for (size_t i = 0; i < snapshot.gauges_.size(); ++i) {
+    if (snapshot.gauges_changed_[i]) {
+      gauges_.push_back(snapshot.gauges_[i]);
+    }
+  }
+  for (const Stats::ParentHistogram& histogram : snapshot.histograms_) {
+    if (histogram.intervalStatistics().sampleCount() > 0) {
+      histograms_.push_back(histogram);
+    }
+  }
+  for (const Stats::PrimitiveCounterSnapshot& counter : snapshot.host_counters_) {
+    if (counter.delta() > 0) {
+      host_counters_.push_back(counter);
+    }
+  }
+}
+
 void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
                                        Upstream::ClusterManager& cm, TimeSource& time_source) {
   // Create a snapshot and flush to all sinks.
@@ -221,8 +250,17 @@ void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, S
   //       latches all counters on a periodic basis. The hot restart code assumes this is being
   //       done so this should not be removed.
   MetricSnapshotImpl snapshot(store, cm, time_source);
+  // Built on first use and shared by every sink that only wants changed metrics.
+  std::unique_ptr<ChangedMetricSnapshotImpl> changed_snapshot;
   for (const auto& sink : sinks) {
-    sink->flush(snapshot);
+    if (sink->changedMetricsOnly()) {
+      if (changed_snapshot == nullptr) {
+        changed_snapshot = std::make_unique<ChangedMetricSnapshotImpl>(snapshot);
+      }
+      sink->flush(*changed_snapshot);
+    } else {
+      sink->flush(snapshot);
+    }
   }
 }
 
@@ -276,6 +314,20 @@ void InstanceBase::updateServerStats() {
       enumToInt(Utility::serverState(initManager().state(), healthCheckFailed())));
   server_stats_->stats_recent_lookups_.set(
       stats_store_.symbolTable().getRecentLookups([](absl::string_view, uint64_t) {}));
+
+  // The slice pool keeps monotonic process wide totals; only add what is new since the last
+  // update.
+  const Buffer::SlicePool::Stats pool_stats = Buffer::SlicePool::stats();
+  auto sync_counter = [](Stats::Counter& counter, uint64_t total) {
+    if (total > counter.value()) {
+      counter.add(total - counter.value());
+    }
+  };
+  sync_counter(server_buffer_pool_stats_->overflow_frees_, pool_stats.overflow_frees_);
+  sync_counter(server_buffer_pool_stats_->pool_hits_, pool_stats.pool_hits_);
+  sync_counter(server_buffer_pool_stats_->pool_misses_, pool_stats.pool_misses_);
+  sync_counter(server_buffer_pool_stats_->recycled_, pool_stats.recycled_);
+  server_buffer_pool_stats_->cached_bytes_.set(pool_stats.cached_bytes_);
 }
 
 void InstanceBase::flushStatsInternal() {
@@ -436,6 +488,9 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
   // TLS always contains a valid main thread dispatcher when TLS is used.
   thread_local_.registerThread(*dispatcher_, true);
 
+  // The slice pool is process wide, so its per-thread limit is set before any worker starts.
+  Buffer::SlicePool::setMaxCachedBytesPerThread(options_.bufferSliceCacheBytesPerThread());
+
   // Handle configuration that needs to take place prior to the main configuration load.
   RETURN_IF_NOT_OK(InstanceUtil::loadBootstrapConfig(
       bootstrap_, options_, messageValidationContext().staticValidationVisitor(), *api_));
@@ -522,6 +577,11 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
               POOL_COUNTER_PREFIX(stats_store_, server_compilation_settings_stats_prefix),
               POOL_GAUGE_PREFIX(stats_store_, server_compilation_settings_stats_prefix),
               POOL_HISTOGRAM_PREFIX(stats_store_, server_compilation_settings_stats_prefix))});
+  const std::string server_buffer_pool_stats_prefix = "server.buffer_pool.";
+  server_buffer_pool_stats_ = std::make_unique<ServerBufferPoolStats>(
+      ServerBufferPoolStats{ALL_SERVER_BUFFER_POOL_STATS(
+          POOL_COUNTER_PREFIX(stats_store_, server_buffer_pool_stats_prefix),
+          POOL_GAUGE_PREFIX(stats_store_, server_buffer_pool_stats_prefix))});
   validation_context_.setCounters(server_stats_->static_unknown_fields_,
                                   server_stats_->dynamic_unknown_fields_,
                                   server_stats_->wip_protos_);
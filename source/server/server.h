@@ -97,6 +97,20 @@ struct ServerStats {
   ALL_SERVER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
+/**
+ * Buffer slice pool stats, mirrored from Buffer::SlicePool. @see stats_macros.h
+ */
+#define ALL_SERVER_BUFFER_POOL_STATS(COUNTER, GAUGE)                                               \
+  COUNTER(overflow_frees)                                                                          \
+  COUNTER(pool_hits)                                                                               \
+  COUNTER(pool_misses)                                                                             \
+  COUNTER(recycled)                                                                                \
+  GAUGE(cached_bytes, NeverImport)
+
+struct ServerBufferPoolStats {
+  ALL_SERVER_BUFFER_POOL_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
 /**
  * Interface for creating service components during boot.
  */
@@ -372,6 +386,7 @@ private:
   std::unique_ptr<ServerStats> server_stats_;
   std::unique_ptr<CompilationSettings::ServerCompilationSettingsStats>
       server_compilation_settings_stats_;
+  std::unique_ptr<ServerBufferPoolStats> server_buffer_pool_stats_;
   Assert::ActionRegistrationPtr assert_action_registration_;
   Assert::ActionRegistrationPtr envoy_bug_action_registration_;
   ThreadLocal::Instance& thread_local_;
@@ -467,10 +482,14 @@ public:
   SystemTime snapshotTime() const override { return snapshot_time_; }
 
 private:
+  friend class ChangedMetricSnapshotImpl;
+
   std::vector<Stats::CounterSharedPtr> snapped_counters_;
   std::vector<CounterSnapshot> counters_;
   std::vector<Stats::GaugeSharedPtr> snapped_gauges_;
   std::vector<std::reference_wrapper<const Stats::Gauge>> gauges_;
+  // Parallel to gauges_: whether each gauge was written to since the previous snapshot.
+  std::vector<bool> gauges_changed_;
   std::vector<Stats::ParentHistogramSharedPtr> snapped_histograms_;
   std::vector<std::reference_wrapper<const Stats::ParentHistogram>> histograms_;
   std::vector<Stats::TextReadoutSharedPtr> snapped_text_readouts_;
@@ -480,5 +499,39 @@ private:
   SystemTime snapshot_time_;
 };
 
+// A view of a MetricSnapshotImpl holding only the metrics that changed since the previous flush,
+// handed to sinks that request it via Stats::Sink::changedMetricsOnly(). The metrics are kept
+// alive by the underlying snapshot, which must outlive this one.
+class ChangedMetricSnapshotImpl : public Stats::MetricSnapshot {
+public:
+  explicit ChangedMetricSnapshotImpl(const MetricSnapshotImpl& snapshot);
+
+  // Stats::MetricSnapshot
+  const std::vector<CounterSnapshot>& counters() override { return counters_; }
+  const std::vector<std::reference_wrapper<const Stats::Gauge>>& gauges() override {
+    return gauges_;
+  };
+  const std::vector<std::reference_wrapper<const Stats::ParentHistogram>>& histograms() override {
+    return histograms_;
+  }
+  const std::vector<std::reference_wrapper<const Stats::TextReadout>>& textReadouts() override {
+    return text_readouts_;
+  }
+  const std::vector<Stats::PrimitiveCounterSnapshot>& hostCounters() override {
+    return host_counters_;
+  }
+  const std::vector<Stats::PrimitiveGaugeSnapshot>& hostGauges() override { return host_gauges_; }
+  SystemTime snapshotTime() const override { return snapshot_time_; }
+
+private:
+  std::vector<CounterSnapshot> counters_;
+  std::vector<std::reference_wrapper<const Stats::Gauge>> gauges_;
+  std::vector<std::reference_wrapper<const Stats::ParentHistogram>> histograms_;
+  const std::vector<std::reference_wrapper<const Stats::TextReadout>>& text_readouts_;
+  std::vector<Stats::PrimitiveCounterSnapshot> host_counters_;
+  const std::vector<Stats::PrimitiveGaugeSnapshot>& host_gauges_;
+  const SystemTime snapshot_time_;
+};
+
 } // namespace Server
 } // namespace Envoy
@@ -0,0 +1,118 @@
+// Measures the time workers spend writing to access log files shared by many of them. The files
+// are /dev/null, so that the flush threads' writes to disk do not slow the workers down.
+
+#include <vector>
+
+#include "source/common/access_log/access_log_manager_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/benchmark/main.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace AccessLog {
+
+// The argument is the number of threads writing at once.
+static void accessLogFileWrite(::benchmark::State& state) {
+  const uint32_t num_threads = state.range(0);
+  const uint32_t writes_per_thread = benchmark::skipExpensiveBenchmarks() ? 1000 : 100000;
+
+  Stats::IsolatedStoreImpl stats_store;
+  Api::ApiPtr api = Api::createApiForTest(stats_store);
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Thread::MutexBasicLockable lock;
+  AccessLogManagerImpl manager(std::chrono::milliseconds(10000), *api, *dispatcher, lock,
+                               stats_store);
+  AccessLogFileSharedPtr file =
+      manager
+          .createAccessLog(
+              Filesystem::FilePathAndType{Filesystem::DestinationType::File, "/dev/null"})
+          .value();
+  const std::string line = std::string(200, 'x') + "\n";
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    std::vector<Thread::ThreadPtr> threads;
+    for (uint32_t i = 0; i < num_threads; i++) {
+      threads.push_back(api->threadFactory().createThread([&]() {
+        for (uint32_t j = 0; j < writes_per_thread; j++) {
+          file->write(line);
+        }
+      }));
+    }
+    for (Thread::ThreadPtr& thread : threads) {
+      thread->join();
+    }
+  }
+  file->flush();
+
+  // The threads write at once, so the time a worker spends in each write is the time of an
+  // iteration divided by the writes of each thread.
+  state.counters["worker_ns_per_write"] = ::benchmark::Counter(
+      1e-9 * state.iterations() * writes_per_thread,
+      ::benchmark::Counter::kIsRate | ::benchmark::Counter::kInvert);
+  state.counters["writes_per_second"] = ::benchmark::Counter(
+      state.iterations() * num_threads * writes_per_thread, ::benchmark::Counter::kIsRate);
+}
+BENCHMARK(accessLogFileWrite)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Unit(::benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Arguments are 1 to flush all files from a single thread, and the number of files. Each of 16
+// threads writes to all of the files in turn.
+static void accessLogManyFilesWrite(::benchmark::State& state) {
+  const bool single_thread = state.range(0);
+  const uint32_t num_files = state.range(1);
+  constexpr uint32_t NumThreads = 16;
+  const uint32_t writes_per_thread = benchmark::skipExpensiveBenchmarks() ? 1000 : 100000;
+
+  Stats::IsolatedStoreImpl stats_store;
+  Api::ApiPtr api = Api::createApiForTest(stats_store);
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Thread::MutexBasicLockable lock;
+  AccessLogManagerImpl manager(std::chrono::milliseconds(10000), *api, *dispatcher, lock,
+                               stats_store, 0, single_thread);
+  // The manager keys files by path, so each is a distinct path to /dev/null.
+  std::vector<AccessLogFileSharedPtr> files;
+  for (uint32_t i = 0; i < num_files; i++) {
+    files.push_back(manager
+                        .createAccessLog(Filesystem::FilePathAndType{
+                            Filesystem::DestinationType::File,
+                            std::string(i + 1, '/') + "dev/null"})
+                        .value());
+  }
+  const std::string line = std::string(200, 'x') + "\n";
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    std::vector<Thread::ThreadPtr> threads;
+    for (uint32_t i = 0; i < NumThreads; i++) {
+      threads.push_back(api->threadFactory().createThread([&, i]() {
+        for (uint32_t j = 0; j < writes_per_thread; j++) {
+          files[(i + j) % num_files]->write(line);
+        }
+      }));
+    }
+    for (Thread::ThreadPtr& thread : threads) {
+      thread->join();
+    }
+  }
+  for (AccessLogFileSharedPtr& file : files) {
+    file->flush();
+  }
+
+  state.counters["writes_per_second"] = ::benchmark::Counter(
+      state.iterations() * NumThreads * writes_per_thread, ::benchmark::Counter::kIsRate);
+}
+BENCHMARK(accessLogManyFilesWrite)
+    ->ArgsProduct({{0, 1}, {10, 200}})
+    ->Unit(::benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace AccessLog
+} // namespace Envoy
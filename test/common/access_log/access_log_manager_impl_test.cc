@@ -11,6 +11,9 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -442,6 +445,201 @@ TEST_F(AccessLogManagerImplTest, BigDataChunkShouldBeFlushedWithoutTimer) {
   EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+TEST_F(AccessLogManagerImplTest, DropWritesBeyondMaxBufferedBytes) {
+  AccessLogManagerImpl access_log_manager(timeout_40ms_, api_, dispatcher_, lock_, store_, 8);
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  log_file->write("123456789");
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_dropped").value());
+  EXPECT_EQ(0UL, store_.counter("filesystem.write_buffered").value());
+
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(0, data.compare("12345678"));
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  log_file->write("12345678");
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_buffered").value());
+  log_file->flush();
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 1));
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_dropped").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+// Writes of each thread are flushed in order, whichever shard they are buffered in.
+TEST_F(AccessLogManagerImplTest, WritesFromManyThreads) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager_
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  // Writes to the file are serialized by the file lock.
+  std::string written;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&written](absl::string_view data) -> Api::IoCallSizeResult {
+        written.append(data.data(), data.size());
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  constexpr uint32_t NumThreads = AccessLogFileImpl::WRITE_SHARDS + 4;
+  constexpr uint32_t WritesPerThread = 1000;
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t i = 0; i < NumThreads; i++) {
+    threads.push_back(thread_factory_.createThread([&log_file, i]() {
+      for (uint32_t j = 0; j < WritesPerThread; j++) {
+        log_file->write(absl::StrCat(i, ":", j, "\n"));
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+  log_file->flush();
+
+  std::vector<uint32_t> next_write(NumThreads, 0);
+  for (absl::string_view line : absl::StrSplit(written, '\n', absl::SkipEmpty())) {
+    const std::vector<absl::string_view> fields = absl::StrSplit(line, ':');
+    uint32_t thread;
+    uint32_t write;
+    ASSERT_EQ(2, fields.size());
+    ASSERT_TRUE(absl::SimpleAtoi(fields[0], &thread) && absl::SimpleAtoi(fields[1], &write));
+    ASSERT_LT(thread, NumThreads);
+    EXPECT_EQ(next_write[thread]++, write);
+  }
+  EXPECT_THAT(next_write, testing::Each(WritesPerThread));
+  EXPECT_EQ(NumThreads * WritesPerThread, store_.counter("filesystem.write_buffered").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerImplTest, SingleFlushThread) {
+  AccessLogManagerImpl access_log_manager(timeout_40ms_, api_, dispatcher_, lock_, store_, 0,
+                                          true);
+  NiceMock<Event::MockTimer>* timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  Sequence sq;
+  EXPECT_CALL(*file_, open_(_))
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  // Small writes are only flushed once the timer fires.
+  log_file->write("test");
+  EXPECT_EQ(4UL, store_.gauge("filesystem.file.foo.queued_bytes",
+                              Stats::Gauge::ImportMode::NeverImport)
+                     .value());
+  EXPECT_EQ(0UL, file_->num_writes_);
+  EXPECT_CALL(*file_, write_(_))
+      .InSequence(sq)
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(0, data.compare("test"));
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  timer->invokeCallback();
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 1));
+  EXPECT_TRUE(waitForCounterEq("filesystem.file.foo.flushed", 1));
+  EXPECT_TRUE(waitForGaugeEq("filesystem.file.foo.queued_bytes", 0));
+
+  // Writes reaching the flush size are flushed without waiting for the timer.
+  EXPECT_CALL(*file_, write_(_))
+      .InSequence(sq)
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(std::string(1024 * 64 + 1, 'b'), data);
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  log_file->write(std::string(1024 * 64 + 1, 'b'));
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 2));
+  EXPECT_TRUE(waitForCounterEq("filesystem.file.foo.flushed", 2));
+
+  // A file with nothing buffered is not queued when the timer fires.
+  timer->invokeCallback();
+  EXPECT_EQ(2UL, store_.counter("filesystem.file.foo.flushed").value());
+
+  // Reopening is done by the flush thread too.
+  EXPECT_CALL(*file_, close_())
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*file_, open_(_))
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*file_, write_(_))
+      .InSequence(sq)
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(0, data.compare("reopened"));
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  EXPECT_CALL(*file_, close_())
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+
+  log_file->reopen();
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_opens_, 2));
+  EXPECT_TRUE(waitForCounterEq("filesystem.file.foo.flushed", 3));
+  log_file->write("reopened");
+  timer->invokeCallback();
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 3));
+  EXPECT_TRUE(waitForCounterEq("filesystem.file.foo.flushed", 4));
+}
+
+// Files of a manager with a single flush thread are flushed independently by it.
+TEST_F(AccessLogManagerImplTest, SingleFlushThreadManyFiles) {
+  AccessLogManagerImpl access_log_manager(timeout_40ms_, api_, dispatcher_, lock_, store_, 0,
+                                          true);
+  NiceMock<Event::MockTimer>* timer1 = new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file1 =
+      access_log_manager
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  NiceMock<Event::MockTimer>* timer2 = new NiceMock<Event::MockTimer>(&dispatcher_);
+  NiceMock<Filesystem::MockFile>* file2 = new NiceMock<Filesystem::MockFile>;
+  EXPECT_CALL(*file2, path()).WillRepeatedly(Return("bar.log"));
+  EXPECT_CALL(file_system_, createFile(testing::Matcher<const Envoy::Filesystem::FilePathAndType&>(
+                                Filesystem::FilePathAndType{Filesystem::DestinationType::File,
+                                                            "bar.log"})))
+      .WillOnce(Return(ByMove(std::unique_ptr<NiceMock<Filesystem::MockFile>>(file2))));
+  EXPECT_CALL(*file2, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file2 =
+      access_log_manager
+          .createAccessLog(
+              Filesystem::FilePathAndType{Filesystem::DestinationType::File, "bar.log"})
+          .value();
+
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(0, data.compare("foo"));
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  EXPECT_CALL(*file2, write_(_))
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(0, data.compare("bar"));
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  log_file1->write("foo");
+  log_file2->write("bar");
+  timer2->invokeCallback();
+  EXPECT_TRUE(file2->waitForEventCount(file2->num_writes_, 1));
+  EXPECT_TRUE(waitForCounterEq("filesystem.file.bar_log.flushed", 1));
+  EXPECT_EQ(0UL, file_->num_writes_);
+  EXPECT_EQ(0UL, store_.counter("filesystem.file.foo.flushed").value());
+
+  timer1->invokeCallback();
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 1));
+  EXPECT_TRUE(waitForCounterEq("filesystem.file.foo.flushed", 1));
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*file2, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
 
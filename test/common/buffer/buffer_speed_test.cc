@@ -2,6 +2,7 @@
 #include "envoy/http/stream_reset_handler.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_pool.h"
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/assert.h"
 
@@ -558,4 +559,44 @@ BENCHMARK(bufferAddVsAddFragments)
     ->Args({1, 1, 64, 5})
     ->Args({1, 1, 4096, 5});
 
+// Test the slice allocation churn of a read/write loop with and without the per-thread slice
+// pool. The first argument is the payload size per iteration, the second is 1 if the slice pool
+// is enabled. The difference between the two is the time spent in the heap allocator.
+static void bufferSlicePoolChurn(benchmark::State& state) {
+  const std::string data(state.range(0), 'a');
+  const bool use_pool = (state.range(1) != 0);
+  const uint64_t saved_max = Buffer::SlicePool::maxCachedBytesPerThread();
+  Buffer::SlicePool::setMaxCachedBytesPerThread(
+      use_pool ? Buffer::SlicePool::DefaultMaxCachedBytesPerThread : 0);
+  Buffer::SlicePool::drainThreadCache();
+  const Buffer::SlicePool::Stats before = Buffer::SlicePool::stats();
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Buffer::OwnedImpl read_buffer;
+    Buffer::Reservation reservation = read_buffer.reserveForRead();
+    reservation.commit(std::min<uint64_t>(reservation.length(), data.size()));
+
+    Buffer::OwnedImpl write_buffer;
+    write_buffer.add(data);
+    write_buffer.move(read_buffer);
+    benchmark::DoNotOptimize(write_buffer.length());
+  }
+
+  Buffer::SlicePool::drainThreadCache();
+  const Buffer::SlicePool::Stats after = Buffer::SlicePool::stats();
+  state.counters["pool_hits"] = after.pool_hits_ - before.pool_hits_;
+  state.counters["pool_misses"] = after.pool_misses_ - before.pool_misses_;
+  Buffer::SlicePool::setMaxCachedBytesPerThread(saved_max);
+}
+BENCHMARK(bufferSlicePoolChurn)
+    ->Args({128, 0})
+    ->Args({128, 1})
+    ->Args({4096, 0})
+    ->Args({4096, 1})
+    ->Args({16384, 0})
+    ->Args({16384, 1})
+    ->Args({65536, 0})
+    ->Args({65536, 1});
+
 } // namespace Envoy
@@ -0,0 +1,205 @@
+#include <thread>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_pool.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+class SlicePoolTest : public testing::Test {
+protected:
+  SlicePoolTest() {
+    SlicePool::setMaxCachedBytesPerThread(SlicePool::DefaultMaxCachedBytesPerThread);
+    SlicePool::drainThreadCache();
+    baseline_ = SlicePool::stats();
+  }
+
+  ~SlicePoolTest() override {
+    SlicePool::setMaxCachedBytesPerThread(SlicePool::DefaultMaxCachedBytesPerThread);
+    SlicePool::drainThreadCache();
+  }
+
+  // Publishes this thread's pending counters by draining it, and returns the change since the
+  // start of the test.
+  SlicePool::Stats drainAndDelta() {
+    SlicePool::drainThreadCache();
+    const SlicePool::Stats now = SlicePool::stats();
+    SlicePool::Stats delta;
+    delta.pool_hits_ = now.pool_hits_ - baseline_.pool_hits_;
+    delta.pool_misses_ = now.pool_misses_ - baseline_.pool_misses_;
+    delta.recycled_ = now.recycled_ - baseline_.recycled_;
+    delta.overflow_frees_ = now.overflow_frees_ - baseline_.overflow_frees_;
+    delta.cached_bytes_ = now.cached_bytes_ - baseline_.cached_bytes_;
+    return delta;
+  }
+
+  SlicePool::Stats baseline_;
+};
+
+TEST_F(SlicePoolTest, RecyclesSameSizeClass) {
+  SlicePool::StoragePtr mem = SlicePool::allocate(8192);
+  uint8_t* raw = mem.get();
+  SlicePool::release(std::move(mem), 8192);
+
+  // A different size class does not pick up the cached block.
+  SlicePool::StoragePtr other = SlicePool::allocate(4096);
+  EXPECT_NE(raw, other.get());
+  SlicePool::release(std::move(other), 4096);
+
+  SlicePool::StoragePtr again = SlicePool::allocate(8192);
+  EXPECT_EQ(raw, again.get());
+  SlicePool::release(std::move(again), 8192);
+
+  const SlicePool::Stats delta = drainAndDelta();
+  EXPECT_EQ(1, delta.pool_hits_);
+  EXPECT_EQ(2, delta.pool_misses_);
+  EXPECT_EQ(3, delta.recycled_);
+  EXPECT_EQ(0, delta.overflow_frees_);
+  EXPECT_EQ(0, delta.cached_bytes_);
+}
+
+TEST_F(SlicePoolTest, LargeBlocksBypassPool) {
+  const uint64_t size = SlicePool::MaxPooledSize + SlicePool::PageSize;
+  SlicePool::StoragePtr mem = SlicePool::allocate(size);
+  ASSERT_NE(nullptr, mem);
+  SlicePool::release(std::move(mem), size);
+  SlicePool::release(nullptr, SlicePool::PageSize);
+
+  const SlicePool::Stats delta = drainAndDelta();
+  EXPECT_EQ(0, delta.pool_hits_);
+  EXPECT_EQ(0, delta.pool_misses_);
+  EXPECT_EQ(0, delta.recycled_);
+  EXPECT_EQ(0, delta.overflow_frees_);
+}
+
+TEST_F(SlicePoolTest, HighWaterMark) {
+  SlicePool::setMaxCachedBytesPerThread(2 * 16384);
+  EXPECT_EQ(2 * 16384, SlicePool::maxCachedBytesPerThread());
+
+  std::vector<SlicePool::StoragePtr> blocks;
+  for (int i = 0; i < 3; ++i) {
+    blocks.push_back(SlicePool::allocate(16384));
+  }
+  for (auto& block : blocks) {
+    SlicePool::release(std::move(block), 16384);
+  }
+
+  const SlicePool::Stats delta = drainAndDelta();
+  EXPECT_EQ(2, delta.recycled_);
+  EXPECT_EQ(1, delta.overflow_frees_);
+}
+
+TEST_F(SlicePoolTest, ZeroHighWaterMarkDisablesRecycling) {
+  SlicePool::setMaxCachedBytesPerThread(0);
+  SlicePool::release(SlicePool::allocate(4096), 4096);
+  SlicePool::release(SlicePool::allocate(4096), 4096);
+
+  const SlicePool::Stats delta = drainAndDelta();
+  EXPECT_EQ(0, delta.pool_hits_);
+  EXPECT_EQ(2, delta.pool_misses_);
+  EXPECT_EQ(0, delta.recycled_);
+  EXPECT_EQ(2, delta.overflow_frees_);
+}
+
+TEST_F(SlicePoolTest, CachedBytesPublished) {
+  SlicePool::release(SlicePool::allocate(4096), 4096);
+  SlicePool::release(SlicePool::allocate(65536), 65536);
+
+  // Stats are published in batches; force the cache to publish by pushing enough operations.
+  for (int i = 0; i < 1024; ++i) {
+    SlicePool::release(SlicePool::allocate(4096), 4096);
+  }
+  EXPECT_EQ(baseline_.cached_bytes_ + 4096 + 65536, SlicePool::stats().cached_bytes_);
+
+  EXPECT_EQ(0, drainAndDelta().cached_bytes_);
+}
+
+TEST_F(SlicePoolTest, ThreadsHaveSeparateCaches) {
+  SlicePool::StoragePtr mem = SlicePool::allocate(4096);
+  uint8_t* raw = mem.get();
+  SlicePool::release(std::move(mem), 4096);
+
+  std::thread thread([raw]() {
+    SlicePool::StoragePtr other = SlicePool::allocate(4096);
+    EXPECT_NE(raw, other.get());
+    SlicePool::release(std::move(other), 4096);
+  });
+  thread.join();
+
+  SlicePool::StoragePtr again = SlicePool::allocate(4096);
+  EXPECT_EQ(raw, again.get());
+  SlicePool::release(std::move(again), 4096);
+}
+
+// Storage released by a thread_local destroyed after the thread's cache goes to the heap.
+TEST_F(SlicePoolTest, ReleaseAfterThreadCacheDestroyed) {
+  struct SliceOwner {
+    ~SliceOwner() { SlicePool::release(std::move(mem_), 4096); }
+    SlicePool::StoragePtr mem_;
+  };
+
+  std::thread thread([]() {
+    // The owner is constructed before the cache, so it is destroyed after it.
+    static thread_local SliceOwner owner;
+    owner.mem_ = SlicePool::allocate(4096);
+  });
+  thread.join();
+
+  const SlicePool::Stats delta = drainAndDelta();
+  EXPECT_EQ(1, delta.pool_misses_);
+  EXPECT_EQ(0, delta.recycled_);
+  EXPECT_EQ(0, delta.overflow_frees_);
+  EXPECT_EQ(0, delta.cached_bytes_);
+}
+
+// Slices and reservations made through OwnedImpl return their storage to the pool.
+TEST_F(SlicePoolTest, OwnedImplUsesPool) {
+  {
+    OwnedImpl buffer;
+    buffer.add(std::string(100, 'a'));
+    auto reservation = buffer.reserveForRead();
+    reservation.commit(10);
+  }
+  {
+    OwnedImpl buffer;
+    buffer.add(std::string(100, 'a'));
+    auto reservation = buffer.reserveForRead();
+    reservation.commit(10);
+  }
+
+  const SlicePool::Stats delta = drainAndDelta();
+  EXPECT_GT(delta.pool_hits_, 0);
+  EXPECT_EQ(delta.pool_hits_ + delta.pool_misses_, delta.recycled_ + delta.overflow_frees_);
+}
+
+// Slices that are handed on after their drain trackers are called keep their storage, so the pool
+// must not give it to the next allocation.
+TEST_F(SlicePoolTest, ExtractedSliceKeepsStorage) {
+  OwnedImpl buffer;
+  buffer.add(std::string(100, 'a'));
+  SliceDataPtr extracted = buffer.extractMutableFrontSlice();
+
+  OwnedImpl other;
+  other.add(std::string(100, 'b'));
+  absl::Span<uint8_t> data = extracted->getMutableData();
+  EXPECT_EQ(std::string(100, 'a'), std::string(reinterpret_cast<const char*>(data.data()), 100));
+}
+
+TEST_F(SlicePoolTest, MovedSliceKeepsStorage) {
+  const std::string payload(16000, 'a');
+  OwnedImpl source;
+  source.add(payload);
+  OwnedImpl destination;
+  destination.move(source, source.length(), true);
+
+  OwnedImpl other;
+  other.add(std::string(16000, 'b'));
+  EXPECT_EQ(payload, destination.toString());
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
@@ -393,6 +393,30 @@ TEST_F(DispatcherImplTest, InitializeStats) {
   dispatcher_->initializeStats(scope_, "test.");
 }
 
+TEST_F(DispatcherImplTest, LoopLatency) {
+  EXPECT_EQ(std::chrono::microseconds(0), dispatcher_->loopLatency());
+  dispatcher_->post([this]() {
+    dispatcher_->initializeStats(scope_, "test.");
+    // Keep the next loop iteration busy and check the latency in the one after.
+    dispatcher_->post([this]() {
+      absl::SleepFor(absl::Milliseconds(10));
+      dispatcher_->post([this]() {
+        {
+          Thread::LockGuard lock(mu_);
+          work_finished_ = true;
+        }
+        cv_.notifyOne();
+      });
+    });
+  });
+
+  Thread::LockGuard lock(mu_);
+  while (!work_finished_) {
+    cv_.wait(mu_);
+  }
+  EXPECT_LT(std::chrono::microseconds(0), dispatcher_->loopLatency());
+}
+
 TEST_F(DispatcherImplTest, Post) {
   dispatcher_->post([this]() {
     {
@@ -678,6 +678,109 @@ TEST_F(ScaledRangeTimerManagerTest, MultipleTimersWithChangeInScalingFactor) {
               ElementsAre(start + std::chrono::seconds(9), start + std::chrono::seconds(16)));
 }
 
+TEST_F(ScaledRangeTimerManagerTest, CoalescedTimersTriggerTogether) {
+  ScaledRangeTimerManagerImpl manager(dispatcher_, nullptr, std::chrono::seconds(1));
+  // Simulated time starts on a multiple of the window.
+  const MonotonicTime start = simTime().monotonicTime();
+  std::vector<TrackedRangeTimer> timers;
+  timers.reserve(3);
+  for (int i = 0; i < 3; ++i) {
+    timers.emplace_back(AbsoluteMinimum(std::chrono::seconds(0)), manager, simTime());
+  }
+
+  // The durations are rounded up to 2s, 1s and 2s, so the timers expire at start+2, start+1.3 and
+  // start+2.3, and are triggered at the end of the window each expires in.
+  timers[0].timer->enableTimer(std::chrono::milliseconds(1500));
+  simTime().advanceTimeAndRun(std::chrono::milliseconds(300), dispatcher_,
+                              Dispatcher::RunType::Block);
+  timers[1].timer->enableTimer(std::chrono::milliseconds(1000));
+  timers[2].timer->enableTimer(std::chrono::milliseconds(2000));
+
+  for (int i = 0; i < 40; ++i) {
+    simTime().advanceTimeAndRun(std::chrono::milliseconds(100), dispatcher_,
+                                Dispatcher::RunType::Block);
+  }
+
+  EXPECT_THAT(*timers[0].trigger_times, ElementsAre(start + std::chrono::seconds(2)));
+  EXPECT_THAT(*timers[1].trigger_times, ElementsAre(start + std::chrono::seconds(2)));
+  EXPECT_THAT(*timers[2].trigger_times, ElementsAre(start + std::chrono::seconds(3)));
+}
+
+TEST_F(ScaledRangeTimerManagerTest, CoalescedTimersWithChangeInScalingFactor) {
+  ScaledRangeTimerManagerImpl manager(dispatcher_, nullptr, std::chrono::seconds(1));
+  const MonotonicTime start = simTime().monotonicTime();
+  std::vector<TrackedRangeTimer> timers;
+  timers.reserve(3);
+  for (int i = 0; i < 3; ++i) {
+    timers.emplace_back(AbsoluteMinimum(std::chrono::seconds(0)), manager, simTime());
+    timers[i].timer->enableTimer(std::chrono::seconds(10 * (i + 1)));
+  }
+
+  // Fire times are now 0: start+1, 1: start+2, 2: start+3.
+  manager.setScaleFactor(UnitFloat(0.1));
+  simTime().advanceTimeAndRun(std::chrono::seconds(1), dispatcher_, Dispatcher::RunType::Block);
+  simTime().advanceTimeAndRun(std::chrono::seconds(1), dispatcher_, Dispatcher::RunType::Block);
+  EXPECT_THAT(*timers[0].trigger_times, ElementsAre(start + std::chrono::seconds(1)));
+  EXPECT_THAT(*timers[1].trigger_times, ElementsAre(start + std::chrono::seconds(2)));
+
+  // With a scale factor of 0, timers[2] should be ready to be fired immediately.
+  manager.setScaleFactor(UnitFloat(0));
+  dispatcher_.run(Dispatcher::RunType::Block);
+  EXPECT_THAT(*timers[2].trigger_times, ElementsAre(start + std::chrono::seconds(2)));
+}
+
+TEST_F(ScaledRangeTimerManagerTest, CoalescedInCallbackDisableTimerInSameBatch) {
+  ScaledRangeTimerManagerImpl manager(dispatcher_, nullptr, std::chrono::milliseconds(100));
+
+  MockFunction<TimerCb> callback1;
+  auto timer1 =
+      manager.createTimer(AbsoluteMinimum(std::chrono::seconds(0)), callback1.AsStdFunction());
+  MockFunction<TimerCb> callback2;
+  auto timer2 =
+      manager.createTimer(AbsoluteMinimum(std::chrono::seconds(0)), callback2.AsStdFunction());
+
+  // The timers are in different queues, but expire in the same window.
+  timer1->enableTimer(std::chrono::milliseconds(10));
+  timer2->enableTimer(std::chrono::milliseconds(80));
+
+  EXPECT_CALL(callback1, Call).WillOnce(Invoke([&]() {
+    timer2->disableTimer();
+    timer2.reset();
+  }));
+
+  // Run the dispatcher to make sure nothing happens when it's not supposed to.
+  simTime().advanceTimeAndRun(std::chrono::seconds(1), dispatcher_, Dispatcher::RunType::Block);
+}
+
+TEST_F(ScaledRangeTimerManagerTest, CoalescedTimersTriggerWithinTwoWindows) {
+  const std::chrono::milliseconds window(250);
+  ScaledRangeTimerManagerImpl manager(dispatcher_, nullptr, window);
+  std::vector<TrackedRangeTimer> timers;
+  std::vector<MonotonicTime> deadlines;
+  timers.reserve(100);
+  for (int i = 0; i < 100; ++i) {
+    timers.emplace_back(AbsoluteMinimum(std::chrono::milliseconds(i * 7 % 500)), manager,
+                        simTime());
+    const std::chrono::milliseconds max(1000 + i * 37);
+    deadlines.push_back(simTime().monotonicTime() + max);
+    timers[i].timer->enableTimer(max);
+    simTime().advanceTimeAndRun(std::chrono::milliseconds(i % 13), dispatcher_,
+                                Dispatcher::RunType::Block);
+  }
+
+  for (int i = 0; i < 600; ++i) {
+    simTime().advanceTimeAndRun(std::chrono::milliseconds(10), dispatcher_,
+                                Dispatcher::RunType::Block);
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    SCOPED_TRACE(i);
+    ASSERT_EQ(timers[i].trigger_times->size(), 1);
+    EXPECT_GE(timers[i].trigger_times->front(), deadlines[i]);
+    EXPECT_LE(timers[i].trigger_times->front(), deadlines[i] + 2 * window);
+  }
+}
+
 TEST_F(ScaledRangeTimerManagerTest, LooksUpConfiguredMinimums) {
   // Test-only class that overrides one of the createScaledTimer overloads to show that the other
   // one calls into this one after looking up the minimum.
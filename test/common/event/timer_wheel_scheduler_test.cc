@@ -0,0 +1,332 @@
+#include <chrono>
+#include <vector>
+
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/event/scaled_range_timer_manager_impl.h"
+#include "source/common/event/timer_wheel_scheduler.h"
+
+#include "test/mocks/common.h"
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/test_random_generator.h"
+#include "test/test_common/test_time.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::InSequence;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+class ManualTimeSource : public TimeSource {
+public:
+  SystemTime systemTime() override { return SystemTime(monotonic_time_.time_since_epoch()); }
+  MonotonicTime monotonicTime() override { return monotonic_time_; }
+
+  MonotonicTime monotonic_time_;
+};
+
+// A timer of the base scheduler, which is run by the test.
+class BaseTimer : public Timer {
+public:
+  BaseTimer(const TimerCb& cb, ManualTimeSource& time_source)
+      : cb_(cb), time_source_(time_source) {}
+
+  // Timer
+  void disableTimer() override { enabled_ = false; }
+  void enableTimer(std::chrono::milliseconds duration, const ScopeTrackedObject*) override {
+    enableHRTimer(duration, nullptr);
+  }
+  void enableHRTimer(std::chrono::microseconds duration, const ScopeTrackedObject*) override {
+    enabled_ = true;
+    duration_ = duration;
+    deadline_ = time_source_.monotonic_time_ + duration;
+  }
+  bool enabled() override { return enabled_; }
+
+  const TimerCb cb_;
+  ManualTimeSource& time_source_;
+  bool enabled_{false};
+  std::chrono::microseconds duration_{};
+  MonotonicTime deadline_;
+};
+
+class BaseScheduler : public Scheduler {
+public:
+  explicit BaseScheduler(ManualTimeSource& time_source) : time_source_(time_source) {}
+
+  TimerPtr createTimer(const TimerCb& cb, Dispatcher&) override {
+    auto timer = std::make_unique<BaseTimer>(cb, time_source_);
+    timers_.push_back(timer.get());
+    return timer;
+  }
+
+  ManualTimeSource& time_source_;
+  // The first timer created is the driver of the wheel.
+  std::vector<BaseTimer*> timers_;
+};
+
+class TimerWheelSchedulerTest : public testing::Test {
+public:
+  BaseTimer& driver() { return *base_scheduler_.timers_[0]; }
+
+  // Runs an iteration of the event loop, firing the driver if it is due.
+  void runLoop() {
+    if (driver().enabled_ && driver().deadline_ <= time_source_.monotonic_time_) {
+      driver().enabled_ = false;
+      driver().cb_();
+    }
+  }
+
+  // Moves time forward, waking at each deadline of the driver on the way as the event loop would.
+  void advance(std::chrono::microseconds duration) {
+    const MonotonicTime target = time_source_.monotonic_time_ + duration;
+    while (driver().enabled_ && driver().deadline_ <= target) {
+      time_source_.monotonic_time_ = std::max(time_source_.monotonic_time_, driver().deadline_);
+      driver().enabled_ = false;
+      driver().cb_();
+    }
+    time_source_.monotonic_time_ = target;
+  }
+
+  std::chrono::microseconds elapsed() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time_source_.monotonic_time_ -
+                                                                 start_);
+  }
+
+  ManualTimeSource time_source_;
+  BaseScheduler base_scheduler_{time_source_};
+  NiceMock<MockDispatcher> dispatcher_;
+  const MonotonicTime start_{time_source_.monotonic_time_};
+  TimerWheelScheduler scheduler_{base_scheduler_, dispatcher_, time_source_};
+};
+
+TEST_F(TimerWheelSchedulerTest, EnableAndFire) {
+  uint32_t fired = 0;
+  TimerPtr timer = scheduler_.createTimer([&]() { fired++; }, dispatcher_);
+  EXPECT_FALSE(timer->enabled());
+  timer->enableTimer(std::chrono::milliseconds(10));
+  EXPECT_TRUE(timer->enabled());
+  EXPECT_EQ(1, scheduler_.enabledTimers());
+  EXPECT_EQ(std::chrono::milliseconds(10), driver().duration_);
+
+  advance(std::chrono::milliseconds(9));
+  EXPECT_EQ(0, fired);
+  advance(std::chrono::milliseconds(1));
+  EXPECT_EQ(1, fired);
+  EXPECT_FALSE(timer->enabled());
+  EXPECT_EQ(0, scheduler_.enabledTimers());
+  EXPECT_FALSE(driver().enabled_);
+}
+
+// A timer enabled part way through a tick expires on the tick after its deadline.
+TEST_F(TimerWheelSchedulerTest, NeverFiresEarly) {
+  bool fired = false;
+  TimerPtr timer = scheduler_.createTimer([&]() { fired = true; }, dispatcher_);
+  advance(std::chrono::microseconds(500));
+  timer->enableTimer(std::chrono::milliseconds(1));
+
+  advance(std::chrono::microseconds(999));
+  EXPECT_FALSE(fired);
+  advance(std::chrono::microseconds(501));
+  EXPECT_TRUE(fired);
+}
+
+TEST_F(TimerWheelSchedulerTest, DisableTimer) {
+  bool fired = false;
+  TimerPtr timer = scheduler_.createTimer([&]() { fired = true; }, dispatcher_);
+  timer->enableTimer(std::chrono::milliseconds(10));
+  timer->disableTimer();
+  EXPECT_FALSE(timer->enabled());
+  EXPECT_EQ(0, scheduler_.enabledTimers());
+
+  advance(std::chrono::milliseconds(20));
+  EXPECT_FALSE(fired);
+}
+
+TEST_F(TimerWheelSchedulerTest, EnableAgainResetsTimeout) {
+  bool fired = false;
+  TimerPtr timer = scheduler_.createTimer([&]() { fired = true; }, dispatcher_);
+  timer->enableTimer(std::chrono::milliseconds(10));
+  advance(std::chrono::milliseconds(5));
+  timer->enableTimer(std::chrono::milliseconds(10));
+  EXPECT_EQ(1, scheduler_.enabledTimers());
+
+  advance(std::chrono::milliseconds(9));
+  EXPECT_FALSE(fired);
+  advance(std::chrono::milliseconds(1));
+  EXPECT_TRUE(fired);
+}
+
+// As with libevent, a timer enabled for no time runs on the next iteration of the event loop, and
+// a timer which keeps enabling itself for no time runs once per iteration.
+TEST_F(TimerWheelSchedulerTest, ZeroDurationRunsOnNextLoop) {
+  uint32_t fired = 0;
+  TimerPtr timer;
+  timer = scheduler_.createTimer(
+      [&]() {
+        if (++fired < 3) {
+          timer->enableTimer(std::chrono::milliseconds(0));
+        }
+      },
+      dispatcher_);
+  timer->enableTimer(std::chrono::milliseconds(0));
+  EXPECT_EQ(std::chrono::microseconds(0), driver().duration_);
+
+  for (uint32_t i = 1; i <= 3; i++) {
+    runLoop();
+    EXPECT_EQ(i, fired);
+  }
+  EXPECT_FALSE(timer->enabled());
+}
+
+TEST_F(TimerWheelSchedulerTest, TimersFireInOrderOfExpiry) {
+  InSequence s;
+  testing::MockFunction<void(int)> fired;
+  std::vector<TimerPtr> timers;
+  for (int duration : {300, 5, 70000, 256, 1}) {
+    timers.push_back(scheduler_.createTimer([&fired, duration]() { fired.Call(duration); },
+                                            dispatcher_));
+    timers.back()->enableTimer(std::chrono::milliseconds(duration));
+  }
+  EXPECT_CALL(fired, Call(1));
+  EXPECT_CALL(fired, Call(5));
+  EXPECT_CALL(fired, Call(256));
+  EXPECT_CALL(fired, Call(300));
+  EXPECT_CALL(fired, Call(70000));
+  advance(std::chrono::seconds(100));
+}
+
+// Timers beyond the span of level 0 fire on time as they move down the levels of the wheel,
+// including those beyond the span of the whole wheel.
+TEST_F(TimerWheelSchedulerTest, LongTimersFireOnTime) {
+  for (const uint64_t duration : {255ULL, 256ULL, 257ULL, 65535ULL, 65536ULL, 70001ULL,
+                                  (1ULL << 24) + 5, (1ULL << 32) + 7}) {
+    SCOPED_TRACE(duration);
+    bool fired = false;
+    TimerPtr timer = scheduler_.createTimer([&]() { fired = true; }, dispatcher_);
+    // Start part way through slots of every level.
+    advance(std::chrono::milliseconds(12345));
+    timer->enableTimer(std::chrono::milliseconds(duration));
+
+    advance(std::chrono::milliseconds(duration - 1));
+    EXPECT_FALSE(fired);
+    advance(std::chrono::milliseconds(1));
+    EXPECT_TRUE(fired);
+  }
+}
+
+TEST_F(TimerWheelSchedulerTest, ManyTimersFireWithinATickOfTheirDeadline) {
+  TestRandomGenerator random;
+  std::vector<std::chrono::microseconds> deadlines(2000);
+  std::vector<std::chrono::microseconds> fired_at(deadlines.size());
+  std::vector<TimerPtr> timers;
+  for (size_t i = 0; i < deadlines.size(); i++) {
+    timers.push_back(
+        scheduler_.createTimer([this, &fired_at, i]() { fired_at[i] = elapsed(); }, dispatcher_));
+  }
+  for (size_t i = 0; i < deadlines.size(); i++) {
+    advance(std::chrono::microseconds(random.random() % 1000));
+    const std::chrono::milliseconds duration(1 + random.random() % 100000);
+    timers[i]->enableTimer(duration);
+    deadlines[i] = elapsed() + duration;
+  }
+  advance(std::chrono::seconds(101));
+
+  for (size_t i = 0; i < deadlines.size(); i++) {
+    EXPECT_GE(fired_at[i], deadlines[i]);
+    EXPECT_LT(fired_at[i], deadlines[i] + std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(0, scheduler_.enabledTimers());
+}
+
+// A callback may disable, delete or enable again the timers expiring with it.
+TEST_F(TimerWheelSchedulerTest, CallbackChangesOtherExpiredTimers) {
+  bool fired2 = false;
+  uint32_t fired3 = 0;
+  TimerPtr timer2 = scheduler_.createTimer([&]() { fired2 = true; }, dispatcher_);
+  TimerPtr timer3 = scheduler_.createTimer([&]() { fired3++; }, dispatcher_);
+  TimerPtr timer1 = scheduler_.createTimer(
+      [&]() {
+        timer2.reset();
+        timer3->enableTimer(std::chrono::milliseconds(5));
+      },
+      dispatcher_);
+  timer1->enableTimer(std::chrono::milliseconds(10));
+  timer2->enableTimer(std::chrono::milliseconds(10));
+  timer3->enableTimer(std::chrono::milliseconds(10));
+
+  advance(std::chrono::milliseconds(10));
+  EXPECT_FALSE(fired2);
+  EXPECT_EQ(0, fired3);
+  EXPECT_TRUE(timer3->enabled());
+  advance(std::chrono::milliseconds(5));
+  EXPECT_EQ(1, fired3);
+}
+
+TEST_F(TimerWheelSchedulerTest, DeleteEnabledTimer) {
+  TimerPtr timer = scheduler_.createTimer([]() {}, dispatcher_);
+  timer->enableTimer(std::chrono::milliseconds(100000));
+  timer.reset();
+  EXPECT_EQ(0, scheduler_.enabledTimers());
+  advance(std::chrono::milliseconds(100000));
+}
+
+TEST_F(TimerWheelSchedulerTest, TimerWithScope) {
+  MockScopeTrackedObject scope;
+  TimerPtr timer = scheduler_.createTimer([]() {}, dispatcher_);
+  timer->enableTimer(std::chrono::milliseconds(1), &scope);
+
+  EXPECT_CALL(dispatcher_, pushTrackedObject(&scope));
+  EXPECT_CALL(dispatcher_, popTrackedObject(&scope));
+  advance(std::chrono::milliseconds(1));
+}
+
+// High resolution timers are passed on to the base scheduler.
+TEST_F(TimerWheelSchedulerTest, HighResolutionTimer) {
+  TimerPtr timer = scheduler_.createTimer([]() {}, dispatcher_);
+  timer->enableTimer(std::chrono::milliseconds(10));
+  timer->enableHRTimer(std::chrono::microseconds(150));
+  ASSERT_EQ(2, base_scheduler_.timers_.size());
+  BaseTimer& hr_timer = *base_scheduler_.timers_[1];
+  EXPECT_TRUE(hr_timer.enabled_);
+  EXPECT_EQ(std::chrono::microseconds(150), hr_timer.duration_);
+  EXPECT_EQ(0, scheduler_.enabledTimers());
+  EXPECT_TRUE(timer->enabled());
+
+  timer->enableTimer(std::chrono::milliseconds(10));
+  EXPECT_FALSE(hr_timer.enabled_);
+  EXPECT_EQ(1, scheduler_.enabledTimers());
+  timer->disableTimer();
+  EXPECT_FALSE(timer->enabled());
+}
+
+// Timers of a dispatcher using the wheel fire in its event loop.
+TEST(TimerWheelDispatcherTest, TimersFire) {
+  TestRealTimeSystem time_system;
+  Api::ApiPtr api = Api::createApiForTest(time_system);
+  DispatcherImpl dispatcher(
+      "test_thread", *api, time_system,
+      [](Dispatcher& dispatcher) {
+        return std::make_unique<ScaledRangeTimerManagerImpl>(dispatcher);
+      },
+      nullptr, true);
+
+  std::vector<int> fired;
+  TimerPtr timer1 = dispatcher.createTimer([&]() { fired.push_back(1); });
+  TimerPtr timer2 = dispatcher.createTimer([&]() {
+    fired.push_back(2);
+    dispatcher.exit();
+  });
+  timer2->enableTimer(std::chrono::milliseconds(20));
+  timer1->enableTimer(std::chrono::milliseconds(5));
+  dispatcher.run(Dispatcher::RunType::Block);
+  EXPECT_EQ((std::vector<int>{1, 2}), fired);
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,65 @@
+// Compares timer churn with timers kept in libevent and in a TimerWheelScheduler. Each iteration
+// enables one of many outstanding timers again, as an idle timeout does on activity.
+
+#include <vector>
+
+#include "source/common/common/random_generator.h"
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/event/scaled_range_timer_manager_impl.h"
+
+#include "test/benchmark/main.h"
+#include "test/test_common/test_time.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Event {
+
+// Arguments are 1 to use the timer wheel and the number of outstanding timers.
+static void timerChurn(::benchmark::State& state) {
+  const bool use_timer_wheel = state.range(0);
+  const uint64_t num_timers = state.range(1);
+  if (benchmark::skipExpensiveBenchmarks() && num_timers > 10000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  TestRealTimeSystem time_system;
+  Api::ApiPtr api = Api::createApiForTest(time_system);
+  DispatcherImpl dispatcher(
+      "test_thread", *api, time_system,
+      [](Dispatcher& dispatcher) {
+        return std::make_unique<ScaledRangeTimerManagerImpl>(dispatcher);
+      },
+      nullptr, use_timer_wheel);
+
+  // Timeouts between one second and a minute, so that no timer fires while measuring.
+  Random::RandomGeneratorImpl random;
+  std::vector<TimerPtr> timers;
+  timers.reserve(num_timers);
+  for (uint64_t i = 0; i < num_timers; i++) {
+    timers.push_back(dispatcher.createTimer([]() {}));
+    timers.back()->enableTimer(std::chrono::milliseconds(1000 + random.random() % 59000));
+  }
+  std::vector<std::pair<uint32_t, std::chrono::milliseconds>> churn(1 << 16);
+  for (auto& [index, timeout] : churn) {
+    index = random.random() % num_timers;
+    timeout = std::chrono::milliseconds(1000 + random.random() % 59000);
+  }
+
+  size_t next = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    const auto& [index, timeout] = churn[next++ & (churn.size() - 1)];
+    timers[index]->enableTimer(timeout);
+  }
+  state.counters["timers_enabled_per_second"] =
+      ::benchmark::Counter(state.iterations(), ::benchmark::Counter::kIsRate);
+}
+BENCHMARK(timerChurn)
+    ->ArgsProduct({{0, 1}, {1000, 1000000}})
+    ->Unit(::benchmark::kNanosecond);
+
+} // namespace Event
+} // namespace Envoy
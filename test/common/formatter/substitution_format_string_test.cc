@@ -77,6 +77,25 @@ TEST_F(SubstitutionFormatStringUtilsTest, TestFromProtoConfigJson) {
   EXPECT_TRUE(TestUtility::jsonStringEqual(out_json, expected));
 }
 
+TEST_F(SubstitutionFormatStringUtilsTest, TestFromProtoConfigBinary) {
+  const std::string yaml = R"EOF(
+  binary_format:
+    columns:
+    - "%REQ(:path)%"
+    - "code=%RESPONSE_CODE%"
+    - "%REQ(x-missing)%"
+)EOF";
+  TestUtility::loadFromYaml(yaml, config_);
+
+  auto formatter = SubstitutionFormatStringUtils::fromProtoConfig(config_, context_);
+  const std::string record = formatter->formatWithContext(formatter_context_, stream_info_);
+  std::vector<absl::optional<absl::string_view>> columns;
+  EXPECT_EQ(record.size(), BinaryRecord::decode(record, columns).value());
+  EXPECT_THAT(columns, testing::ElementsAre(absl::optional<absl::string_view>("/bar/foo"),
+                                            absl::optional<absl::string_view>("code=200"),
+                                            absl::nullopt));
+}
+
 TEST_F(SubstitutionFormatStringUtilsTest, TestInvalidConfigs) {
   const std::vector<std::string> invalid_configs = {
       R"(
@@ -4326,6 +4326,149 @@ TEST(SubstitutionFormatterTest, JsonFormatterWithOrderedPropertiesTest) {
   EXPECT_EQ(out_json, expected);
 }
 
+TEST(SubstitutionFormatterTest, JsonFormatterWithOrderedPropertiesMatchesStructTest) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{"escaped", "a\"b\\c\td"},
+                                                {"utf8", "caf\xc3\xa9"},
+                                                {"invalid-utf8", "bad\xff"}};
+  HttpFormatterContext formatter_context(&request_header);
+
+  envoy::config::core::v3::Metadata metadata;
+  populateMetadataTestData(metadata);
+  EXPECT_CALL(Const(stream_info), dynamicMetadata()).WillRepeatedly(ReturnRef(metadata));
+  stream_info.response_code_ = 200;
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    "key \"with\" escapes": plain
+    escaped: '%REQ(ESCAPED)%'
+    utf8: '%REQ(UTF8)%'
+    invalid_utf8: '%REQ(INVALID-UTF8)%'
+    missing: '%REQ(MISSING)%'
+    multiple: '%REQ(MISSING)% %REQ(ESCAPED)%'
+    response_code: '%RESPONSE_CODE%'
+    number: 1.5
+    metadata: '%DYNAMIC_METADATA(com.test)%'
+    list:
+      - '%REQ(MISSING)%'
+      - '%REQ(UTF8)%'
+      - 2
+    empty_nested:
+      missing: '%REQ(MISSING)%'
+      deeper:
+        missing: '%REQ(MISSING)%'
+    nested:
+      zfield: '%REQ(ESCAPED)%'
+      afield: '%REQ(MISSING)%'
+  )EOF",
+                            key_mapping);
+
+  // The log line is written directly, and must match the serialized Struct exactly.
+  for (const bool preserve_types : {false, true}) {
+    for (const bool omit_empty_values : {false, true}) {
+      SCOPED_TRACE(absl::StrCat("preserve_types: ", preserve_types,
+                                " omit_empty_values: ", omit_empty_values));
+      JsonFormatterImpl formatter(key_mapping, preserve_types, omit_empty_values, true);
+      StructFormatter struct_formatter(key_mapping, preserve_types, omit_empty_values);
+
+      const std::string expected =
+          Json::Factory::loadFromProtobufStruct(
+              struct_formatter.formatWithContext(formatter_context, stream_info))
+              ->asJsonString() +
+          "\n";
+      EXPECT_EQ(expected, formatter.formatWithContext(formatter_context, stream_info));
+    }
+  }
+}
+
+TEST(SubstitutionFormatterTest, JsonFormatterWithOrderedPropertiesAllOmittedTest) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header;
+  HttpFormatterContext formatter_context(&request_header);
+
+  ProtobufWkt::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    missing: '%REQ(MISSING)%'
+    nested:
+      missing: '%REQ(MISSING)%'
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl formatter(key_mapping, false, true, true);
+
+  EXPECT_EQ("{}\n", formatter.formatWithContext(formatter_context, stream_info));
+}
+
+TEST(SubstitutionFormatterTest, BinaryFormatterTest) {
+  StreamInfo::MockStreamInfo stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
+  HttpFormatterContext formatter_context(&request_header);
+
+  absl::optional<Http::Protocol> protocol = Http::Protocol::Http11;
+  EXPECT_CALL(stream_info, protocol()).WillRepeatedly(Return(protocol));
+
+  Protobuf::RepeatedPtrField<std::string> columns;
+  columns.Add("%PROTOCOL%");
+  columns.Add("%REQ(FIRST)%");
+  columns.Add("%REQ(NOT_EXIST)%");
+  columns.Add("path=%REQ(:PATH)% missing=%REQ(NOT_EXIST)%");
+  columns.Add("");
+  BinaryFormatterBaseImpl<HttpFormatterContext> formatter(columns);
+
+  const std::string record = formatter.formatWithContext(formatter_context, stream_info);
+  std::vector<absl::optional<absl::string_view>> values;
+  const absl::StatusOr<size_t> size = BinaryRecord::decode(record, values);
+  ASSERT_TRUE(size.ok());
+  EXPECT_EQ(record.size(), *size);
+  ASSERT_EQ(5, values.size());
+  EXPECT_EQ("HTTP/1.1", values[0]);
+  EXPECT_EQ("GET", values[1]);
+  EXPECT_EQ(absl::nullopt, values[2]);
+  EXPECT_EQ("path=/ missing=-", values[3]);
+  EXPECT_EQ("", values[4]);
+
+  // Records are self-delimiting, so a log of them decodes one at a time.
+  const std::string log = record + record;
+  ASSERT_TRUE(BinaryRecord::decode(log, values).ok());
+  EXPECT_EQ(record.size(), *BinaryRecord::decode(absl::string_view(log).substr(record.size()),
+                                                 values));
+}
+
+TEST(SubstitutionFormatterTest, BinaryRecordDecode) {
+  std::vector<absl::optional<absl::string_view>> values;
+  std::string record;
+  BinaryRecord::appendLength(record, 0);
+  BinaryRecord::appendLength(record, 3);
+  record.append("abc");
+  BinaryRecord::appendLength(record, BinaryRecord::AbsentLength);
+  BinaryRecord::setLength(record, 0, record.size() - BinaryRecord::LengthSize);
+  EXPECT_EQ(std::string("\x0b\x00\x00\x00\x03\x00\x00\x00" "abc\xff\xff\xff\xff", 15), record);
+
+  ASSERT_TRUE(BinaryRecord::decode(record, values).ok());
+  EXPECT_THAT(values, testing::ElementsAre(absl::optional<absl::string_view>("abc"),
+                                           absl::nullopt));
+
+  // Partial records need more data.
+  for (size_t i = 0; i < record.size(); i++) {
+    const absl::StatusOr<size_t> size =
+        BinaryRecord::decode(absl::string_view(record).substr(0, i), values);
+    ASSERT_TRUE(size.ok());
+    EXPECT_EQ(0, *size);
+  }
+
+  // A column overrunning the record.
+  std::string overrun = record;
+  BinaryRecord::setLength(overrun, BinaryRecord::LengthSize, 8);
+  EXPECT_EQ("column 0 overruns the record",
+            BinaryRecord::decode(overrun, values).status().message());
+
+  // A column length cut short by the end of the record.
+  std::string truncated = record.substr(0, 10);
+  BinaryRecord::setLength(truncated, 0, truncated.size() - BinaryRecord::LengthSize);
+  BinaryRecord::setLength(truncated, BinaryRecord::LengthSize, 0);
+  EXPECT_EQ("truncated column length in column 1",
+            BinaryRecord::decode(truncated, values).status().message());
+}
+
 TEST(SubstitutionFormatterTest, CompositeFormatterSuccess) {
   Http::TestRequestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
   Http::TestResponseHeaderMapImpl response_header{{"second", "PUT"}, {"test", "test"}};
@@ -1,3 +1,5 @@
+#include <string>
+
 #include "source/common/http/character_set_validation.h"
 
 #include "gtest/gtest.h"
@@ -33,5 +35,56 @@ TEST(CharacterSetValidationTest, Test) {
   }
 }
 
+class CharacterSetTest : public testing::TestWithParam<CharacterSet::Implementation> {
+protected:
+  void SetUp() override {
+    if (!CharacterSet::isSupported(GetParam())) {
+      GTEST_SKIP() << "implementation not supported on this CPU";
+    }
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(Implementations, CharacterSetTest,
+                         testing::Values(CharacterSet::Implementation::Scalar,
+                                         CharacterSet::Implementation::Ssse3,
+                                         CharacterSet::Implementation::Avx2));
+
+TEST_P(CharacterSetTest, MatchesTable) {
+  for (const auto* table : {&kGenericHeaderNameCharTable, &kGenericHeaderValueCharTable,
+                            &kUriQueryAndFragmentCharTable}) {
+    const CharacterSet set(*table);
+    for (unsigned c = 0; c < 256; ++c) {
+      const bool in_table = testCharInTable(*table, static_cast<char>(c));
+      EXPECT_EQ(set.contains(static_cast<char>(c)), in_table);
+      // Place the character at every offset of strings around the vector widths.
+      for (size_t size : {1, 15, 16, 17, 31, 32, 33, 64, 65}) {
+        for (size_t offset = 0; offset < size; ++offset) {
+          std::string value(size, 'a');
+          value[offset] = static_cast<char>(c);
+          ASSERT_EQ(set.findFirstNotIn(value, GetParam()), in_table ? size : offset)
+              << "character " << c << " at " << offset << " of " << size;
+        }
+      }
+    }
+  }
+}
+
+TEST_P(CharacterSetTest, FindsFirstOfSeveral) {
+  std::string value(100, 'a');
+  value[70] = '\n';
+  value[40] = '\r';
+  value[90] = '\0';
+  EXPECT_EQ(kGenericHeaderValueCharSet.findFirstNotIn(value, GetParam()), 40U);
+  EXPECT_EQ(kGenericHeaderValueCharSet.findFirstNotIn("", GetParam()), 0U);
+}
+
+TEST(CharacterSetValidationTest, HeaderValueCharacters) {
+  EXPECT_TRUE(kGenericHeaderValueCharSet.containsAll("text/html; charset=\"utf-8\"\t\x80\xff"));
+  EXPECT_FALSE(kGenericHeaderValueCharSet.containsAll("bad\x7f"));
+  EXPECT_FALSE(kGenericHeaderValueCharSet.containsAll(absl::string_view("bad\0", 4)));
+  EXPECT_TRUE(kGenericHeaderNameCharSet.containsAll("x-forwarded-for"));
+  EXPECT_FALSE(kGenericHeaderNameCharSet.containsAll("x-forwarded for"));
+}
+
 } // namespace Http
 } // namespace Envoy
@@ -3,6 +3,7 @@
 
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "benchmark/benchmark.h"
 
 namespace Envoy {
@@ -297,6 +298,40 @@ static void headerMapImplRemovePrefix(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplRemovePrefix)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
 
+/**
+ * Measure the speed of a request header map with a large number of custom headers, as produced by
+ * stacked auth and tracing filters. Each iteration builds the map, then looks up and removes a
+ * sample of the non-inline headers and one inline header. The numeric Arg is the number of custom
+ * headers in the map.
+ */
+static void headerMapImplLargeHeaderCount(benchmark::State& state) {
+  const size_t num_headers = state.range(0);
+  std::vector<LowerCaseString> keys;
+  keys.reserve(num_headers);
+  for (size_t i = 0; i < num_headers; i++) {
+    keys.emplace_back(absl::StrCat("x-custom-header-", i));
+  }
+  const std::string value("01234567890123456789");
+  size_t successes = 0;
+  for (auto _ : state) { // NOLINT
+    auto headers = Http::RequestHeaderMapImpl::create();
+    headers->setReferenceMethod(Http::Headers::get().MethodValues.Get);
+    headers->setReferencePath("/");
+    for (const LowerCaseString& key : keys) {
+      headers->addReference(key, value);
+    }
+    for (size_t i = 0; i < num_headers; i += 4) {
+      successes += !headers->get(keys[i]).empty();
+    }
+    successes += !headers->get(Http::Headers::get().Path).empty();
+    for (size_t i = 1; i < num_headers; i += 8) {
+      successes += headers->remove(keys[i]);
+    }
+  }
+  benchmark::DoNotOptimize(successes);
+}
+BENCHMARK(headerMapImplLargeHeaderCount)->Arg(10)->Arg(40)->Arg(80)->Arg(200);
+
 class StaticLookupBenchmarker {
 public:
   explicit StaticLookupBenchmarker(std::unique_ptr<HeaderMapImpl> impl)
@@ -1,4 +1,8 @@
+#include <sys/socket.h>
+
 #include <functional>
+#include <string>
+#include <vector>
 
 #include "source/common/io/io_uring_impl.h"
 #include "source/common/network/address_impl.h"
@@ -102,7 +106,7 @@ TEST_P(IoUringImplParamTest, InvalidParams) {
   auto file_event = dispatcher->createFileEvent(
       event_fd,
       [this, &completions_nr](uint32_t) {
-        io_uring_->forEveryCompletion([&completions_nr](Request*, int32_t res, bool) {
+        io_uring_->forEveryCompletion([&completions_nr](Request*, int32_t res, bool, uint32_t) {
           EXPECT_TRUE(res < 0);
           completions_nr++;
         });
@@ -139,7 +143,7 @@ TEST_F(IoUringImplTest, InjectCompletion) {
       event_fd,
       [this, &completions_nr](uint32_t) {
         io_uring_->forEveryCompletion(
-            [&completions_nr](Request* user_data, int32_t res, bool injected) {
+            [&completions_nr](Request* user_data, int32_t res, bool injected, uint32_t) {
               EXPECT_TRUE(injected);
               EXPECT_EQ(1, dynamic_cast<TestRequest*>(user_data)->data_);
               EXPECT_EQ(-11, res);
@@ -172,20 +176,21 @@ TEST_F(IoUringImplTest, NestInjectCompletion) {
   auto file_event = dispatcher->createFileEvent(
       event_fd,
       [this, &fd2, &completions_nr, &request2](uint32_t) {
-        io_uring_->forEveryCompletion([this, &fd2, &completions_nr,
-                                       &request2](Request* user_data, int32_t res, bool injected) {
-          EXPECT_TRUE(injected);
-          if (completions_nr == 0) {
-            EXPECT_EQ(1, dynamic_cast<TestRequest*>(user_data)->data_);
-            EXPECT_EQ(-11, res);
-            io_uring_->injectCompletion(fd2, &request2, -22);
-          } else {
-            EXPECT_EQ(2, dynamic_cast<TestRequest*>(user_data)->data_);
-            EXPECT_EQ(-22, res);
-          }
+        io_uring_->forEveryCompletion(
+            [this, &fd2, &completions_nr, &request2](Request* user_data, int32_t res, bool injected,
+                                                     uint32_t) {
+              EXPECT_TRUE(injected);
+              if (completions_nr == 0) {
+                EXPECT_EQ(1, dynamic_cast<TestRequest*>(user_data)->data_);
+                EXPECT_EQ(-11, res);
+                io_uring_->injectCompletion(fd2, &request2, -22);
+              } else {
+                EXPECT_EQ(2, dynamic_cast<TestRequest*>(user_data)->data_);
+                EXPECT_EQ(-22, res);
+              }
 
-          completions_nr++;
-        });
+              completions_nr++;
+            });
         return absl::OkStatus();
       },
       trigger, Event::FileReadyType::Read);
@@ -214,7 +219,7 @@ TEST_F(IoUringImplTest, RemoveInjectCompletion) {
       event_fd,
       [this, &completions_nr](uint32_t) {
         io_uring_->forEveryCompletion(
-            [&completions_nr](Request* user_data, int32_t res, bool injected) {
+            [&completions_nr](Request* user_data, int32_t res, bool injected, uint32_t) {
               EXPECT_TRUE(injected);
               EXPECT_EQ(1, dynamic_cast<TestRequest*>(user_data)->data_);
               EXPECT_EQ(-11, res);
@@ -250,7 +255,8 @@ TEST_F(IoUringImplTest, NestRemoveInjectCompletion) {
       event_fd,
       [this, &fd2, &completions_nr, &data2](uint32_t) {
         io_uring_->forEveryCompletion(
-            [this, &fd2, &completions_nr, &data2](Request* user_data, int32_t res, bool injected) {
+            [this, &fd2, &completions_nr, &data2](Request* user_data, int32_t res, bool injected,
+                                                  uint32_t) {
               EXPECT_TRUE(injected);
               if (completions_nr == 0) {
                 EXPECT_EQ(1, dynamic_cast<TestRequest*>(user_data)->data_);
@@ -302,7 +308,7 @@ TEST_F(IoUringImplTest, PrepareReadvAllDataFitsOneChunk) {
   auto file_event = dispatcher->createFileEvent(
       event_fd,
       [this, &completions_nr, d = dispatcher.get()](uint32_t) {
-        io_uring_->forEveryCompletion([&completions_nr](Request*, int32_t res, bool) {
+        io_uring_->forEveryCompletion([&completions_nr](Request*, int32_t res, bool, uint32_t) {
           completions_nr++;
           EXPECT_EQ(res, strlen("test text"));
         });
@@ -321,6 +327,52 @@ TEST_F(IoUringImplTest, PrepareReadvAllDataFitsOneChunk) {
   EXPECT_STREQ(static_cast<char*>(iov.iov_base), "test text");
 }
 
+TEST_F(IoUringImplTest, PrepareRecvMultishotFromBufferRing) {
+  if (io_uring_->registerBufferRing(2, 16) != IoUringResult::Ok) {
+    GTEST_SKIP() << "provided buffer rings are not supported by the kernel";
+  }
+
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  auto dispatcher = api_->allocateDispatcher("test_thread");
+  os_fd_t event_fd = io_uring_->registerEventfd();
+
+  const Event::FileTriggerType trigger = Event::PlatformDefaultTriggerType;
+  std::vector<std::string> received;
+  auto file_event = dispatcher->createFileEvent(
+      event_fd,
+      [this, &received](uint32_t) {
+        io_uring_->forEveryCompletion(
+            [this, &received](Request*, int32_t res, bool injected, uint32_t flags) {
+              EXPECT_FALSE(injected);
+              ASSERT_GT(res, 0);
+              ASSERT_TRUE(flags & IORING_CQE_F_BUFFER);
+              // The recv stays armed for the next data.
+              EXPECT_TRUE(flags & IORING_CQE_F_MORE);
+              const uint16_t buffer_id = flags >> IORING_CQE_BUFFER_SHIFT;
+              received.emplace_back(
+                  reinterpret_cast<const char*>(io_uring_->getProvidedBuffer(buffer_id)), res);
+              io_uring_->recycleProvidedBuffer(buffer_id);
+            });
+        return absl::OkStatus();
+      },
+      trigger, Event::FileReadyType::Read);
+
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->prepareRecvMultishot(fds[0], nullptr));
+  io_uring_->submit();
+
+  // More writes than buffers in the ring, which works as long as the buffers are recycled.
+  for (const std::string data : {"first", "second", "third"}) {
+    ASSERT_EQ(static_cast<ssize_t>(data.size()), write(fds[1], data.data(), data.size()));
+    const size_t expected = received.size() + 1;
+    waitForCondition(*dispatcher, [&received, expected]() { return received.size() == expected; });
+    EXPECT_EQ(data, received.back());
+  }
+
+  close(fds[0]);
+  close(fds[1]);
+}
+
 TEST_F(IoUringImplTest, PrepareReadvQueueOverflow) {
   std::string test_file =
       TestEnvironment::writeStringToFileForTest("prepare_readv_overflow", "abcdefhg", true);
@@ -348,7 +400,8 @@ TEST_F(IoUringImplTest, PrepareReadvQueueOverflow) {
   auto file_event = dispatcher->createFileEvent(
       event_fd,
       [this, &completions_nr](uint32_t) {
-        io_uring_->forEveryCompletion([&completions_nr](Request* user_data, int32_t res, bool) {
+        io_uring_->forEveryCompletion([&completions_nr](Request* user_data, int32_t res, bool,
+                                                        uint32_t) {
           EXPECT_TRUE(user_data != nullptr);
           EXPECT_EQ(res, 2);
           completions_nr++;
@@ -6,6 +6,7 @@
 #include "source/common/io/io_uring_worker_impl.h"
 #include "source/common/network/address_impl.h"
 
+#include "test/common/stats/stat_test_utility.h"
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
@@ -87,10 +88,17 @@ public:
   bool is_shutdown_injected_completion_{false};
 };
 
-class IoUringWorkerTestImpl : public IoUringWorkerImpl {
+// Keeps the stats store alive ahead of the worker which takes stats from it.
+struct IoUringWorkerTestStats {
+  Stats::TestUtil::TestStore stats_store_;
+};
+
+class IoUringWorkerTestImpl : public IoUringWorkerTestStats, public IoUringWorkerImpl {
 public:
-  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher)
-      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher) {}
+  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher,
+                        uint32_t buffer_ring_size = 0, uint32_t zero_copy_send_threshold = 0)
+      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, buffer_ring_size,
+                          zero_copy_send_threshold, dispatcher, *stats_store_.rootScope()) {}
 
   IoUringSocket& addTestSocket(os_fd_t fd) {
     return addSocket(std::make_unique<IoUringSocketTestImpl>(fd, *this));
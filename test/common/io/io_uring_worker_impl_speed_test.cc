@@ -0,0 +1,69 @@
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#include "source/common/io/io_uring_worker_impl.h"
+#include "source/common/memory/stats.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Io {
+
+// Measures the memory held by idle connections, either with every socket reading into a buffer of
+// its own or with the sockets sharing a provided buffer ring. Arguments are the number of
+// connections and the size of the buffer ring, where zero disables the ring.
+static void idleConnectionMemory(benchmark::State& state) {
+  if (!isIoUringSupported()) {
+    state.SkipWithError("io_uring is not supported");
+    return;
+  }
+
+  const uint32_t num_connections = state.range(0);
+  const uint32_t buffer_ring_size = state.range(1);
+  // Each connection takes two file descriptors.
+  struct rlimit limit;
+  getrlimit(RLIMIT_NOFILE, &limit);
+  limit.rlim_cur = limit.rlim_max;
+  setrlimit(RLIMIT_NOFILE, &limit);
+
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Stats::IsolatedStoreImpl store;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    std::vector<os_fd_t> peers;
+    const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+    auto worker = std::make_unique<IoUringWorkerImpl>(
+        1024, false, 8192, 1000, buffer_ring_size, 0, *dispatcher, *store.rootScope());
+    for (uint32_t i = 0; i < num_connections; i++) {
+      int fds[2];
+      RELEASE_ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0,
+                     "unable to create socket pair");
+      worker->addServerSocket(
+          fds[0], [](uint32_t) { return absl::OkStatus(); }, false);
+      peers.push_back(fds[1]);
+    }
+    const size_t end_mem = Memory::Stats::totalCurrentlyAllocated();
+    state.counters["memory"] = end_mem - start_mem;
+    state.counters["memory_per_connection"] = (end_mem - start_mem) / num_connections;
+
+    state.PauseTiming();
+    worker.reset();
+    for (os_fd_t fd : peers) {
+      close(fd);
+    }
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(idleConnectionMemory)
+    ->Args({1000, 0})
+    ->Args({1000, 256})
+    ->Args({10000, 0})
+    ->Args({10000, 256})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace Io
+} // namespace Envoy
@@ -3,6 +3,7 @@
 #include "source/common/io/io_uring_worker_impl.h"
 #include "source/common/network/address_impl.h"
 
+#include "test/common/stats/stat_test_utility.h"
 #include "test/mocks/event/mocks.h"
 #include "test/mocks/io/mocks.h"
 #include "test/test_common/utility.h"
@@ -32,10 +33,17 @@ public:
   void shutdown(int) override {}
 };
 
-class IoUringWorkerTestImpl : public IoUringWorkerImpl {
+// Keeps the stats store alive ahead of the worker which takes stats from it.
+struct IoUringWorkerTestStats {
+  Stats::TestUtil::TestStore stats_store_;
+};
+
+class IoUringWorkerTestImpl : public IoUringWorkerTestStats, public IoUringWorkerImpl {
 public:
-  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher)
-      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher) {}
+  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher,
+                        uint32_t buffer_ring_size = 0, uint32_t zero_copy_send_threshold = 0)
+      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, buffer_ring_size,
+                          zero_copy_send_threshold, dispatcher, *stats_store_.rootScope()) {}
 
   IoUringSocket& addTestSocket(os_fd_t fd) {
     return addSocket(std::make_unique<IoUringSocketTestImpl>(fd, *this));
@@ -219,7 +227,7 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterWrite) {
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
       .WillOnce(Invoke([&io_uring_socket](const CompletionCb& cb) {
         auto* req = new Request(Request::RequestType::Write, io_uring_socket);
-        cb(req, -EAGAIN, true);
+        cb(req, -EAGAIN, true, 0);
       }));
   EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
   ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
@@ -245,9 +253,9 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterWrite) {
   // Finish the read, cancel and write request, then expect the close request submitted.
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
       .WillOnce(Invoke([&read_req, &cancel_req, &write_req](const CompletionCb& cb) {
-        cb(read_req, -EAGAIN, false);
-        cb(cancel_req, 0, false);
-        cb(write_req, -EAGAIN, false);
+        cb(read_req, -EAGAIN, false, 0);
+        cb(cancel_req, 0, false, 0);
+        cb(write_req, -EAGAIN, false, 0);
       }));
   Request* close_req = nullptr;
   EXPECT_CALL(mock_io_uring, prepareClose(_, _))
@@ -258,7 +266,7 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterWrite) {
 
   // After the close request finished, the socket will be cleanup.
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
-      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false, 0); }));
   EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
   EXPECT_CALL(dispatcher, deferredDelete_);
   EXPECT_CALL(dispatcher, clearDeferredDeleteList());
@@ -297,7 +305,7 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterRead) {
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
       .WillOnce(Invoke([&io_uring_socket](const CompletionCb& cb) {
         auto* req = new Request(Request::RequestType::Write, io_uring_socket);
-        cb(req, -EAGAIN, true);
+        cb(req, -EAGAIN, true, 0);
       }));
   EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
   ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
@@ -314,8 +322,8 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterRead) {
   // Finish the read and cancel request, then expect the close request submitted.
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
       .WillOnce(Invoke([&read_req, &cancel_req](const CompletionCb& cb) {
-        cb(read_req, -EAGAIN, false);
-        cb(cancel_req, 0, false);
+        cb(read_req, -EAGAIN, false, 0);
+        cb(cancel_req, 0, false, 0);
       }));
   Request* close_req = nullptr;
   EXPECT_CALL(mock_io_uring, prepareClose(_, _))
@@ -326,7 +334,7 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterRead) {
 
   // After the close request finished, the socket will be cleanup.
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
-      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false, 0); }));
   EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
   EXPECT_CALL(dispatcher, deferredDelete_);
   EXPECT_CALL(dispatcher, clearDeferredDeleteList());
@@ -382,13 +390,13 @@ TEST(IoUringWorkerImplTest, CloseAllSocketsWhenDestruction) {
         EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
 
         // Fake the read request cancel completion.
-        cb(read_req, -ECANCELED, false);
+        cb(read_req, -ECANCELED, false, 0);
 
         // Fake the cancel request is done.
-        cb(cancel_req, 0, false);
+        cb(cancel_req, 0, false, 0);
 
         // Fake the close request is done.
-        cb(close_req, 0, false);
+        cb(close_req, 0, false, 0);
       }));
 
   EXPECT_CALL(dispatcher, deferredDelete_);
@@ -424,7 +432,7 @@ TEST(IoUringWorkerImplTest, ServerCloseWithWriteRequestOnly) {
   io_uring_socket.disableRead();
   // Fake the read request finish.
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
-      .WillOnce(Invoke([&read_req](const CompletionCb& cb) { cb(read_req, -EAGAIN, false); }));
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) { cb(read_req, -EAGAIN, false, 0); }));
   EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
   ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
 
@@ -450,13 +458,13 @@ TEST(IoUringWorkerImplTest, ServerCloseWithWriteRequestOnly) {
             .RetiresOnSaturation();
         EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
 
-        cb(write_req, -EAGAIN, false);
+        cb(write_req, -EAGAIN, false, 0);
       }));
   ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
 
   // After the close request finished, the socket will be cleanup.
   EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
-      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false, 0); }));
   EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
   EXPECT_CALL(dispatcher, deferredDelete_);
   EXPECT_CALL(dispatcher, clearDeferredDeleteList());
@@ -699,6 +707,362 @@ TEST(IoUringWorkerImplTest, NoEnableReadOnConnectError) {
   delete static_cast<Request*>(connect_req);
 }
 
+TEST(IoUringWorkerImplTest, ServerSocketRecvFromBufferRing) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  // The size of the ring is rounded up to a power of 2.
+  EXPECT_CALL(mock_io_uring, registerBufferRing(8, 8192))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 5);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  // The server socket arms a multishot recv instead of reading into a buffer of its own.
+  Request* recv_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&recv_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  IoUringSocket* io_uring_socket = nullptr;
+  std::string read_data;
+  io_uring_socket = &worker.addServerSocket(
+      fd,
+      [&io_uring_socket, &read_data](uint32_t events) {
+        EXPECT_EQ(events, Event::FileReadyType::Read);
+        Buffer::Instance& buf = io_uring_socket->getReadParam()->buf_;
+        read_data.append(buf.toString());
+        buf.drain(buf.length());
+        return absl::OkStatus();
+      },
+      false);
+  ASSERT_NE(recv_req, nullptr);
+  EXPECT_EQ(Request::RequestType::Recv, recv_req->type());
+
+  // The data is copied out of the provided buffer, which then goes back to the ring. The recv stays
+  // armed, so nothing is submitted for the socket.
+  const std::string data = "hello";
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&recv_req, &data](const CompletionCb& cb) {
+        cb(recv_req, static_cast<int32_t>(data.size()), false,
+           IORING_CQE_F_MORE | IORING_CQE_F_BUFFER | (3 << IORING_CQE_BUFFER_SHIFT));
+      }));
+  EXPECT_CALL(mock_io_uring, getProvidedBuffer(3))
+      .WillOnce(Return(reinterpret_cast<const uint8_t*>(data.data())));
+  EXPECT_CALL(mock_io_uring, recycleProvidedBuffer(3));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(data, read_data);
+
+  // Running out of buffers ends the recv, which is armed again without raising an error.
+  Request* second_recv_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(
+          Invoke([&recv_req](const CompletionCb& cb) { cb(recv_req, -ENOBUFS, false, 0); }));
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&second_recv_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(1, worker.stats_store_.counter("io_uring.buffer_ring_exhausted").value());
+  EXPECT_EQ(data, read_data);
+
+  // Closing the socket cancels the armed recv first.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(second_recv_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket->close(false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&second_recv_req, &cancel_req](const CompletionCb& cb) {
+        cb(cancel_req, 0, false, 0);
+        cb(second_recv_req, -ECANCELED, false, 0);
+      }));
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false, 0); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
+TEST(IoUringWorkerImplTest, ServerSocketRecvCancelledWhenReadDisabled) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  EXPECT_CALL(mock_io_uring, registerBufferRing(8, 8192))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 5);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* recv_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&recv_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  IoUringSocket* io_uring_socket = nullptr;
+  std::string read_data;
+  io_uring_socket = &worker.addServerSocket(
+      fd,
+      [&io_uring_socket, &read_data](uint32_t events) {
+        EXPECT_EQ(events, Event::FileReadyType::Read);
+        Buffer::Instance& buf = io_uring_socket->getReadParam()->buf_;
+        read_data.append(buf.toString());
+        buf.drain(buf.length());
+        return absl::OkStatus();
+      },
+      false);
+  Buffer::OwnedImpl& read_buf =
+      dynamic_cast<IoUringServerSocket*>(io_uring_socket)->getReadBuffer();
+
+  // Nothing is buffered, so the recv stays armed to detect the remote close.
+  io_uring_socket->disableRead();
+
+  // The first data arriving while reads are disabled cancels the recv. The data completed before
+  // the cancel is kept, but the recv is not armed again until reads are enabled.
+  const std::string data = "hello";
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&recv_req, &data](const CompletionCb& cb) {
+        cb(recv_req, static_cast<int32_t>(data.size()), false,
+           IORING_CQE_F_MORE | IORING_CQE_F_BUFFER | (3 << IORING_CQE_BUFFER_SHIFT));
+        cb(recv_req, static_cast<int32_t>(data.size()), false,
+           IORING_CQE_F_MORE | IORING_CQE_F_BUFFER | (4 << IORING_CQE_BUFFER_SHIFT));
+      }));
+  EXPECT_CALL(mock_io_uring, getProvidedBuffer(3))
+      .WillOnce(Return(reinterpret_cast<const uint8_t*>(data.data())));
+  EXPECT_CALL(mock_io_uring, getProvidedBuffer(4))
+      .WillOnce(Return(reinterpret_cast<const uint8_t*>(data.data())));
+  EXPECT_CALL(mock_io_uring, recycleProvidedBuffer(3));
+  EXPECT_CALL(mock_io_uring, recycleProvidedBuffer(4));
+  EXPECT_CALL(mock_io_uring, prepareCancel(recv_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(2 * data.size(), read_buf.length());
+  EXPECT_EQ("", read_data);
+
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _)).Times(0);
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&recv_req, &cancel_req](const CompletionCb& cb) {
+        cb(cancel_req, 0, false, 0);
+        cb(recv_req, -ECANCELED, false, 0);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(2 * data.size(), read_buf.length());
+  EXPECT_EQ("", read_data);
+
+  // Enabling reads delivers the buffered data and arms the recv again.
+  Request* injected_req = nullptr;
+  EXPECT_CALL(mock_io_uring, injectCompletion(fd, _, -EAGAIN))
+      .WillOnce(SaveArg<1>(&injected_req));
+  io_uring_socket->enableRead();
+  Request* second_recv_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke(
+          [&injected_req](const CompletionCb& cb) { cb(injected_req, -EAGAIN, true, 0); }));
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&second_recv_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(data + data, read_data);
+  EXPECT_EQ(0, read_buf.length());
+
+  Request* close_cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(second_recv_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_cancel_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket->close(false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&second_recv_req, &close_cancel_req](const CompletionCb& cb) {
+        cb(close_cancel_req, 0, false, 0);
+        cb(second_recv_req, -ECANCELED, false, 0);
+      }));
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false, 0); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
+TEST(IoUringWorkerImplTest, BufferRingUnsupported) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher, createFileEvent_(_, _, Event::PlatformDefaultTriggerType,
+                                           Event::FileReadyType::Read));
+  EXPECT_CALL(mock_io_uring, registerBufferRing(1024, 8192))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Failed));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 1024);
+  EXPECT_EQ(1, worker.stats_store_.counter("io_uring.buffer_ring_unsupported").value());
+
+  os_fd_t fd;
+  SET_SOCKET_INVALID(fd);
+  auto& io_uring_socket = worker.addTestSocket(fd);
+
+  // Sockets fall back to reading into buffers of their own.
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(mock_io_uring, submit());
+  delete worker.submitReadRequest(io_uring_socket);
+
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  dynamic_cast<IoUringSocketTestImpl*>(worker.getSockets().front().get())->cleanupForTest();
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+}
+
+TEST(IoUringWorkerImplTest, ServerSocketZeroCopySend) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  EXPECT_CALL(mock_io_uring, isZeroCopySendSupported()).WillOnce(Return(true));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 0, 4);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  auto& io_uring_socket = worker.addServerSocket(
+      fd, [](uint32_t) { return absl::OkStatus(); }, false);
+
+  // Writes from the threshold on are sent from memory moved into the request.
+  Request* send_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareSendmsgZeroCopy(fd, _, _))
+      .WillOnce(Invoke([&send_req](os_fd_t, const struct msghdr* msg, Request* req) {
+        EXPECT_EQ(1, msg->msg_iovlen);
+        EXPECT_EQ("abcdefgh", absl::string_view(static_cast<const char*>(msg->msg_iov[0].iov_base),
+                                                msg->msg_iov[0].iov_len));
+        send_req = req;
+        return IoUringResult::Ok;
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  Buffer::OwnedImpl data("abcdefgh");
+  io_uring_socket.write(data);
+  EXPECT_EQ(0, data.length());
+
+  // The unsent rest is copied back and, being below the threshold, written with a regular write.
+  Request* write_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&send_req](const CompletionCb& cb) {
+        cb(send_req, 5, false, IORING_CQE_F_MORE);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareWritev(fd, _, 1, _, _))
+      .WillOnce(Invoke([&write_req](os_fd_t, const struct iovec* iovecs, unsigned, off_t,
+                                    Request* req) {
+        EXPECT_EQ("fgh", absl::string_view(static_cast<const char*>(iovecs[0].iov_base),
+                                           iovecs[0].iov_len));
+        write_req = req;
+        return IoUringResult::Ok;
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  // The zero copy send is released by its notification.
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&send_req, &write_req](const CompletionCb& cb) {
+        cb(send_req, 0, false, IORING_CQE_F_NOTIF);
+        cb(write_req, 3, false, 0);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.close(false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req, &cancel_req](const CompletionCb& cb) {
+        cb(read_req, -ECANCELED, false, 0);
+        cb(cancel_req, 0, false, 0);
+      }));
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false, 0); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
+TEST(IoUringWorkerImplTest, ZeroCopySendUnsupported) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher, createFileEvent_(_, _, Event::PlatformDefaultTriggerType,
+                                           Event::FileReadyType::Read));
+  EXPECT_CALL(mock_io_uring, isZeroCopySendSupported()).WillOnce(Return(false));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 0, 4);
+  EXPECT_EQ(1, worker.stats_store_.counter("io_uring.zero_copy_send_unsupported").value());
+  EXPECT_EQ(0, worker.zeroCopySendThreshold());
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+}
+
 } // namespace
 } // namespace Io
 } // namespace Envoy
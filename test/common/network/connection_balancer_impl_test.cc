@@ -0,0 +1,112 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "source/common/network/connection_balancer_impl.h"
+
+#include "test/mocks/network/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class LoadAwareConnectionBalancerImplTest : public testing::Test {
+public:
+  void setLoad(MockBalancedConnectionHandler& handler, uint64_t connections,
+               std::chrono::microseconds loop_latency) {
+    ON_CALL(handler, numConnections()).WillByDefault(Return(connections));
+    ON_CALL(handler, loopLatency()).WillByDefault(Return(loop_latency));
+  }
+
+  LoadAwareConnectionBalancerImpl balancer_{3};
+  NiceMock<MockBalancedConnectionHandler> handler1_;
+  NiceMock<MockBalancedConnectionHandler> handler2_;
+  NiceMock<MockBalancedConnectionHandler> handler3_;
+};
+
+TEST_F(LoadAwareConnectionBalancerImplTest, FewestConnectionsWithoutLoopLatency) {
+  balancer_.registerHandler(handler1_);
+  balancer_.registerHandler(handler2_);
+  balancer_.registerHandler(handler3_);
+  setLoad(handler1_, 5, std::chrono::microseconds(0));
+  setLoad(handler2_, 2, std::chrono::microseconds(0));
+  setLoad(handler3_, 3, std::chrono::microseconds(0));
+
+  EXPECT_CALL(handler2_, incNumConnections());
+  EXPECT_EQ(&handler2_, &balancer_.pickTargetHandler(handler1_));
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, AvoidsWorkerWithHighLoopLatency) {
+  balancer_.registerHandler(handler1_);
+  balancer_.registerHandler(handler2_);
+  balancer_.registerHandler(handler3_);
+  // handler2_ has the fewest connections but its worker is busy.
+  setLoad(handler1_, 5, std::chrono::microseconds(1000));
+  setLoad(handler2_, 2, std::chrono::microseconds(3000));
+  setLoad(handler3_, 4, std::chrono::microseconds(100));
+
+  EXPECT_CALL(handler3_, incNumConnections());
+  EXPECT_EQ(&handler3_, &balancer_.pickTargetHandler(handler1_));
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, KeepsCurrentHandlerOnTie) {
+  balancer_.registerHandler(handler1_);
+  balancer_.registerHandler(handler2_);
+  setLoad(handler1_, 2, std::chrono::microseconds(100));
+  setLoad(handler2_, 2, std::chrono::microseconds(100));
+
+  EXPECT_CALL(handler2_, incNumConnections());
+  EXPECT_EQ(&handler2_, &balancer_.pickTargetHandler(handler2_));
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, UnregisteredHandlerIsNotPicked) {
+  balancer_.registerHandler(handler1_);
+  balancer_.registerHandler(handler2_);
+  balancer_.registerHandler(handler3_);
+  setLoad(handler1_, 5, std::chrono::microseconds(0));
+  setLoad(handler2_, 2, std::chrono::microseconds(0));
+  setLoad(handler3_, 3, std::chrono::microseconds(0));
+  balancer_.unregisterHandler(handler2_);
+
+  EXPECT_CALL(handler2_, numConnections()).Times(0);
+  EXPECT_CALL(handler3_, incNumConnections());
+  EXPECT_EQ(&handler3_, &balancer_.pickTargetHandler(handler1_));
+
+  // The freed slot is reused.
+  balancer_.registerHandler(handler2_);
+  EXPECT_CALL(handler2_, numConnections()).WillRepeatedly(Return(2));
+  EXPECT_CALL(handler2_, incNumConnections());
+  EXPECT_EQ(&handler2_, &balancer_.pickTargetHandler(handler1_));
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, UnregisterWhilePicking) {
+  balancer_.registerHandler(handler1_);
+  balancer_.registerHandler(handler2_);
+  setLoad(handler1_, 5, std::chrono::microseconds(0));
+  setLoad(handler2_, 2, std::chrono::microseconds(0));
+  setLoad(handler3_, 0, std::chrono::microseconds(0));
+
+  std::atomic<bool> done{false};
+  std::thread picker([&]() {
+    while (!done) {
+      BalancedConnectionHandler& target = balancer_.pickTargetHandler(handler1_);
+      EXPECT_TRUE(&target == &handler1_ || &target == &handler2_ || &target == &handler3_);
+    }
+  });
+  for (int i = 0; i < 1000; i++) {
+    balancer_.registerHandler(handler3_);
+    balancer_.unregisterHandler(handler3_);
+  }
+  done = true;
+  picker.join();
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
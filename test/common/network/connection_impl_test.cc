@@ -804,8 +804,10 @@ TEST_P(ConnectionImplTest, ServerResetClose) {
 
 struct MockConnectionStats {
   Connection::ConnectionStats toBufferStats() {
-    return {rx_total_,   rx_current_,   tx_total_,
-            tx_current_, &bind_errors_, &delayed_close_timeouts_};
+    return {rx_total_,     rx_current_,
+            tx_total_,     tx_current_,
+            &bind_errors_, &delayed_close_timeouts_,
+            &write_calls_};
   }
 
   StrictMock<Stats::MockCounter> rx_total_;
@@ -814,12 +816,15 @@ struct MockConnectionStats {
   StrictMock<Stats::MockGauge> tx_current_;
   StrictMock<Stats::MockCounter> bind_errors_;
   StrictMock<Stats::MockCounter> delayed_close_timeouts_;
+  StrictMock<Stats::MockCounter> write_calls_;
 };
 
 struct NiceMockConnectionStats {
   Connection::ConnectionStats toBufferStats() {
-    return {rx_total_,   rx_current_,   tx_total_,
-            tx_current_, &bind_errors_, &delayed_close_timeouts_};
+    return {rx_total_,     rx_current_,
+            tx_total_,     tx_current_,
+            &bind_errors_, &delayed_close_timeouts_,
+            &write_calls_};
   }
 
   NiceMock<Stats::MockCounter> rx_total_;
@@ -828,6 +833,7 @@ struct NiceMockConnectionStats {
   NiceMock<Stats::MockGauge> tx_current_;
   NiceMock<Stats::MockCounter> bind_errors_;
   NiceMock<Stats::MockCounter> delayed_close_timeouts_;
+  NiceMock<Stats::MockCounter> write_calls_;
 };
 
 TEST_P(ConnectionImplTest, ConnectionHash) {
@@ -873,6 +879,7 @@ TEST_P(ConnectionImplTest, ConnectionStats) {
   EXPECT_CALL(*filter, onWrite(_, _)).InSequence(s1).WillOnce(Return(FilterStatus::Continue));
   EXPECT_CALL(client_callbacks_, onEvent(ConnectionEvent::Connected)).InSequence(s1);
   EXPECT_CALL(client_connection_stats.tx_total_, add(4)).InSequence(s1);
+  EXPECT_CALL(client_connection_stats.write_calls_, add(1)).InSequence(s1);
 
   read_filter_ = std::make_shared<NiceMock<MockReadFilter>>();
   MockConnectionStats server_connection_stats;
@@ -1,3 +1,4 @@
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_error_impl.h"
@@ -7,6 +8,7 @@
 #include "test/mocks/api/mocks.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/network_utility.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
@@ -101,6 +103,68 @@ TEST(IoSocketHandleImpl, LastRoundTripTimeReturnsRttIfSuccessful) {
               Eq(std::chrono::duration_cast<std::chrono::milliseconds>(rtt)));
 }
 
+TEST(IoSocketHandleImpl, WriteCoalescesSmallSlices) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.coalesce_small_write_slices", "true"}});
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  Envoy::TestThreadsafeSingletonInjector<Envoy::Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+
+  // More small slices than fit in the iovecs of one call, then a large slice and two small ones.
+  Buffer::OwnedImpl buffer;
+  for (int i = 0; i < 40; i++) {
+    buffer.appendSliceForTest(std::string(10, 'a' + i % 26));
+  }
+  buffer.appendSliceForTest(std::string(4096, 'x'));
+  buffer.appendSliceForTest("yy");
+  buffer.appendSliceForTest("zz");
+  const std::string expected = buffer.toString();
+
+  IoSocketHandleImpl io_handle(42);
+  EXPECT_CALL(os_sys_calls, writev(42, _, 3))
+      .WillOnce(Invoke([&](os_fd_t, const iovec* iov, int num_iov) -> Api::SysCallSizeResult {
+        EXPECT_EQ(400, iov[0].iov_len);
+        EXPECT_EQ(4096, iov[1].iov_len);
+        EXPECT_EQ(4, iov[2].iov_len);
+        std::string written;
+        for (int i = 0; i < num_iov; i++) {
+          written.append(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+        }
+        EXPECT_EQ(expected, written);
+        // A partial write.
+        return {static_cast<ssize_t>(written.size() - 1), 0};
+      }));
+  Api::IoCallUint64Result result = io_handle.write(buffer);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(expected.size() - 1, result.return_value_);
+  EXPECT_EQ("z", buffer.toString());
+}
+
+TEST(IoSocketHandleImpl, WriteDoesNotCopyLoneSmallSlices) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.coalesce_small_write_slices", "true"}});
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  Envoy::TestThreadsafeSingletonInjector<Envoy::Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+
+  Buffer::OwnedImpl buffer;
+  buffer.appendSliceForTest(std::string(2048, 'a'));
+  buffer.appendSliceForTest("b");
+  buffer.appendSliceForTest(std::string(2048, 'c'));
+  const Buffer::RawSliceVector slices = buffer.getRawSlices();
+  ASSERT_EQ(3, slices.size());
+
+  IoSocketHandleImpl io_handle(42);
+  EXPECT_CALL(os_sys_calls, writev(42, _, 3))
+      .WillOnce(Invoke([&](os_fd_t, const iovec* iov, int num_iov) -> Api::SysCallSizeResult {
+        for (int i = 0; i < num_iov; i++) {
+          EXPECT_EQ(slices[i].mem_, iov[i].iov_base);
+          EXPECT_EQ(slices[i].len_, iov[i].iov_len);
+        }
+        return {4097, 0};
+      }));
+  EXPECT_EQ(4097, io_handle.write(buffer).return_value_);
+  EXPECT_EQ(0, buffer.length());
+}
+
 TEST(IoSocketHandleImpl, InterfaceNameWithPipe) {
   std::string path = TestEnvironment::unixDomainSocketPath("foo.sock");
 
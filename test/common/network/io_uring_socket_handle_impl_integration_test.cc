@@ -6,6 +6,7 @@
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/io_uring_socket_handle_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/common/thread_local/thread_local_impl.h"
 
 #include "test/test_common/test_time.h"
@@ -45,7 +46,8 @@ public:
     }
 
     io_uring_worker_factory_ =
-        std::make_unique<Io::IoUringWorkerFactoryImpl>(10, false, 8192, 1000, instance_);
+        std::make_unique<Io::IoUringWorkerFactoryImpl>(10, false, 8192, 1000, 0, 0, instance_,
+                                                       *stats_store_.rootScope());
     io_uring_worker_factory_->onWorkerThreadInitialized();
 
     // Create the thread after the io_uring worker has been initialized, otherwise the dispatcher
@@ -137,6 +139,7 @@ public:
   Event::DispatcherPtr dispatcher_;
   Event::GlobalTimeSystem time_system_;
   ThreadLocal::InstanceImpl instance_;
+  Stats::IsolatedStoreImpl stats_store_;
   std::unique_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory_;
   os_fd_t fd_;
   IoHandlePtr io_uring_socket_handle_;
@@ -1,6 +1,7 @@
 #include "envoy/config/core/v3/base.pb.h"
 
 #include "source/common/network/address_impl.h"
+#include "source/common/network/reuse_port_cpu_steering_option_impl.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/socket_option_impl.h"
 
@@ -12,6 +13,7 @@
 #include "gtest/gtest.h"
 
 using testing::_;
+using testing::Return;
 
 namespace Envoy {
 namespace Network {
@@ -193,6 +195,59 @@ TEST_F(SocketOptionFactoryTest, TestBuildZeroSoLingerOptions) {
   EXPECT_EQ(linger_bstr, option_details->value_);
 }
 
+TEST_F(SocketOptionFactoryTest, TestBuildReusePortCpuSteeringOptions) {
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && defined(__linux__)
+  std::shared_ptr<Socket::Options> options =
+      SocketOptionFactory::buildReusePortCpuSteeringOptions(4);
+
+  EXPECT_CALL(socket_mock_, socketType()).WillRepeatedly(Return(Socket::Type::Stream));
+  EXPECT_CALL(socket_mock_,
+              setSocketOption(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, _, sizeof(sock_fprog)))
+      .WillOnce(Invoke([](int, int, const void* optval, socklen_t) -> Api::SysCallIntResult {
+        const auto* prog = static_cast<const sock_fprog*>(optval);
+        EXPECT_EQ(3U, prog->len);
+        // ld cpu, mod #4, ret a.
+        EXPECT_EQ(static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU), prog->filter[0].k);
+        EXPECT_EQ(BPF_ALU | BPF_MOD | BPF_K, prog->filter[1].code);
+        EXPECT_EQ(4U, prog->filter[1].k);
+        EXPECT_EQ(BPF_RET | BPF_A, prog->filter[2].code);
+        return {0, 0};
+      }));
+
+  // The program is attached once the socket is bound, as it applies to the reuse port group.
+  EXPECT_TRUE(Network::Socket::applyOptions(options, socket_mock_,
+                                            envoy::config::core::v3::SocketOption::STATE_PREBIND));
+  EXPECT_TRUE(Network::Socket::applyOptions(options, socket_mock_,
+                                            envoy::config::core::v3::SocketOption::STATE_BOUND));
+
+  auto option_details = options->at(0)->getOptionDetails(
+      socket_mock_, envoy::config::core::v3::SocketOption::STATE_BOUND);
+  ASSERT_TRUE(option_details.has_value());
+  EXPECT_EQ(SO_ATTACH_REUSEPORT_CBPF, option_details->name_.option());
+  EXPECT_EQ("cpu % 4", option_details->value_);
+#endif
+}
+
+TEST_F(SocketOptionFactoryTest, TestReusePortCpuSteeringOptionsSkipDatagramSockets) {
+  std::shared_ptr<Socket::Options> options =
+      SocketOptionFactory::buildReusePortCpuSteeringOptions(4);
+
+  EXPECT_CALL(socket_mock_, socketType()).WillRepeatedly(Return(Socket::Type::Datagram));
+  EXPECT_CALL(socket_mock_, setSocketOption(_, _, _, _)).Times(0);
+  EXPECT_TRUE(Network::Socket::applyOptions(options, socket_mock_,
+                                            envoy::config::core::v3::SocketOption::STATE_BOUND));
+}
+
+TEST_F(SocketOptionFactoryTest, TestReusePortCpuSteeringOptionsHashKey) {
+  std::vector<uint8_t> four_sockets;
+  SocketOptionFactory::buildReusePortCpuSteeringOptions(4)->at(0)->hashKey(four_sockets);
+  std::vector<uint8_t> eight_sockets;
+  SocketOptionFactory::buildReusePortCpuSteeringOptions(8)->at(0)->hashKey(eight_sockets);
+  if (!four_sockets.empty()) {
+    EXPECT_NE(four_sockets, eight_sockets);
+  }
+}
+
 } // namespace
 } // namespace Network
 } // namespace Envoy
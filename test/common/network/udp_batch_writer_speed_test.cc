@@ -0,0 +1,81 @@
+// Compares sending datagrams over loopback one sendmsg() at a time with the UdpBatchWriter. The
+// receiving socket is not read, so this measures the cost on the sending side only.
+
+#include <algorithm>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/udp_batch_writer.h"
+#include "source/common/network/udp_packet_writer_handler_impl.h"
+
+#include "test/test_common/network_utility.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Network {
+
+// Counts the system calls used to send datagrams.
+class CountingOsSysCalls : public Api::OsSysCallsImpl {
+public:
+  Api::SysCallSizeResult sendmsg(os_fd_t fd, const msghdr* message, int flags) override {
+    send_calls_++;
+    return Api::OsSysCallsImpl::sendmsg(fd, message, flags);
+  }
+  Api::SysCallIntResult sendmmsg(os_fd_t fd, struct mmsghdr* messages, unsigned int vlen,
+                                 int flags) override {
+    send_calls_++;
+    return Api::OsSysCallsImpl::sendmmsg(fd, messages, vlen, flags);
+  }
+
+  uint64_t send_calls_{0};
+};
+
+// Arguments are the number of datagrams written per flush, the datagram size, and the writer: 0
+// for the default writer, 1 for the batch writer using sendmmsg() only and 2 for the batch writer
+// also using GSO where the kernel supports it.
+static void udpWriterThroughput(benchmark::State& state) {
+  const uint64_t datagrams_per_flush = state.range(0);
+  const uint64_t datagram_size = state.range(1);
+  const int64_t writer_type = state.range(2);
+
+  CountingOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  const bool gso = writer_type == 2 && os_sys_calls.supportsUdpGso();
+  if (writer_type == 2 && !gso) {
+    state.SkipWithError("UDP GSO is not supported");
+    return;
+  }
+
+  auto receiver = Test::bindFreeLoopbackPort(Address::IpVersion::v4, Socket::Type::Datagram);
+  auto sender = Test::bindFreeLoopbackPort(Address::IpVersion::v4, Socket::Type::Datagram).second;
+  UdpPacketWriterPtr writer;
+  if (writer_type == 0) {
+    writer = std::make_unique<UdpDefaultWriter>(sender->ioHandle());
+  } else {
+    writer = std::make_unique<UdpBatchWriter>(sender->ioHandle(), gso, os_sys_calls.supportsMmsg());
+  }
+  Buffer::OwnedImpl datagram(std::string(datagram_size, 'a'));
+
+  uint64_t datagrams = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (uint64_t i = 0; i < datagrams_per_flush; i++) {
+      writer->writePacket(datagram, nullptr, *receiver.first);
+    }
+    writer->flush();
+    // The sender is not throttled, so a full socket buffer drops datagrams as it would in Envoy.
+    writer->setWritable();
+    datagrams += datagrams_per_flush;
+  }
+  state.counters["packets_per_second"] = benchmark::Counter(datagrams, benchmark::Counter::kIsRate);
+  state.counters["syscalls_per_packet"] =
+      static_cast<double>(os_sys_calls.send_calls_) / std::max<uint64_t>(datagrams, 1);
+}
+BENCHMARK(udpWriterThroughput)
+    ->ArgsProduct({{1, 16, 64}, {100, 1200}, {0, 1, 2}})
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,211 @@
+#include <string>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/network/udp_batch_writer.h"
+#include "source/common/network/utility.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/network/io_handle.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/network_utility.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+struct SentMessage {
+  std::string data_;
+  std::string peer_;
+  // The GSO segment size, or zero if the message is a single datagram.
+  uint16_t segment_size_;
+  bool has_packet_info_;
+};
+
+SentMessage toSentMessage(const msghdr& message) {
+  SentMessage sent{std::string(static_cast<const char*>(message.msg_iov[0].iov_base),
+                               message.msg_iov[0].iov_len),
+                   "", 0, false};
+  sockaddr_storage peer;
+  memcpy(&peer, message.msg_name, message.msg_namelen);
+  sent.peer_ = Address::addressFromSockAddrOrThrow(peer, message.msg_namelen)->asString();
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(const_cast<msghdr*>(&message)); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&message), cmsg)) {
+    if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_SEGMENT) {
+      memcpy(&sent.segment_size_, CMSG_DATA(cmsg), sizeof(sent.segment_size_));
+    } else if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
+      sent.has_packet_info_ = true;
+    }
+  }
+  return sent;
+}
+
+class UdpBatchWriterTest : public testing::Test {
+public:
+  UdpBatchWriterTest() {
+    ON_CALL(os_sys_calls_, sendmsg(_, _, _))
+        .WillByDefault(Invoke([this](os_fd_t, const msghdr* message, int) {
+          send_calls_++;
+          sent_.push_back(toSentMessage(*message));
+          return Api::SysCallSizeResult{static_cast<ssize_t>(message->msg_iov[0].iov_len), 0};
+        }));
+    ON_CALL(os_sys_calls_, sendmmsg(_, _, _, _))
+        .WillByDefault(Invoke([this](os_fd_t, struct mmsghdr* messages, unsigned int vlen, int) {
+          send_calls_++;
+          for (unsigned int i = 0; i < vlen; i++) {
+            sent_.push_back(toSentMessage(messages[i].msg_hdr));
+          }
+          return Api::SysCallIntResult{static_cast<int>(vlen), 0};
+        }));
+  }
+
+  void write(UdpBatchWriter& writer, const std::string& data, const Address::Instance& peer,
+             const Address::Ip* local_ip = nullptr) {
+    Buffer::OwnedImpl buffer(data);
+    EXPECT_TRUE(writer.writePacket(buffer, local_ip, peer).ok());
+  }
+
+  NiceMock<Api::MockOsSysCalls> os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  NiceMock<MockIoHandle> io_handle_;
+  const Address::Ipv4Instance peer1_{"10.0.0.1", 53};
+  const Address::Ipv4Instance peer2_{"10.0.0.2", 53};
+  uint32_t send_calls_{0};
+  std::vector<SentMessage> sent_;
+};
+
+// Runs of packets to the same destination become GSO messages. A message ends with a shorter
+// packet or a change of destination.
+TEST_F(UdpBatchWriterTest, GsoCoalescesPacketsToTheSameDestination) {
+  UdpBatchWriter writer(io_handle_, true, true);
+  write(writer, "aaaa", peer1_);
+  write(writer, "bbbb", peer1_);
+  write(writer, "cc", peer1_);
+  write(writer, "dddd", peer1_);
+  write(writer, "eeee", peer2_);
+  EXPECT_EQ(5, writer.bufferedPackets());
+  EXPECT_EQ(0, send_calls_);
+
+  const Api::IoCallUint64Result result = writer.flush();
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(18, result.return_value_);
+  EXPECT_EQ(5, writer.lastFlushPacketsSent());
+  EXPECT_EQ(0, writer.bufferedPackets());
+  EXPECT_EQ(1, send_calls_);
+  ASSERT_EQ(3, sent_.size());
+  EXPECT_EQ("aaaabbbbcc", sent_[0].data_);
+  EXPECT_EQ(4, sent_[0].segment_size_);
+  EXPECT_EQ("dddd", sent_[1].data_);
+  EXPECT_EQ(0, sent_[1].segment_size_);
+  EXPECT_EQ(peer1_.asString(), sent_[1].peer_);
+  EXPECT_EQ("eeee", sent_[2].data_);
+  EXPECT_EQ(peer2_.asString(), sent_[2].peer_);
+}
+
+TEST_F(UdpBatchWriterTest, SendmmsgWithoutGso) {
+  UdpBatchWriter writer(io_handle_, false, true);
+  write(writer, "aaaa", peer1_);
+  write(writer, "bbbb", peer1_);
+  write(writer, "cccc", peer2_);
+
+  EXPECT_EQ(12, writer.flush().return_value_);
+  EXPECT_EQ(1, send_calls_);
+  ASSERT_EQ(3, sent_.size());
+  for (const SentMessage& sent : sent_) {
+    EXPECT_EQ(0, sent.segment_size_);
+  }
+}
+
+TEST_F(UdpBatchWriterTest, SendmsgWithoutGsoOrMmsg) {
+  UdpBatchWriter writer(io_handle_, false, false);
+  write(writer, "aaaa", peer1_);
+  write(writer, "bbbb", peer1_);
+
+  EXPECT_CALL(os_sys_calls_, sendmmsg(_, _, _, _)).Times(0);
+  EXPECT_EQ(8, writer.flush().return_value_);
+  EXPECT_EQ(2, send_calls_);
+}
+
+TEST_F(UdpBatchWriterTest, SourceAddressSplitsGsoMessages) {
+  UdpBatchWriter writer(io_handle_, true, true);
+  const Address::Ipv4Instance local1("127.0.0.1");
+  const Address::Ipv4Instance local2("127.0.0.2");
+  write(writer, "aaaa", peer1_, local1.ip());
+  write(writer, "bbbb", peer1_, local1.ip());
+  write(writer, "cccc", peer1_, local2.ip());
+
+  writer.flush();
+  ASSERT_EQ(2, sent_.size());
+  EXPECT_EQ("aaaabbbb", sent_[0].data_);
+  EXPECT_EQ(4, sent_[0].segment_size_);
+  EXPECT_TRUE(sent_[0].has_packet_info_);
+  EXPECT_EQ("cccc", sent_[1].data_);
+  EXPECT_TRUE(sent_[1].has_packet_info_);
+}
+
+// Packets are sent in order, so the ones after a failed send are dropped.
+TEST_F(UdpBatchWriterTest, FailedSendDropsRemainingPackets) {
+  UdpBatchWriter writer(io_handle_, false, true);
+  write(writer, "aaaa", peer1_);
+  write(writer, "bbbb", peer1_);
+  write(writer, "cccc", peer1_);
+
+  EXPECT_CALL(os_sys_calls_, sendmmsg(_, _, 3, _)).WillOnce(Return(Api::SysCallIntResult{1, 0}));
+  EXPECT_CALL(os_sys_calls_, sendmmsg(_, _, 2, _))
+      .WillOnce(Return(Api::SysCallIntResult{-1, SOCKET_ERROR_AGAIN}));
+  const Api::IoCallUint64Result result = writer.flush();
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+  EXPECT_TRUE(writer.isWriteBlocked());
+  EXPECT_EQ(1, writer.lastFlushPacketsSent());
+  EXPECT_EQ(0, writer.bufferedPackets());
+
+  // The next flush starts afresh.
+  write(writer, "dddd", peer1_);
+  EXPECT_CALL(os_sys_calls_, sendmsg(_, _, _)).WillOnce(Return(Api::SysCallSizeResult{4, 0}));
+  EXPECT_EQ(4, writer.flush().return_value_);
+  EXPECT_FALSE(writer.isWriteBlocked());
+  EXPECT_EQ(1, writer.lastFlushPacketsSent());
+}
+
+class UdpBatchWriterLoopbackTest : public testing::TestWithParam<Address::IpVersion> {};
+
+INSTANTIATE_TEST_SUITE_P(IpVersions, UdpBatchWriterLoopbackTest,
+                         testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
+                         TestUtility::ipTestParamsToString);
+
+// The datagrams are received as written, whichever way the kernel was handed them.
+TEST_P(UdpBatchWriterLoopbackTest, WriteAndReceive) {
+  Test::UdpSyncPeer peer(GetParam());
+  auto socket = Test::bindFreeLoopbackPort(GetParam(), Socket::Type::Datagram).second;
+  UdpBatchWriter writer(socket->ioHandle());
+  const std::vector<std::string> datagrams{std::string(1000, 'a'), std::string(1000, 'b'),
+                                           std::string(10, 'c'), "d"};
+  for (const std::string& datagram : datagrams) {
+    Buffer::OwnedImpl buffer(datagram);
+    writer.writePacket(buffer, nullptr, *peer.localAddress());
+  }
+  const Api::IoCallUint64Result result = writer.flush();
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(2011, result.return_value_);
+
+  for (const std::string& datagram : datagrams) {
+    UdpRecvData received;
+    peer.recv(received);
+    EXPECT_EQ(datagram, received.buffer_->toString());
+  }
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
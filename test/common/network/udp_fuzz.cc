@@ -39,6 +39,7 @@ public:
   ~FuzzUdpListenerCallbacks() override = default;
   void onData(Network::UdpRecvData&& data) override;
   void onReadReady() override;
+  void onReadComplete() override;
   void onWriteReady(const Network::Socket& socket) override;
   void onReceiveError(Api::IoError::IoErrorCode error_code) override;
   void onDataWorker(Network::UdpRecvData&& data) override;
@@ -155,6 +156,8 @@ void FuzzUdpListenerCallbacks::onData(Network::UdpRecvData&& data) {
 
 void FuzzUdpListenerCallbacks::onReadReady() {}
 
+void FuzzUdpListenerCallbacks::onReadComplete() {}
+
 void FuzzUdpListenerCallbacks::onWriteReady(const Network::Socket& socket) {
   UNREFERENCED_PARAMETER(socket);
 }
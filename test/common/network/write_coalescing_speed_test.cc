@@ -0,0 +1,91 @@
+// Compares writing a buffer made of many small slices to a socket with and without coalescing the
+// small slices into one iovec. The data is read back after each write, outside of the measurement.
+
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Network {
+
+// Counts the system calls used to write to sockets.
+class CountingOsSysCalls : public Api::OsSysCallsImpl {
+public:
+  Api::SysCallSizeResult writev(os_fd_t fd, const iovec* iov, int num_iov) override {
+    write_calls_++;
+    return Api::OsSysCallsImpl::writev(fd, iov, num_iov);
+  }
+
+  uint64_t write_calls_{0};
+};
+
+// Arguments are 1 to coalesce small slices, the number of slices written at a time and the slice
+// size.
+static void writeManySlices(::benchmark::State& state) {
+  const bool coalesce = state.range(0);
+  const uint64_t num_slices = state.range(1);
+  const uint64_t slice_size = state.range(2);
+
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.coalesce_small_write_slices",
+                               coalesce ? "true" : "false"}});
+  CountingOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+
+  int fds[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+    state.SkipWithError("socketpair() failed");
+    return;
+  }
+  // Deep enough to take a whole buffer in one write.
+  const int buffer_size = 4 * num_slices * slice_size;
+  ::setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+  ::setsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+  IoSocketHandleImpl io_handle(fds[0]);
+  const std::string slice(slice_size, 'a');
+  std::vector<char> read_buffer(num_slices * slice_size);
+
+  uint64_t bytes = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    state.PauseTiming();
+    Buffer::OwnedImpl buffer;
+    for (uint64_t i = 0; i < num_slices; i++) {
+      buffer.appendSliceForTest(slice);
+    }
+    state.ResumeTiming();
+    while (buffer.length() > 0) {
+      bytes += io_handle.write(buffer).return_value_;
+    }
+    state.PauseTiming();
+    size_t to_read = num_slices * slice_size;
+    while (to_read > 0) {
+      const ssize_t rc = ::read(fds[1], read_buffer.data(), to_read);
+      RELEASE_ASSERT(rc > 0, "");
+      to_read -= rc;
+    }
+    state.ResumeTiming();
+  }
+  io_handle.close();
+  ::close(fds[1]);
+
+  state.counters["bytes_per_second"] = ::benchmark::Counter(bytes, ::benchmark::Counter::kIsRate);
+  state.counters["syscalls_per_byte"] =
+      static_cast<double>(os_sys_calls.write_calls_) / std::max<uint64_t>(bytes, 1);
+}
+BENCHMARK(writeManySlices)
+    ->ArgsProduct({{0, 1}, {16, 256}, {16, 128, 4096}})
+    ->Unit(::benchmark::kMicrosecond);
+
+} // namespace Network
+} // namespace Envoy
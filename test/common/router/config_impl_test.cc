@@ -8742,6 +8742,73 @@ virtual_hosts:
   }
 }
 
+// The compiled route index must preserve first-match semantics across prefix, exact, regex,
+// header-constrained and case-insensitive routes.
+TEST_F(RouteMatcherTest, CompiledRouteIndex) {
+  mergeValues({{"envoy.reloadable_features.router_compiled_route_index", "true"}});
+
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: indexed
+    domains: ["*"]
+    routes:
+      - match:
+          prefix: "/api"
+          headers:
+          - name: x-canary
+            string_match:
+              exact: "true"
+        route: { cluster: canary}
+      - match:
+          path: "/api/health"
+        route: { cluster: health}
+      - match:
+          safe_regex:
+            regex: "^/api/v[0-9]+/users/admin$"
+        route: { cluster: admin}
+      - match:
+          prefix: "/api/v1/users"
+        route: { cluster: users}
+      - match:
+          path_separated_prefix: "/api/v2"
+        route: { cluster: v2}
+      - match:
+          prefix: "/Static"
+          case_sensitive: false
+        route: { cluster: static}
+      - match:
+          path: "/api/v1/users/me"
+        route: { cluster: shadowed}
+      - match:
+          prefix: "/api"
+        route: { cluster: api}
+      - match:
+          prefix: "/"
+        route: { cluster: default}
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"canary", "health", "admin", "users", "v2", "static", "shadowed", "api", "default"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+
+  auto cluster = [&config](Http::TestRequestHeaderMapImpl headers) {
+    return config.route(headers, 0)->routeEntry()->clusterName();
+  };
+
+  EXPECT_EQ("health", cluster(genHeaders("www.lyft.com", "/api/health?verbose=1", "GET")));
+  EXPECT_EQ("admin", cluster(genHeaders("www.lyft.com", "/api/v1/users/admin", "GET")));
+  EXPECT_EQ("users", cluster(genHeaders("www.lyft.com", "/api/v1/users/me", "GET")));
+  EXPECT_EQ("v2", cluster(genHeaders("www.lyft.com", "/api/v2/things", "GET")));
+  EXPECT_EQ("api", cluster(genHeaders("www.lyft.com", "/api/v2things", "GET")));
+  EXPECT_EQ("static", cluster(genHeaders("www.lyft.com", "/static/app.js", "GET")));
+  EXPECT_EQ("default", cluster(genHeaders("www.lyft.com", "/other", "GET")));
+
+  Http::TestRequestHeaderMapImpl canary = genHeaders("www.lyft.com", "/api/health", "GET");
+  canary.addCopy("x-canary", "true");
+  EXPECT_EQ("canary", cluster(canary));
+}
+
 TEST_F(RouteMatcherTest, PathSeparatedPrefixMatch) {
 
   const std::string yaml = R"EOF(
@@ -0,0 +1,94 @@
+#include <vector>
+
+#include "source/common/router/route_index.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+std::vector<uint32_t> candidates(const CompiledRouteIndex& index, absl::string_view path) {
+  std::vector<uint32_t> result;
+  index.forEachCandidate(path, [&result](uint32_t ordinal) {
+    result.push_back(ordinal);
+    return true;
+  });
+  return result;
+}
+
+TEST(CompiledRouteIndexTest, Empty) {
+  CompiledRouteIndex index;
+  EXPECT_EQ(0, index.size());
+  EXPECT_THAT(candidates(index, "/"), IsEmpty());
+  EXPECT_THAT(candidates(index, ""), IsEmpty());
+}
+
+TEST(CompiledRouteIndexTest, PrefixesAlongPath) {
+  CompiledRouteIndex index;
+  index.addPrefix("/foo/bar", 0);
+  index.addPrefix("/foo", 1);
+  index.addPrefix("/foobar", 2);
+  index.addPrefix("/", 3);
+  index.addPrefix("", 4);
+  index.addPrefix("/baz", 5);
+  EXPECT_EQ(6, index.size());
+
+  EXPECT_THAT(candidates(index, "/foo/bar/baz"), ElementsAre(0, 1, 3, 4));
+  EXPECT_THAT(candidates(index, "/foobar"), ElementsAre(1, 2, 3, 4));
+  EXPECT_THAT(candidates(index, "/fo"), ElementsAre(3, 4));
+  EXPECT_THAT(candidates(index, "/baz"), ElementsAre(3, 4, 5));
+  EXPECT_THAT(candidates(index, "nope"), ElementsAre(4));
+  EXPECT_THAT(candidates(index, ""), ElementsAre(4));
+}
+
+// Inserting a shorter prefix after a longer one splits the existing edge.
+TEST(CompiledRouteIndexTest, EdgeSplit) {
+  CompiledRouteIndex index;
+  index.addPrefix("/api/v1/users", 0);
+  index.addPrefix("/api/v2", 1);
+  index.addPrefix("/api", 2);
+  index.addPrefix("/api/v1/users", 3);
+
+  EXPECT_THAT(candidates(index, "/api/v1/users/7"), ElementsAre(0, 2, 3));
+  EXPECT_THAT(candidates(index, "/api/v1/user"), ElementsAre(2));
+  EXPECT_THAT(candidates(index, "/api/v2/x"), ElementsAre(1, 2));
+  EXPECT_THAT(candidates(index, "/ap"), IsEmpty());
+}
+
+TEST(CompiledRouteIndexTest, ExactAndFallbackMergeInOrder) {
+  CompiledRouteIndex index;
+  index.addFallback(0);
+  index.addExact("/health", 1);
+  index.addPrefix("/", 2);
+  index.addExact("/health", 3);
+  index.addFallback(4);
+  index.addExact("/other", 5);
+
+  EXPECT_THAT(candidates(index, "/health"), ElementsAre(0, 1, 2, 3, 4));
+  EXPECT_THAT(candidates(index, "/health/x"), ElementsAre(0, 2, 4));
+  EXPECT_THAT(candidates(index, "/other"), ElementsAre(0, 2, 4, 5));
+  EXPECT_THAT(candidates(index, "x"), ElementsAre(0, 4));
+}
+
+TEST(CompiledRouteIndexTest, StopsWhenCallbackReturnsFalse) {
+  CompiledRouteIndex index;
+  index.addPrefix("/a", 0);
+  index.addPrefix("/", 1);
+  index.addFallback(2);
+
+  std::vector<uint32_t> seen;
+  index.forEachCandidate("/a", [&seen](uint32_t ordinal) {
+    seen.push_back(ordinal);
+    return ordinal != 1;
+  });
+  EXPECT_THAT(seen, ElementsAre(0, 1));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -154,6 +154,28 @@ TEST_F(AllocatorImplTest, HiddenGauge) {
   EXPECT_FALSE(never_import_hidden_gauge->hidden());
 }
 
+TEST_F(AllocatorImplTest, GaugeLatchChanged) {
+  GaugeSharedPtr gauge =
+      alloc_.makeGauge(makeStat("gauge"), StatName(), {}, Gauge::ImportMode::HiddenAccumulate);
+  EXPECT_FALSE(gauge->latchChanged());
+
+  gauge->set(5);
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+
+  gauge->inc();
+  gauge->dec();
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+
+  gauge->setParentValue(3);
+  EXPECT_TRUE(gauge->latchChanged());
+
+  // Latching leaves the other flags alone.
+  EXPECT_TRUE(gauge->used());
+  EXPECT_TRUE(gauge->hidden());
+}
+
 TEST_F(AllocatorImplTest, ForEachCounter) {
   StatNameHashSet stat_names;
   std::vector<CounterSharedPtr> counters;
@@ -1,3 +1,5 @@
+#include <atomic>
+#include <functional>
 #include <string>
 
 #include "source/common/common/macros.h"
@@ -42,6 +44,12 @@ protected:
     return TestUtil::serializeDeserializeNumber(number);
   }
 
+  // Calls fn with the table's lock held.
+  void withTableLocked(const std::function<void()>& fn) {
+    Thread::LockGuard lock(table_.lock_);
+    fn();
+  }
+
   SymbolTableImpl table_;
   StatNamePool pool_;
 };
@@ -624,6 +632,56 @@ TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
   }
 }
 
+TEST_F(StatNameTest, DecodeWithoutLock) {
+  StatName a_b_c = makeStat("a.b.c");
+  StatName a_b_d = makeStat("a.b.d");
+
+  // Decoding and comparing names would deadlock if they took the lock.
+  withTableLocked([this, a_b_c, a_b_d]() {
+    EXPECT_EQ("a.b.c", table_.toString(a_b_c));
+    EXPECT_TRUE(table_.lessThan(a_b_c, a_b_d));
+    EXPECT_FALSE(table_.lessThan(a_b_d, a_b_c));
+  });
+}
+
+TEST_F(StatNameTest, DecodeWhileAddingAndRemovingSymbols) {
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+
+  std::vector<std::string> strings;
+  std::vector<StatName> names;
+  for (int i = 0; i < 100; ++i) {
+    strings.push_back(absl::StrCat("held", i, ".name"));
+    names.push_back(makeStat(strings.back()));
+  }
+
+  // One thread adds and removes thousands of symbols, growing the table well past its first
+  // chunk, while the others decode the names held above.
+  std::atomic<bool> done{false};
+  std::vector<Thread::ThreadPtr> threads;
+  threads.push_back(thread_factory.createThread([this, &done]() {
+    for (int round = 0; round < 20; ++round) {
+      StatNamePool pool(table_);
+      for (int i = 0; i < 1000; ++i) {
+        pool.add(absl::StrCat("churn", round, ".", i));
+      }
+    }
+    done = true;
+  }));
+  for (int i = 0; i < 4; ++i) {
+    threads.push_back(thread_factory.createThread([this, &done, &strings, &names]() {
+      while (!done) {
+        for (size_t j = 0; j < names.size(); ++j) {
+          EXPECT_EQ(strings[j], table_.toString(names[j]));
+        }
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+  EXPECT_EQ(101, table_.numSymbols());
+}
+
 TEST_F(StatNameTest, SharedStatNameStorageSetInsertAndFind) {
   StatNameStorageSet set;
   const int iters = 10;
@@ -3,6 +3,8 @@
 //
 // NOLINT(namespace-envoy)
 
+#include <atomic>
+
 #include "source/common/common/hash.h"
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
@@ -213,3 +215,38 @@ static void bmSetStrings(benchmark::State& state) {
   }
 }
 BENCHMARK(bmSetStrings);
+
+// Decodes names to strings, as admin stats dumps and stats sinks do, while
+// another thread keeps adding and removing symbols, as creating and destroying
+// stats on workers does. The argument is 1 to run that other thread.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmToStringWhileCreating(benchmark::State& state) {
+  Envoy::Stats::SymbolTableImpl symbol_table;
+  Envoy::Stats::StatNamePool pool(symbol_table);
+  const std::vector<Envoy::Stats::StatName> names = prepareNames(pool, 1000);
+
+  std::atomic<bool> done{false};
+  Envoy::Thread::ThreadPtr creator;
+  if (state.range(0) == 1) {
+    creator = Envoy::Thread::threadFactoryForTest().createThread([&symbol_table, &done]() {
+      for (uint64_t count = 0; !done; ++count) {
+        // NOLINTNEXTLINE(clang-analyzer-unix.Malloc)
+        Envoy::Stats::StatNameStorage storage(absl::StrCat("dynamic.stat", count % 1000),
+                                              symbol_table);
+        storage.free(symbol_table);
+      }
+    });
+  }
+
+  size_t index = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    benchmark::DoNotOptimize(symbol_table.toString(names[index++ % names.size()]));
+  }
+
+  done = true;
+  if (creator != nullptr) {
+    creator->join();
+  }
+}
+BENCHMARK(bmToStringWhileCreating)->Arg(0)->Arg(1);
@@ -66,6 +66,27 @@ public:
     store_.initializeThreading(*dispatcher_, *tls_);
   }
 
+  void initHistograms(uint32_t num_histograms) {
+    Stats::Scope& scope = *store_.rootScope();
+    histograms_.reserve(num_histograms);
+    for (uint32_t i = 0; i < num_histograms; ++i) {
+      histograms_.push_back(&scope.histogramFromString(absl::StrCat("histogram.", i),
+                                                       Stats::Histogram::Unit::Milliseconds));
+    }
+  }
+
+  // Records into the first num_recorded histograms and runs one merge to completion.
+  void recordAndMerge(uint32_t num_recorded) {
+    for (uint32_t i = 0; i < num_recorded; ++i) {
+      histograms_[i]->recordValue(i);
+    }
+    bool merged = false;
+    store_.mergeHistograms([&merged]() { merged = true; });
+    while (!merged) {
+      dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+    }
+  }
+
   void initPrefixRejections(const std::string& prefix) {
     stats_config_.mutable_stats_matcher()->mutable_exclusion_list()->add_patterns()->set_prefix(
         prefix);
@@ -84,6 +105,7 @@ private:
   Api::ApiPtr api_;
   envoy::config::metrics::v3::StatsConfig stats_config_;
   std::vector<std::unique_ptr<Stats::StatNameManagedStorage>> stat_names_;
+  std::vector<Stats::Histogram*> histograms_;
 };
 
 } // namespace Envoy
@@ -140,3 +162,18 @@ BENCHMARK(BM_StatsWithTlsAndRejectionsWithoutDot);
 
 // TODO(jmarantz): add multi-threaded variant of this test, that aggressively
 // looks up stats in multiple threads to try to trigger contention issues.
+
+// Measures a histogram merge over 100k histograms, of which state.range(0) were recorded into
+// during the interval.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_HistogramMerge(benchmark::State& state) {
+  Envoy::ThreadLocalStorePerf context;
+  context.initThreading();
+  context.initHistograms(100000);
+  const uint32_t num_recorded = state.range(0);
+
+  for (auto _ : state) { // NOLINT
+    context.recordAndMerge(num_recorded);
+  }
+}
+BENCHMARK(BM_HistogramMerge)->Arg(0)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
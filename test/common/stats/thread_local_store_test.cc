@@ -36,6 +36,7 @@
 using testing::_;
 using testing::HasSubstr;
 using testing::InSequence;
+using testing::IsEmpty;
 using testing::NiceMock;
 using testing::Ref;
 using testing::Return;
@@ -1799,6 +1800,41 @@ TEST_F(HistogramTest, BasicHistogramUsed) {
   }
 }
 
+// Histograms that were not recorded into during an interval are skipped by the merge, except
+// for one merge that clears the interval data left from the previous interval.
+TEST_F(HistogramTest, IdleHistogramIntervalCleared) {
+  Histogram& h1 = scope_.histogramFromString("h1", Histogram::Unit::Unspecified);
+  Histogram& h2 = scope_.histogramFromString("h2", Histogram::Unit::Unspecified);
+  NameHistogramMap name_histogram_map = makeHistogramMap(store_->histograms());
+
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(h1), 10));
+  h1.recordValue(10);
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(h2), 20));
+  h2.recordValue(20);
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_THAT(name_histogram_map["h1"]->detailedIntervalBuckets(),
+              UnorderedElementsAre(Bucket{10, 1, 1}));
+
+  // Only h2 is recorded into, but h1 still has its interval data cleared.
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(h2), 20));
+  h2.recordValue(20);
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_THAT(name_histogram_map["h1"]->detailedIntervalBuckets(), IsEmpty());
+  EXPECT_THAT(name_histogram_map["h1"]->detailedTotalBuckets(),
+              UnorderedElementsAre(Bucket{10, 1, 1}));
+  EXPECT_THAT(name_histogram_map["h2"]->detailedIntervalBuckets(),
+              UnorderedElementsAre(Bucket{20, 1, 1}));
+  EXPECT_THAT(name_histogram_map["h2"]->detailedTotalBuckets(),
+              UnorderedElementsAre(Bucket{20, 1, 2}));
+
+  // Nothing is recorded; both stay used and keep their cumulative data.
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_TRUE(name_histogram_map["h1"]->used());
+  EXPECT_THAT(name_histogram_map["h2"]->detailedIntervalBuckets(), IsEmpty());
+  EXPECT_THAT(name_histogram_map["h2"]->detailedTotalBuckets(),
+              UnorderedElementsAre(Bucket{20, 1, 2}));
+}
+
 TEST_F(HistogramTest, ParentHistogramBucketSummaryAndDetail) {
   ScopeSharedPtr scope1 = store_->createScope("scope1.");
   Histogram& histogram = scope_.histogramFromString("histogram", Histogram::Unit::Unspecified);
@@ -1175,6 +1175,18 @@ TEST_F(ClientContextConfigImplTest, EmptyServerNameIndication) {
       "SNI names containing NULL-byte are not allowed");
 }
 
+// Validate that renegotiation cannot be allowed together with kernel TLS offload.
+TEST_F(ClientContextConfigImplTest, KernelTlsOffloadWithRenegotiation) {
+  envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext tls_context;
+  NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context;
+
+  tls_context.mutable_common_tls_context()->set_kernel_tls_offload(true);
+  tls_context.set_allow_renegotiation(true);
+  EXPECT_THROW_WITH_MESSAGE(
+      ClientContextConfigImpl client_context_config(tls_context, factory_context), EnvoyException,
+      "kernel_tls_offload cannot be used with allow_renegotiation");
+}
+
 // Validate that values other than a hex-encoded SHA-256 fail config validation.
 TEST_F(ClientContextConfigImplTest, InvalidCertificateHash) {
   envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext tls_context;
@@ -0,0 +1,34 @@
+#include <cstdint>
+#include <vector>
+
+#include "source/common/tls/kernel_tls.h"
+
+#include "gtest/gtest.h"
+#include "openssl/digest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+// The derivation of the server handshake write key and IV in the simple 1-RTT handshake of
+// RFC 8448 section 3.
+TEST(KernelTlsTest, HkdfExpandLabel) {
+  const std::vector<uint8_t> secret = {0xb6, 0x7b, 0x7d, 0x69, 0x0c, 0xc1, 0x6c, 0x4e,
+                                       0x75, 0xe5, 0x42, 0x13, 0xcb, 0x2d, 0x37, 0xb4,
+                                       0xe9, 0xc9, 0x12, 0xbc, 0xde, 0xd9, 0x10, 0x5d,
+                                       0x42, 0xbe, 0xfd, 0x59, 0xd3, 0x91, 0xad, 0x38};
+  EXPECT_EQ((std::vector<uint8_t>{0x3f, 0xce, 0x51, 0x60, 0x09, 0xc2, 0x17, 0x27, 0xd0, 0xf2,
+                                  0xe4, 0xe8, 0x6e, 0xe4, 0x03, 0xbc}),
+            KernelTls::hkdfExpandLabel(EVP_sha256(), secret, "key", 16));
+  EXPECT_EQ((std::vector<uint8_t>{0x5d, 0x31, 0x3e, 0xb2, 0x67, 0x12, 0x76, 0xee, 0x13, 0x00,
+                                  0x0b, 0x30}),
+            KernelTls::hkdfExpandLabel(EVP_sha256(), secret, "iv", 12));
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -7,6 +7,7 @@
 #include "envoy/extensions/transport_sockets/tls/v3/cert.pb.h"
 #include "envoy/network/transport_socket.h"
 
+#include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/event/dispatcher_impl.h"
@@ -56,14 +57,30 @@
 #include "test/test_common/network_utility.h"
 #include "test/test_common/registry.h"
 #include "test/test_common/test_runtime.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
+#include "absl/algorithm/container.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_replace.h"
+#include "absl/strings/str_split.h"
 #include "absl/types/optional.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "openssl/ssl.h"
 
+#ifdef __linux__
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
 using testing::_;
 using testing::ContainsRegex;
 using testing::DoAll;
@@ -5919,6 +5936,8 @@ protected:
   void initialize() {
     TestUtility::loadFromYaml(TestEnvironment::substitute(server_ctx_yaml_),
                               downstream_tls_context_);
+    downstream_tls_context_.mutable_common_tls_context()->set_kernel_tls_offload(
+        server_kernel_tls_offload_);
     auto server_cfg =
         std::make_unique<ServerContextConfigImpl>(downstream_tls_context_, factory_context_);
     manager_ = std::make_unique<ContextManagerImpl>(factory_context_.serverFactoryContext());
@@ -5934,6 +5953,11 @@ protected:
                                overload_state, *dispatcher_);
 
     TestUtility::loadFromYaml(TestEnvironment::substitute(client_ctx_yaml_), upstream_tls_context_);
+    upstream_tls_context_.mutable_common_tls_context()->set_kernel_tls_offload(
+        client_kernel_tls_offload_);
+    upstream_tls_context_.mutable_common_tls_context()
+        ->mutable_tls_params()
+        ->set_tls_maximum_protocol_version(client_tls_max_version_);
     auto client_cfg =
         std::make_unique<ClientContextConfigImpl>(upstream_tls_context_, factory_context_);
 
@@ -6067,6 +6091,21 @@ protected:
     disconnect();
   }
 
+  // Whether the kernel of the test host was expected to take over the encryption of the writes
+  // of a connection: it uses AES-GCM and the kernel has the tls module. Offloading loads the
+  // module on demand, so this is only known after the connection was made.
+  bool kernelTlsOffloadExpected(const Network::Connection& connection) {
+    const absl::StatusOr<std::string> ulps =
+        api_->fileSystem().fileReadToEnd("/proc/sys/net/ipv4/tcp_available_ulp");
+    if (!ulps.ok()) {
+      return false;
+    }
+    const std::vector<absl::string_view> names =
+        absl::StrSplit(*ulps, absl::ByAnyChar(" \n"), absl::SkipEmpty());
+    return absl::c_linear_search(names, "tls") &&
+           absl::StrContains(connection.ssl()->ciphersuiteString(), "GCM");
+  }
+
   void disconnect() {
     EXPECT_CALL(client_callbacks_, onEvent(Network::ConnectionEvent::LocalClose));
     EXPECT_CALL(server_callbacks_, onEvent(Network::ConnectionEvent::RemoteClose))
@@ -6116,6 +6155,11 @@ protected:
   std::shared_ptr<Network::MockReadFilter> read_filter_;
   StrictMock<Network::MockConnectionCallbacks> client_callbacks_;
   Network::Address::InstanceConstSharedPtr source_address_;
+  bool server_kernel_tls_offload_{false};
+  bool client_kernel_tls_offload_{false};
+  envoy::extensions::transport_sockets::tls::v3::TlsParameters::TlsProtocol
+      client_tls_max_version_{
+          envoy::extensions::transport_sockets::tls::v3::TlsParameters::TLS_AUTO};
 };
 
 INSTANTIATE_TEST_SUITE_P(IpVersions, SslReadBufferLimitTest,
@@ -6174,6 +6218,113 @@ TEST_P(SslReadBufferLimitTest, TestBind) {
   disconnect();
 }
 
+// Whether the kernel of the test host can take over the encryption of writes or not, data written
+// by the client reaches the server, and the close_notify of the server reaches the client.
+TEST_P(SslReadBufferLimitTest, KernelTlsOffload) {
+  server_kernel_tls_offload_ = true;
+  client_kernel_tls_offload_ = true;
+  readBufferLimitTest(0, 256 * 1024, 256 * 1024, 1, false);
+  const uint64_t expected_offloaded = kernelTlsOffloadExpected(*client_connection_) ? 1 : 0;
+  EXPECT_EQ(expected_offloaded, client_stats_store_.counter("ssl.kernel_tls_tx_offloaded").value());
+  EXPECT_EQ(1UL, client_stats_store_.counter("ssl.kernel_tls_tx_offloaded").value() +
+                     client_stats_store_.counter("ssl.kernel_tls_tx_unavailable").value());
+  EXPECT_EQ(expected_offloaded, server_stats_store_.counter("ssl.kernel_tls_tx_offloaded").value());
+  EXPECT_EQ(1UL, server_stats_store_.counter("ssl.kernel_tls_tx_offloaded").value() +
+                     server_stats_store_.counter("ssl.kernel_tls_tx_unavailable").value());
+}
+
+TEST_P(SslReadBufferLimitTest, KernelTlsOffloadTls13) {
+  server_kernel_tls_offload_ = true;
+  client_kernel_tls_offload_ = true;
+  client_tls_max_version_ = envoy::extensions::transport_sockets::tls::v3::TlsParameters::TLSv1_3;
+  readBufferLimitTest(0, 256 * 1024, 1, 256 * 1024, false);
+  const uint64_t expected_offloaded = kernelTlsOffloadExpected(*client_connection_) ? 1 : 0;
+  EXPECT_EQ(expected_offloaded, client_stats_store_.counter("ssl.kernel_tls_tx_offloaded").value());
+  EXPECT_EQ(1UL, client_stats_store_.counter("ssl.kernel_tls_tx_offloaded").value() +
+                     client_stats_store_.counter("ssl.kernel_tls_tx_unavailable").value());
+  EXPECT_EQ(expected_offloaded, server_stats_store_.counter("ssl.kernel_tls_tx_offloaded").value());
+}
+
+#ifdef __linux__
+// Pretends the kernel took over the encryption of writes without touching the socket, and fails
+// to send close_notify alerts, the only messages sent with a control message. Whatever else the
+// socket writes afterwards goes out unencrypted.
+class FakeKernelTlsOsSysCalls : public Api::OsSysCallsImpl {
+public:
+  Api::SysCallIntResult setsockopt(os_fd_t sockfd, int level, int optname, const void* optval,
+                                   socklen_t optlen) override {
+    if ((level == IPPROTO_TCP && optname == TCP_ULP) || level == SOL_TLS) {
+      return {0, 0};
+    }
+    return Api::OsSysCallsImpl::setsockopt(sockfd, level, optname, optval, optlen);
+  }
+
+  Api::SysCallSizeResult sendmsg(os_fd_t fd, const msghdr* message, int flags) override {
+    if (message->msg_controllen > 0) {
+      return {-1, SOCKET_ERROR_AGAIN};
+    }
+    return Api::OsSysCallsImpl::sendmsg(fd, message, flags);
+  }
+};
+
+// Once the kernel encrypts the writes, a TLS 1.3 key update request of the peer cannot be
+// answered, so the connection is closed. As close_notify cannot be sent either, the write side is
+// shut down instead.
+TEST_P(SslReadBufferLimitTest, KernelTlsOffloadKeyUpdate) {
+  FakeKernelTlsOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  server_kernel_tls_offload_ = true;
+  client_tls_max_version_ = envoy::extensions::transport_sockets::tls::v3::TlsParameters::TLSv1_3;
+  initialize();
+
+  EXPECT_CALL(listener_callbacks_, onAccept_(_))
+      .WillOnce(Invoke([&](Network::ConnectionSocketPtr& socket) -> void {
+        server_connection_ = dispatcher_->createServerConnection(
+            std::move(socket), server_ssl_socket_factory_->createDownstreamTransportSocket(),
+            stream_info_);
+        server_connection_->addConnectionCallbacks(server_callbacks_);
+        server_connection_->addReadFilter(read_filter_);
+      }));
+  EXPECT_CALL(listener_callbacks_, recordConnectionsAcceptedOnSocketEvent(_));
+  EXPECT_CALL(*read_filter_, onNewConnection());
+  EXPECT_CALL(*read_filter_, onData(_, _)).Times(testing::AnyNumber());
+
+  // Wait for the server to complete the handshake too, so that it has offloaded its writes.
+  uint32_t connected = 0;
+  const auto on_connected = [&](Network::ConnectionEvent) -> void {
+    if (++connected == 2) {
+      dispatcher_->exit();
+    }
+  };
+  EXPECT_CALL(client_callbacks_, onEvent(Network::ConnectionEvent::Connected))
+      .WillOnce(Invoke(on_connected));
+  EXPECT_CALL(server_callbacks_, onEvent(Network::ConnectionEvent::Connected))
+      .WillOnce(Invoke(on_connected));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(1UL, server_stats_store_.counter("ssl.kernel_tls_tx_offloaded").value());
+
+  // The key update request goes out with the next write.
+  const SslHandshakerImpl* client_ssl =
+      dynamic_cast<const SslHandshakerImpl*>(client_connection_->ssl().get());
+  ASSERT_EQ(1, SSL_key_update(client_ssl->ssl(), SSL_KEY_UPDATE_REQUESTED));
+  EXPECT_CALL(server_callbacks_, onEvent(Network::ConnectionEvent::RemoteClose));
+  EXPECT_CALL(client_callbacks_, onEvent(Network::ConnectionEvent::RemoteClose))
+      .WillOnce(Invoke([&](Network::ConnectionEvent) -> void { dispatcher_->exit(); }));
+  Buffer::OwnedImpl data("hello");
+  client_connection_->write(data, false);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_EQ(1UL, server_stats_store_.counter("ssl.kernel_tls_tx_record_dropped").value());
+  EXPECT_EQ(1UL, server_stats_store_.counter("ssl.kernel_tls_tx_close_notify_failed").value());
+}
+#endif
+
+TEST_P(SslReadBufferLimitTest, NoKernelTlsOffloadByDefault) {
+  readBufferLimitTest(0, 256 * 1024, 256 * 1024, 1, false);
+  EXPECT_EQ(0UL, client_stats_store_.counter("ssl.kernel_tls_tx_offloaded").value());
+  EXPECT_EQ(0UL, client_stats_store_.counter("ssl.kernel_tls_tx_unavailable").value());
+}
+
 // Regression test for https://github.com/envoyproxy/envoy/issues/6617
 TEST_P(SslReadBufferLimitTest, SmallReadsIntoSameSlice) {
   // write_size * num_writes must be large enough to cause buffer reserving fragmentation,
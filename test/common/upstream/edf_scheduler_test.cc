@@ -99,6 +99,61 @@ TEST_F(EdfSchedulerTest, Weighted) {
   }
 }
 
+// Validate that weights updated in place take effect right away and keep the schedule's position.
+TEST_F(EdfSchedulerTest, UpdateWeights) {
+  EdfScheduler<uint32_t> sched;
+  constexpr uint32_t num_entries = 4;
+  std::vector<std::shared_ptr<uint32_t>> entries;
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries.push_back(std::make_shared<uint32_t>(i));
+    sched.add(1, entries[i]);
+  }
+  // Entries 0 and 1 are picked and have a full period left, entries 2 and 3 have none left.
+  EXPECT_EQ(0, *sched.pickAndAdd([](const uint32_t&) { return 1; }));
+  EXPECT_EQ(1, *sched.pickAndAdd([](const uint32_t&) { return 1; }));
+
+  // Weight each entry by its value plus one. Entry 1 still has a full period left, now 1/2, so
+  // entry 3 with a period of 1/4 is picked twice first.
+  const auto weight = [](const uint32_t& entry) -> double { return entry + 1; };
+  EXPECT_TRUE(sched.updateWeights(entries, weight));
+  for (const uint32_t expected : {2, 3, 3, 2, 1}) {
+    EXPECT_EQ(expected, *sched.pickAndAdd(weight));
+  }
+
+  uint32_t pick_count[num_entries] = {0};
+  for (uint32_t i = 0; i < 10 * (num_entries * (1 + num_entries)) / 2; ++i) {
+    ++pick_count[*sched.pickAndAdd(weight)];
+  }
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    EXPECT_NEAR(10 * (i + 1), pick_count[i], 1);
+  }
+}
+
+// Validate that weights are not updated if the scheduler holds other entries.
+TEST_F(EdfSchedulerTest, UpdateWeightsDifferentEntries) {
+  EdfScheduler<uint32_t> sched;
+  std::vector<std::shared_ptr<uint32_t>> entries = {std::make_shared<uint32_t>(0),
+                                                    std::make_shared<uint32_t>(1)};
+  sched.add(1, entries[0]);
+  sched.add(2, entries[1]);
+  const auto weight = [](const uint32_t&) -> double { return 1; };
+
+  // An entry that is not in the scheduler.
+  EXPECT_FALSE(sched.updateWeights({entries[0], std::make_shared<uint32_t>(1)}, weight));
+  // A missing entry.
+  EXPECT_FALSE(sched.updateWeights({entries[0]}, weight));
+  // The same entry twice.
+  EXPECT_FALSE(sched.updateWeights({entries[0], entries[0]}, weight));
+
+  // Nothing changed.
+  EXPECT_EQ(1, *sched.pickAndAdd([](const uint32_t& entry) { return entry + 1; }));
+  EXPECT_EQ(0, *sched.pickAndAdd([](const uint32_t& entry) { return entry + 1; }));
+
+  // An expired entry.
+  entries[1].reset();
+  EXPECT_FALSE(sched.updateWeights({entries[0], std::make_shared<uint32_t>(1)}, weight));
+}
+
 // Validate that expired entries are ignored.
 TEST_F(EdfSchedulerTest, Expired) {
   EdfScheduler<uint32_t> sched;
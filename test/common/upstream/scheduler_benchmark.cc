@@ -159,6 +159,54 @@ void uniqueWeightPickWRSQ(::benchmark::State& state) {
                             });
 }
 
+std::vector<std::shared_ptr<SchedulerTester::ObjInfo>> makeUniqueWeights(size_t num_objs) {
+  std::vector<std::shared_ptr<SchedulerTester::ObjInfo>> info;
+  for (uint32_t i = 0; i < num_objs; ++i) {
+    auto oi = std::make_shared<SchedulerTester::ObjInfo>();
+    oi->weight = static_cast<double>(i + 1);
+    info.emplace_back(oi);
+  }
+  std::shuffle(info.begin(), info.end(), std::default_random_engine());
+  return info;
+}
+
+// Builds a schedule for all the objects at once, as the load balancers do on host updates.
+void uniqueWeightCreateEdf(::benchmark::State& state) {
+  const auto info = makeUniqueWeights(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    auto edf = EdfScheduler<SchedulerTester::ObjInfo>::createWithPicks(
+        info, [](const auto& i) { return i.weight; }, info.size() / 2);
+    benchmark::DoNotOptimize(edf);
+  }
+}
+
+// Updates the weights of all the objects of an existing schedule in place.
+void uniqueWeightUpdateWeightsEdf(::benchmark::State& state) {
+  const auto info = makeUniqueWeights(state.range(0));
+  auto edf = EdfScheduler<SchedulerTester::ObjInfo>::createWithPicks(
+      info, [](const auto& i) { return i.weight; }, info.size() / 2);
+  uint32_t update = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    ++update;
+    const bool updated = edf.updateWeights(
+        info, [update](const auto& i) { return i.weight + (update % 2 == 0 ? 1 : 2); });
+    benchmark::DoNotOptimize(updated);
+  }
+}
+
+// Adds all the objects to a new WRSQ scheduler and picks once, which builds its queue weights.
+void uniqueWeightCreateWRSQ(::benchmark::State& state) {
+  Random::RandomGeneratorImpl random;
+  const auto info = makeUniqueWeights(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    WRSQScheduler<SchedulerTester::ObjInfo> wrsq(random);
+    for (const auto& oi : info) {
+      wrsq.add(oi->weight, oi);
+    }
+    benchmark::DoNotOptimize(wrsq.pickAndAdd([](const auto& i) { return i.weight; }));
+  }
+}
+
 BENCHMARK(splitWeightAddEdf)
     ->Unit(::benchmark::kMicrosecond)
     ->RangeMultiplier(8)
@@ -179,6 +227,12 @@ BENCHMARK(uniqueWeightAddWRSQ)
     ->Range(1 << 6, 1 << 14);
 BENCHMARK(uniqueWeightPickEdf)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
 BENCHMARK(uniqueWeightPickWRSQ)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
+// Schedules for a cluster of 10k hosts.
+BENCHMARK(uniqueWeightCreateEdf)->Unit(::benchmark::kMicrosecond)->Arg(10000);
+BENCHMARK(uniqueWeightUpdateWeightsEdf)->Unit(::benchmark::kMicrosecond)->Arg(10000);
+BENCHMARK(uniqueWeightCreateWRSQ)->Unit(::benchmark::kMicrosecond)->Arg(10000);
+BENCHMARK(uniqueWeightPickEdf)->Arg(10000);
+BENCHMARK(uniqueWeightPickWRSQ)->Arg(10000);
 
 } // namespace
 } // namespace Upstream
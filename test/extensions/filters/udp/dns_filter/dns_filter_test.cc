@@ -606,6 +606,28 @@ TEST_F(DnsFilterTest, SingleTypeAQuery) {
   EXPECT_TRUE(config_->stats().downstream_tx_bytes_.used());
 }
 
+TEST_F(DnsFilterTest, ResponsesFlushedOnceReadBatchIsComplete) {
+  setup(forward_query_off_config);
+
+  const std::string query =
+      Utils::buildQueryForDomain("www.foo3.com", DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN);
+  ASSERT_FALSE(query.empty());
+
+  uint32_t flushes = 0;
+  EXPECT_CALL(callbacks_.udp_listener_, flush())
+      .WillRepeatedly(Invoke([&flushes]() -> Api::IoCallUint64Result {
+        flushes++;
+        return makeNoError(0);
+      }));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  sendQueryFromClient("10.0.0.2:1000", query);
+  EXPECT_EQ(2, config_->stats().downstream_tx_responses_.value());
+  EXPECT_EQ(0, flushes);
+
+  filter_->onReadComplete();
+  EXPECT_EQ(1, flushes);
+}
+
 TEST_F(DnsFilterTest, NoHostForSingleTypeAQuery) {
   InSequence s;
 
@@ -242,13 +242,16 @@ public:
   }
 
   void recvDataFromDownstream(const std::string& peer_address, const std::string& local_address,
-                              const std::string& buffer) {
+                              const std::string& buffer, bool read_complete = true) {
     Network::UdpRecvData data;
     data.addresses_.peer_ = Network::Utility::parseInternetAddressAndPortNoThrow(peer_address);
     data.addresses_.local_ = Network::Utility::parseInternetAddressAndPortNoThrow(local_address);
     data.buffer_ = std::make_unique<Buffer::OwnedImpl>(buffer);
     data.receive_time_ = MonotonicTime(std::chrono::seconds(0));
     filter_->onData(data);
+    if (read_complete) {
+      filter_->onReadComplete();
+    }
   }
 
   void expectSessionCreate(const Network::Address::InstanceConstSharedPtr& address) {
@@ -560,6 +563,65 @@ matcher:
   EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
 }
 
+// Datagrams received for a session in one batch are sent upstream once the batch is complete.
+TEST_F(UdpProxyFilterTest, BatchedUpstreamWrites) {
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  TestSession& session = test_sessions_[0];
+  EXPECT_CALL(*session.idle_timer_, enableTimer(config_->sessionTimeout(), nullptr)).Times(2);
+  EXPECT_CALL(*session.socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  EXPECT_CALL(*session.socket_->io_handle_, sendmsg(_, _, _, _, _)).Times(0);
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello", false);
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world", false);
+  EXPECT_EQ(1, config_->stats().downstream_sess_total_.value());
+
+  // The datagrams are sent by one system call, either as a single GSO message or as two messages
+  // of a sendmmsg().
+  std::string sent;
+  uint32_t send_calls = 0;
+  EXPECT_CALL(os_sys_calls_, supportsMmsg()).WillRepeatedly(Return(true));
+  EXPECT_CALL(os_sys_calls_, sendmsg(_, _, 0))
+      .WillRepeatedly(Invoke([&](os_fd_t, const msghdr* message, int) {
+        send_calls++;
+        sent.append(static_cast<const char*>(message->msg_iov[0].iov_base),
+                    message->msg_iov[0].iov_len);
+        return Api::SysCallSizeResult{static_cast<ssize_t>(message->msg_iov[0].iov_len), 0};
+      }));
+  EXPECT_CALL(os_sys_calls_, sendmmsg(_, _, _, 0))
+      .WillRepeatedly(Invoke([&](os_fd_t, struct mmsghdr* messages, unsigned int vlen, int) {
+        send_calls++;
+        for (unsigned int i = 0; i < vlen; i++) {
+          sent.append(static_cast<const char*>(messages[i].msg_hdr.msg_iov[0].iov_base),
+                      messages[i].msg_hdr.msg_iov[0].iov_len);
+        }
+        return Api::SysCallIntResult{static_cast<int>(vlen), 0};
+      }));
+  filter_->onReadComplete();
+  EXPECT_EQ("helloworld", sent);
+  EXPECT_EQ(1, send_calls);
+  EXPECT_EQ(10, factory_context_.server_factory_context_.cluster_manager_.thread_local_cluster_
+                    .cluster_.info_->traffic_stats_->upstream_cx_tx_bytes_total_.value());
+  EXPECT_EQ(2, TestUtility::findCounter(factory_context_.server_factory_context_.cluster_manager_
+                                            .thread_local_cluster_.cluster_.info_->stats_store_,
+                                        "udp.sess_tx_datagrams")
+                   ->value());
+
+  // Nothing is left pending once the batch has been flushed.
+  filter_->onReadComplete();
+  EXPECT_EQ(1, send_calls);
+}
+
 // Idle timeout flow.
 TEST_F(UdpProxyFilterTest, IdleTimeout) {
   InSequence s;
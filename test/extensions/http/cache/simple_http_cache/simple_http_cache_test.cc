@@ -6,11 +6,13 @@
 #include "source/extensions/filters/http/cache/cache_headers_utils.h"
 #include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
 
+#include "test/common/stats/stat_test_utility.h"
 #include "test/extensions/filters/http/cache/http_cache_implementation_test_common.h"
 #include "test/mocks/server/factory_context.h"
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/match.h"
 #include "gtest/gtest.h"
 
 namespace Envoy {
@@ -25,7 +27,9 @@ public:
   bool validationEnabled() const override { return true; }
 
 private:
-  std::shared_ptr<SimpleHttpCache> cache_ = std::make_shared<SimpleHttpCache>();
+  Stats::TestUtil::TestStore stats_store_;
+  std::shared_ptr<SimpleHttpCache> cache_ = std::make_shared<SimpleHttpCache>(
+      SimpleHttpCache::ConfigProto(), stats_store_.rootScope()->createScope("simple_http_cache."));
 };
 
 INSTANTIATE_TEST_SUITE_P(SimpleHttpCacheTest, HttpCacheImplementationTest,
@@ -45,6 +49,189 @@ TEST(Registration, GetFactory) {
             "envoy.extensions.http.cache.simple");
 }
 
+TEST(Registration, SharesCacheForEquivalentConfig) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+
+  SimpleHttpCache::ConfigProto cache_config;
+  cache_config.set_shards(4);
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  config.mutable_typed_config()->PackFrom(cache_config);
+  std::shared_ptr<HttpCache> cache = factory->getCache(config, factory_context);
+  EXPECT_EQ(cache, factory->getCache(config, factory_context));
+
+  cache_config.mutable_max_cache_size_bytes()->set_value(1024);
+  config.mutable_typed_config()->PackFrom(cache_config);
+  EXPECT_NE(cache, factory->getCache(config, factory_context));
+}
+
+TEST(Registration, SeparateStatsForDifferentConfigs) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+
+  SimpleHttpCache::ConfigProto cache_config;
+  cache_config.set_shards(4);
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  config.mutable_typed_config()->PackFrom(cache_config);
+  std::shared_ptr<HttpCache> cache = factory->getCache(config, factory_context);
+  cache_config.mutable_max_cache_size_bytes()->set_value(1024);
+  config.mutable_typed_config()->PackFrom(cache_config);
+  std::shared_ptr<HttpCache> other_cache = factory->getCache(config, factory_context);
+
+  // Each cache has a size gauge of its own for every shard.
+  uint32_t size_gauges = 0;
+  for (const Stats::GaugeSharedPtr& gauge :
+       factory_context.server_factory_context_.store_.gauges()) {
+    if (absl::StartsWith(gauge->name(), "simple_http_cache.") &&
+        absl::EndsWith(gauge->name(), ".size_bytes")) {
+      ++size_gauges;
+    }
+  }
+  EXPECT_EQ(8, size_gauges);
+}
+
+TEST(Registration, RejectsTooManyShards) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+
+  SimpleHttpCache::ConfigProto cache_config;
+  cache_config.set_shards(257);
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  config.mutable_typed_config()->PackFrom(cache_config);
+  EXPECT_THROW_WITH_REGEX(factory->getCache(config, factory_context), EnvoyException,
+                          "Shards: value must be less than or equal to 256");
+}
+
+TEST(Registration, RejectsBudgetSmallerThanShards) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+
+  SimpleHttpCache::ConfigProto cache_config;
+  cache_config.set_shards(4);
+  cache_config.mutable_max_cache_size_bytes()->set_value(3);
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  config.mutable_typed_config()->PackFrom(cache_config);
+  EXPECT_THROW_WITH_MESSAGE(
+      factory->getCache(config, factory_context), EnvoyException,
+      "simple_http_cache: max_cache_size_bytes (3) must be at least the number of shards (4)");
+}
+
+class SimpleHttpCacheEvictionTest : public testing::Test {
+protected:
+  void makeCache(uint32_t shards, absl::optional<uint64_t> max_cache_size_bytes) {
+    SimpleHttpCache::ConfigProto config;
+    config.set_shards(shards);
+    if (max_cache_size_bytes.has_value()) {
+      config.mutable_max_cache_size_bytes()->set_value(max_cache_size_bytes.value());
+    }
+    cache_ = std::make_unique<SimpleHttpCache>(
+        config, stats_store_.rootScope()->createScope("simple_http_cache."));
+  }
+
+  LookupRequest request(const std::string& path) {
+    return {Http::TestRequestHeaderMapImpl{{":path", path},
+                                           {":method", "GET"},
+                                           {":scheme", "https"},
+                                           {":authority", "example.com"}},
+            time_system_.systemTime(), vary_allow_list_};
+  }
+
+  bool insert(const std::string& path, uint64_t body_size) {
+    Http::ResponseHeaderMapPtr response_headers = Http::ResponseHeaderMapImpl::create();
+    response_headers->setStatus(200);
+    return cache_->insert(request(path).key(), std::move(response_headers),
+                          {time_system_.systemTime()}, std::string(body_size, 'x'), nullptr);
+  }
+
+  bool cached(const std::string& path) {
+    return cache_->lookup(request(path)).response_headers_ != nullptr;
+  }
+
+  uint64_t counter(uint32_t shard, absl::string_view name) {
+    return stats_store_.counter(absl::StrCat("simple_http_cache.shard_", shard, ".", name)).value();
+  }
+
+  uint64_t gauge(uint32_t shard, absl::string_view name) {
+    return stats_store_
+        .gauge(absl::StrCat("simple_http_cache.shard_", shard, ".", name),
+               Stats::Gauge::ImportMode::NeverImport)
+        .value();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Stats::TestUtil::TestStore stats_store_;
+  testing::NiceMock<Server::Configuration::MockServerFactoryContext> factory_context_;
+  VaryAllowList vary_allow_list_{{}, factory_context_};
+  std::unique_ptr<SimpleHttpCache> cache_;
+};
+
+TEST_F(SimpleHttpCacheEvictionTest, UnboundedNeverEvicts) {
+  makeCache(4, absl::nullopt);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(insert(absl::StrCat("/", i), 1024));
+  }
+  uint64_t entries = 0;
+  for (uint32_t shard = 0; shard < 4; ++shard) {
+    EXPECT_EQ(0, counter(shard, "evictions"));
+    entries += gauge(shard, "entries");
+  }
+  EXPECT_EQ(100, entries);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(cached(absl::StrCat("/", i)));
+  }
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, EvictsOldestUnreferencedEntry) {
+  makeCache(1, 1000);
+  EXPECT_TRUE(insert("/a", 400));
+  EXPECT_TRUE(insert("/b", 400));
+  EXPECT_TRUE(insert("/c", 400));
+
+  EXPECT_FALSE(cached("/a"));
+  EXPECT_TRUE(cached("/b"));
+  EXPECT_TRUE(cached("/c"));
+  EXPECT_EQ(1, counter(0, "evictions"));
+  EXPECT_EQ(2, gauge(0, "entries"));
+  EXPECT_LE(gauge(0, "size_bytes"), 1000);
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, RecentlyLookedUpEntrySurvives) {
+  makeCache(1, 1000);
+  EXPECT_TRUE(insert("/a", 400));
+  EXPECT_TRUE(insert("/b", 400));
+  EXPECT_TRUE(cached("/a"));
+  EXPECT_TRUE(insert("/c", 400));
+
+  EXPECT_TRUE(cached("/a"));
+  EXPECT_FALSE(cached("/b"));
+  EXPECT_TRUE(cached("/c"));
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, ReplacingEntryUpdatesSize) {
+  makeCache(1, 1000);
+  EXPECT_TRUE(insert("/a", 100));
+  const uint64_t small_size = gauge(0, "size_bytes");
+  EXPECT_TRUE(insert("/a", 500));
+  EXPECT_EQ(small_size + 400, gauge(0, "size_bytes"));
+  EXPECT_EQ(1, gauge(0, "entries"));
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, RejectsEntryLargerThanShard) {
+  makeCache(2, 2000);
+  EXPECT_EQ(1000, cache_->maxShardSizeBytes());
+  EXPECT_FALSE(insert("/big", 1500));
+  EXPECT_FALSE(cached("/big"));
+  EXPECT_EQ(1, counter(0, "inserts_rejected") + counter(1, "inserts_rejected"));
+}
+
 } // namespace
 } // namespace Cache
 } // namespace HttpFilters
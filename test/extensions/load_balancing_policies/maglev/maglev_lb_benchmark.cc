@@ -80,6 +80,40 @@ BENCHMARK(benchmarkMaglevLoadBalancerBuildTable)
     ->Arg(500)
     ->Unit(::benchmark::kMillisecond);
 
+void benchmarkMaglevLoadBalancerRebuildTable(::benchmark::State& state) {
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    const uint64_t num_hosts = state.range(0);
+    const uint64_t hosts_to_replace = state.range(1);
+    MaglevTester tester(num_hosts);
+    ASSERT_TRUE(tester.maglev_lb_->initialize().ok());
+
+    // Replace the last hosts_to_replace hosts with new ones.
+    const HostVector& current_hosts = tester.priority_set_.hostSetsPerPriority()[0]->hosts();
+    HostVector hosts(current_hosts.begin(), current_hosts.end() - hosts_to_replace);
+    HostVector removed(current_hosts.end() - hosts_to_replace, current_hosts.end());
+    HostVector added;
+    for (uint64_t i = 0; i < hosts_to_replace; i++) {
+      const std::string url = fmt::format("tcp://10.1.{}.{}:6379", i / 256, i % 256);
+      added.push_back(makeTestHost(tester.info_, url, tester.simTime()));
+    }
+    hosts.insert(hosts.end(), added.begin(), added.end());
+    HostVectorConstSharedPtr updated_hosts = std::make_shared<HostVector>(hosts);
+    HostsPerLocalityConstSharedPtr hosts_per_locality = makeHostsPerLocality({hosts});
+    state.ResumeTiming();
+
+    // Updating the hosts triggers the table rebuild.
+    tester.priority_set_.updateHosts(
+        0, HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality), {}, added, removed,
+        tester.random_.random(), absl::nullopt);
+  }
+}
+BENCHMARK(benchmarkMaglevLoadBalancerRebuildTable)
+    ->Args({100, 1})
+    ->Args({1000, 10})
+    ->Args({5000, 50})
+    ->Unit(::benchmark::kMillisecond);
+
 void benchmarkMaglevLoadBalancerHostLoss(::benchmark::State& state) {
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     const uint64_t num_hosts = state.range(0);
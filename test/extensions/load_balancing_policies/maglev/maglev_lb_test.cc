@@ -323,6 +323,44 @@ TEST_F(MaglevLoadBalancerTest, BasicStability) {
   }
 }
 
+// A priority whose hosts did not change keeps its table when another priority is updated.
+TEST_F(MaglevLoadBalancerTest, UnchangedPriorityKeepsTable) {
+  host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:90", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:91", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:92", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:93", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:94", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:95", simTime())};
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  host_set_.runCallbacks({}, {});
+  MockHostSet& host_set_1 = *priority_set_.getMockHostSet(1);
+  host_set_1.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:96", simTime())};
+  host_set_1.healthy_hosts_ = host_set_1.hosts_;
+  host_set_1.runCallbacks({}, {});
+  init(7);
+
+  // The stats describe the table built last, which is priority 1's.
+  EXPECT_EQ(7, lb_->stats().min_entries_per_host_.value());
+  EXPECT_EQ(7, lb_->stats().max_entries_per_host_.value());
+
+  // Only priority 0's table is rebuilt, so the stats now describe it.
+  host_set_.healthy_hosts_ = {host_set_.hosts_[0], host_set_.hosts_[1], host_set_.hosts_[2],
+                              host_set_.hosts_[3], host_set_.hosts_[4]};
+  host_set_.runCallbacks({}, {host_set_.hosts_[5]});
+  EXPECT_EQ(1, lb_->stats().min_entries_per_host_.value());
+  EXPECT_EQ(2, lb_->stats().max_entries_per_host_.value());
+
+  // Bringing back the host gives the same table as building it from scratch.
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  host_set_.runCallbacks({host_set_.hosts_[5]}, {});
+  LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+  const std::vector<uint32_t> expected_assignments{2, 4, 0, 1, 5, 0, 3};
+  for (uint32_t i = 0; i < expected_assignments.size(); ++i) {
+    TestLoadBalancerContext context(i);
+    EXPECT_EQ(host_set_.hosts_[expected_assignments[i]], lb->chooseHost(&context));
+  }
+}
+
 // Weighted sanity test.
 TEST_F(MaglevLoadBalancerTest, Weighted) {
   host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:90", simTime(), 1),
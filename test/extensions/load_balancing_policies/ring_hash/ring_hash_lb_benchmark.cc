@@ -53,6 +53,35 @@ BENCHMARK(benchmarkRingHashLoadBalancerBuildRing)
     ->Args({500, 256000})
     ->Unit(::benchmark::kMillisecond);
 
+// Times the rebuild of an existing ring after one host is removed from the cluster.
+void benchmarkRingHashLoadBalancerRebuildRing(::benchmark::State& state) {
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    const uint64_t num_hosts = state.range(0);
+    const uint64_t min_ring_size = state.range(1);
+    RingHashTester tester(num_hosts, min_ring_size);
+    ASSERT_TRUE(tester.ring_hash_lb_->initialize().ok());
+
+    const HostVector& current_hosts = tester.priority_set_.hostSetsPerPriority()[0]->hosts();
+    HostVector hosts(current_hosts.begin() + 1, current_hosts.end());
+    HostVector removed{current_hosts.front()};
+    HostVectorConstSharedPtr updated_hosts = std::make_shared<HostVector>(hosts);
+    HostsPerLocalityConstSharedPtr hosts_per_locality = makeHostsPerLocality({hosts});
+    state.ResumeTiming();
+
+    // Removing a host triggers the ring rebuild.
+    tester.priority_set_.updateHosts(
+        0, HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality), {}, {}, removed,
+        tester.random_.random(), absl::nullopt);
+  }
+}
+BENCHMARK(benchmarkRingHashLoadBalancerRebuildRing)
+    ->Args({100, 65536})
+    ->Args({500, 65536})
+    ->Args({100, 256000})
+    ->Args({500, 256000})
+    ->Unit(::benchmark::kMillisecond);
+
 void benchmarkRingHashLoadBalancerChooseHost(::benchmark::State& state) {
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     // Do not time the creation of the ring.
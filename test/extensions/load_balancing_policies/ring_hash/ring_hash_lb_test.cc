@@ -588,6 +588,61 @@ TEST_P(RingHashLoadBalancerTest, UnevenHosts) {
   }
 }
 
+// Rings rebuilt from the previous ring after a membership or weight change must pick the same hosts
+// as a ring built from scratch for the new host set.
+TEST_P(RingHashLoadBalancerTest, IncrementalRebuildMatchesFullBuild) {
+  for (uint32_t i = 0; i < 20; ++i) {
+    hostSet().hosts_.push_back(
+        makeTestHost(info_, absl::StrCat("tcp://127.0.0.1:", 90 + i), simTime(), 1 + i % 3));
+  }
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+
+  config_ = envoy::config::cluster::v3::Cluster::RingHashLbConfig();
+  config_.value().mutable_minimum_ring_size()->set_value(1024);
+  init();
+
+  auto expect_same_as_full_build = [this]() {
+    RingHashLoadBalancer fresh_lb(
+        priority_set_, stats_, *stats_store_.rootScope(), runtime_, random_,
+        makeOptRef<const envoy::config::cluster::v3::Cluster::RingHashLbConfig>(config_.value()),
+        common_config_);
+    ASSERT_TRUE(fresh_lb.initialize().ok());
+    LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+    LoadBalancerPtr fresh = fresh_lb.factory()->create(lb_params_);
+    for (uint64_t hash : {uint64_t(0), std::numeric_limits<uint64_t>::max()}) {
+      TestLoadBalancerContext context(hash);
+      EXPECT_EQ(fresh->chooseHost(&context), lb->chooseHost(&context));
+    }
+    for (uint64_t i = 0; i < 10000; ++i) {
+      TestLoadBalancerContext context(i * 0x9e3779b97f4a7c15);
+      ASSERT_EQ(fresh->chooseHost(&context), lb->chooseHost(&context)) << "hash " << i;
+    }
+  };
+
+  // Lose hosts, including the least weighted ones, which rescales the whole ring.
+  hostSet().hosts_.erase(hostSet().hosts_.begin(), hostSet().hosts_.begin() + 3);
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+  expect_same_as_full_build();
+
+  // Gain hosts and change the weight of an existing one.
+  hostSet().hosts_.push_back(makeTestHost(info_, "tcp://127.0.0.1:200", simTime(), 2));
+  hostSet().hosts_.push_back(makeTestHost(info_, "tcp://127.0.0.1:201", simTime(), 1));
+  hostSet().hosts_[5]->weight(3);
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+  expect_same_as_full_build();
+
+  // Replace a host object with a new one for the same address.
+  hostSet().hosts_[0] =
+      makeTestHost(info_, absl::StrCat("tcp://", hostSet().hosts_[0]->address()->asString()),
+                   simTime(), hostSet().hosts_[0]->weight());
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+  expect_same_as_full_build();
+}
+
 // Given hosts with weights 1, 2 and 3, and a ring size of exactly 6, expect the correct number of
 // hashes for each host.
 TEST_P(RingHashLoadBalancerTest, HostWeightedTinyRing) {
@@ -80,6 +80,8 @@ public:
   MOCK_METHOD(SysCallIntResult, close, (os_fd_t));
   MOCK_METHOD(SysCallSizeResult, writev, (os_fd_t, const iovec*, int));
   MOCK_METHOD(SysCallSizeResult, sendmsg, (os_fd_t fd, const msghdr* msg, int flags));
+  MOCK_METHOD(SysCallIntResult, sendmmsg,
+              (os_fd_t fd, struct mmsghdr* msgvec, unsigned int vlen, int flags));
   MOCK_METHOD(SysCallSizeResult, readv, (os_fd_t, const iovec*, int));
   MOCK_METHOD(SysCallSizeResult, pwrite,
               (os_fd_t fd, const void* buffer, size_t length, off_t offset), (const));
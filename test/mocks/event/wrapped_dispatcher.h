@@ -31,6 +31,8 @@ public:
     impl_.initializeStats(scope, prefix);
   }
 
+  std::chrono::microseconds loopLatency() const override { return impl_.loopLatency(); }
+
   void clearDeferredDeleteList() override { impl_.clearDeferredDeleteList(); }
 
   Network::ServerConnectionPtr
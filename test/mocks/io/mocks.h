@@ -28,6 +28,13 @@ public:
   MOCK_METHOD(IoUringResult, prepareClose, (os_fd_t fd, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareCancel, (Request * cancelling_user_data, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareShutdown, (os_fd_t fd, int how, Request* user_data));
+  MOCK_METHOD(IoUringResult, registerBufferRing, (uint32_t num_buffers, uint32_t buffer_size));
+  MOCK_METHOD(const uint8_t*, getProvidedBuffer, (uint16_t buffer_id), (const));
+  MOCK_METHOD(void, recycleProvidedBuffer, (uint16_t buffer_id));
+  MOCK_METHOD(IoUringResult, prepareRecvMultishot, (os_fd_t fd, Request* user_data));
+  MOCK_METHOD(bool, isZeroCopySendSupported, ());
+  MOCK_METHOD(IoUringResult, prepareSendmsgZeroCopy,
+              (os_fd_t fd, const struct msghdr* msg, Request* user_data));
   MOCK_METHOD(IoUringResult, submit, ());
   MOCK_METHOD(void, injectCompletion, (os_fd_t fd, Request* user_data, int32_t result));
   MOCK_METHOD(void, removeInjectedCompletion, (os_fd_t fd));
@@ -74,6 +81,8 @@ public:
   MOCK_METHOD(Request*, submitReadRequest, (IoUringSocket & socket));
   MOCK_METHOD(Request*, submitWriteRequest,
               (IoUringSocket & socket, const Buffer::RawSliceVector& slices));
+  MOCK_METHOD(Request*, submitSendZeroCopyRequest,
+              (IoUringSocket & socket, Buffer::Instance& data, uint64_t length));
   MOCK_METHOD(Request*, submitCloseRequest, (IoUringSocket & socket));
   MOCK_METHOD(Request*, submitCancelRequest, (IoUringSocket & socket, Request* request_to_cancel));
   MOCK_METHOD(Request*, submitShutdownRequest, (IoUringSocket & socket, int how));
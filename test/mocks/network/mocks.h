@@ -181,6 +181,7 @@ public:
   MOCK_METHOD(void, onData, (UdpRecvData && data));
   MOCK_METHOD(void, onDatagramsDropped, (uint32_t dropped));
   MOCK_METHOD(void, onReadReady, ());
+  MOCK_METHOD(void, onReadComplete, ());
   MOCK_METHOD(void, onWriteReady, (const Socket& socket));
   MOCK_METHOD(void, onReceiveError, (Api::IoError::IoErrorCode err));
   MOCK_METHOD(Network::UdpPacketWriter&, udpPacketWriter, ());
@@ -683,6 +684,7 @@ public:
 
   MOCK_METHOD(Network::FilterStatus, onData, (UdpRecvData&));
   MOCK_METHOD(Network::FilterStatus, onReceiveError, (Api::IoError::IoErrorCode));
+  MOCK_METHOD(void, onReadComplete, ());
 };
 
 class MockUdpListenerFilterManager : public UdpListenerFilterManager {
@@ -695,6 +697,20 @@ public:
   MOCK_METHOD(void, addReadFilter_, (Network::UdpListenerReadFilterPtr&));
 };
 
+class MockBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  MockBalancedConnectionHandler();
+  ~MockBalancedConnectionHandler() override;
+
+  MOCK_METHOD(uint64_t, numConnections, (), (const));
+  MOCK_METHOD(void, incNumConnections, ());
+  MOCK_METHOD(std::chrono::microseconds, loopLatency, (), (const));
+  MOCK_METHOD(void, post, (Network::ConnectionSocketPtr && socket));
+  MOCK_METHOD(void, onAcceptWorker,
+              (Network::ConnectionSocketPtr && socket,
+               bool hand_off_restored_destination_connections, bool rebalanced));
+};
+
 class MockConnectionBalancer : public ConnectionBalancer {
 public:
   MockConnectionBalancer();
@@ -2,6 +2,7 @@
 
 #include "envoy/admin/v3/server_info.pb.h"
 
+#include "source/common/buffer/slice_pool.h"
 #include "source/common/config/well_known_names.h"
 
 #include "gmock/gmock.h"
@@ -48,6 +49,8 @@ MockOptions::MockOptions(const std::string& config_path) : config_path_(config_p
   ON_CALL(*this, socketPath()).WillByDefault(ReturnRef(socket_path_));
   ON_CALL(*this, socketMode()).WillByDefault(ReturnPointee(&socket_mode_));
   ON_CALL(*this, statsTags()).WillByDefault(ReturnRef(stats_tags_));
+  ON_CALL(*this, bufferSliceCacheBytesPerThread())
+      .WillByDefault(Return(Buffer::SlicePool::DefaultMaxCachedBytesPerThread));
 }
 
 MockOptions::~MockOptions() = default;
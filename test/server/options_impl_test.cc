@@ -96,6 +96,8 @@ TEST_F(OptionsImplTest, All) {
       "--local-address-ip-version v6 -l info --component-log-level upstream:debug,connection:trace "
       "--service-cluster cluster --service-node node --service-zone zone "
       "--file-flush-interval-msec 9000 "
+      "--file-flush-max-buffered-bytes 1048576 --file-flush-single-thread "
+      "--buffer-slice-cache-bytes-per-thread 65536 "
       "--skip-hot-restart-on-no-parent "
       "--skip-hot-restart-parent-stats "
       "--drain-time-s 60 --log-format [%v] --enable-fine-grain-logging --parent-shutdown-time-s 90 "
@@ -124,6 +126,9 @@ TEST_F(OptionsImplTest, All) {
   EXPECT_EQ("node", options->serviceNodeName());
   EXPECT_EQ("zone", options->serviceZone());
   EXPECT_EQ(std::chrono::milliseconds(9000), options->fileFlushIntervalMsec());
+  EXPECT_EQ(1048576U, options->fileFlushMaxBufferedBytes());
+  EXPECT_TRUE(options->fileFlushSingleThread());
+  EXPECT_EQ(65536U, options->bufferSliceCacheBytesPerThread());
   EXPECT_EQ(std::chrono::seconds(60), options->drainTime());
   EXPECT_EQ(std::chrono::seconds(90), options->parentShutdownTime());
   EXPECT_TRUE(options->hotRestartDisabled());
@@ -252,6 +257,11 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(options->restartEpoch(), command_line_options->restart_epoch());
   EXPECT_EQ(options->fileFlushIntervalMsec().count() / 1000,
             command_line_options->file_flush_interval().seconds());
+  EXPECT_EQ(options->fileFlushMaxBufferedBytes(),
+            command_line_options->file_flush_max_buffered_bytes());
+  EXPECT_EQ(options->fileFlushSingleThread(), command_line_options->file_flush_single_thread());
+  EXPECT_EQ(options->bufferSliceCacheBytesPerThread(),
+            command_line_options->buffer_slice_cache_bytes_per_thread());
   EXPECT_EQ(envoy::admin::v3::CommandLineOptions::Validate, command_line_options->mode());
   EXPECT_EQ(options->serviceClusterName(), command_line_options->service_cluster());
   EXPECT_EQ(options->serviceNodeName(), command_line_options->service_node());
@@ -500,6 +510,12 @@ TEST_F(OptionsImplTest, SaneTestConstructor) {
   EXPECT_EQ(regular_options_impl->mode(), test_options_impl.mode());
   EXPECT_EQ(regular_options_impl->fileFlushIntervalMsec(),
             test_options_impl.fileFlushIntervalMsec());
+  EXPECT_EQ(regular_options_impl->fileFlushMaxBufferedBytes(),
+            test_options_impl.fileFlushMaxBufferedBytes());
+  EXPECT_EQ(regular_options_impl->fileFlushSingleThread(),
+            test_options_impl.fileFlushSingleThread());
+  EXPECT_EQ(regular_options_impl->bufferSliceCacheBytesPerThread(),
+            test_options_impl.bufferSliceCacheBytesPerThread());
   EXPECT_EQ(regular_options_impl->hotRestartDisabled(), test_options_impl.hotRestartDisabled());
   EXPECT_EQ(regular_options_impl->cpusetThreadsEnabled(), test_options_impl.cpusetThreadsEnabled());
 }
@@ -628,6 +628,25 @@ TEST_F(OverloadManagerImplTest, CreateScaledTimerManager) {
   EXPECT_THAT(timer_minimums, Pointee(UnorderedElementsAreArray(kReducedTimeoutsMinimums)));
 }
 
+TEST_F(OverloadManagerImplTest, CreateCoalescingScaledTimerManager) {
+  const std::string config = R"YAML(
+    actions:
+      - name: envoy.overload_actions.reduce_timeouts
+        typed_config:
+          "@type": type.googleapis.com/envoy.config.overload.v3.ScaleTimersOverloadActionConfig
+          timer_scale_factors:
+            - timer: HTTP_DOWNSTREAM_CONNECTION_IDLE
+              min_timeout: 2s
+          coalescing_window: 0.1s
+  )YAML";
+  auto manager(createOverloadManager(config));
+
+  // A coalescing timer manager creates the timer shared by its queues up front.
+  Event::MockDispatcher mock_dispatcher;
+  EXPECT_CALL(mock_dispatcher, createTimer_(_));
+  auto scaled_timer_manager = manager->scaledTimerFactory()(mock_dispatcher);
+}
+
 TEST_F(OverloadManagerImplTest, AdjustScaleFactor) {
   setDispatcherExpectation();
   auto manager(createOverloadManager(kReducedTimeoutsConfig));
@@ -13,6 +13,7 @@
 #include "source/common/network/listen_socket_impl.h"
 #include "source/common/network/socket_option_impl.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/stats/changed_metrics_sink.h"
 #include "source/common/thread_local/thread_local_impl.h"
 #include "source/common/version/version.h"
 #include "source/server/instance_impl.h"
@@ -160,6 +161,55 @@ TEST(ServerInstanceUtil, flushImportModeUninitializedGauges) {
   InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
 }
 
+TEST(ServerInstanceUtil, flushChangedMetricsOnly) {
+  InSequence s;
+
+  NiceMock<Upstream::MockClusterManager> cm;
+  Stats::TestUtil::TestStore store;
+  Event::SimulatedTimeSystem time_system;
+  Stats::Counter& idle_counter = store.counter("idle_counter");
+  Stats::Counter& busy_counter = store.counter("busy_counter");
+  Stats::Gauge& idle_gauge = store.gauge("idle_gauge", Stats::Gauge::ImportMode::Accumulate);
+  Stats::Gauge& busy_gauge = store.gauge("busy_gauge", Stats::Gauge::ImportMode::Accumulate);
+  idle_counter.inc();
+  idle_gauge.set(5);
+  busy_gauge.set(5);
+
+  std::list<Stats::SinkPtr> sinks;
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+
+  Stats::MockSink* full_sink = new StrictMock<Stats::MockSink>();
+  Stats::MockSink* changed_sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(full_sink);
+  sinks.emplace_back(std::make_unique<Stats::ChangedMetricsSink>(Stats::SinkPtr(changed_sink)));
+  EXPECT_CALL(*full_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 2);
+  }));
+  EXPECT_CALL(*changed_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "busy_counter");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 1);
+
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().name(), "busy_gauge");
+    EXPECT_EQ(snapshot.gauges()[0].get().value(), 4);
+  }));
+  busy_counter.inc();
+  busy_gauge.dec();
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+
+  // Setting a gauge to its current value still counts as a change.
+  EXPECT_CALL(*full_sink, flush(_));
+  EXPECT_CALL(*changed_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.counters().empty());
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().name(), "idle_gauge");
+  }));
+  idle_gauge.set(5);
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+}
+
 class RunHelperTest : public testing::Test {
 public:
   RunHelperTest() {
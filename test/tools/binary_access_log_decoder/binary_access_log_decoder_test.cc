@@ -0,0 +1,117 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "source/common/common/base64.h"
+#include "source/common/formatter/substitution_formatter.h"
+#include "source/common/json/json_loader.h"
+
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "tools/binary_access_log_decoder_lib.h"
+
+#include "absl/strings/str_split.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Tools {
+namespace {
+
+class BinaryAccessLogDecoderTest : public testing::Test {
+protected:
+  BinaryAccessLogDecoderTest() {
+    columns_.Add("%REQ(:METHOD)%");
+    columns_.Add("%REQ(X-VALUE)%");
+    columns_.Add("");
+    columns_.Add("quote=\" control=\x01");
+  }
+
+  // Formats the entry of a request, with an x-value header unless value is absl::nullopt.
+  std::string record(absl::optional<std::string> value) {
+    Http::TestRequestHeaderMapImpl headers{{":method", "GET"}};
+    if (value.has_value()) {
+      headers.addCopy(Http::LowerCaseString("x-value"), *value);
+    }
+    Formatter::HttpFormatterContext context(&headers);
+    Formatter::BinaryFormatterBaseImpl<Formatter::HttpFormatterContext> formatter(columns_);
+    return formatter.formatWithContext(context, stream_info_);
+  }
+
+  // Decodes a log, expecting it to be well formed, and parses the JSON lines.
+  std::vector<Json::ObjectSharedPtr> decode(const std::string& log) {
+    std::istringstream input(log);
+    std::ostringstream output;
+    EXPECT_TRUE(decodeBinaryAccessLog(input, names_, output).ok());
+    std::vector<Json::ObjectSharedPtr> lines;
+    for (absl::string_view line : absl::StrSplit(output.str(), '\n', absl::SkipEmpty())) {
+      lines.push_back(Json::Factory::loadFromString(std::string(line)));
+    }
+    return lines;
+  }
+
+  Protobuf::RepeatedPtrField<std::string> columns_;
+  const std::vector<std::string> names_{"method", "value", "empty", "literal"};
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+};
+
+TEST_F(BinaryAccessLogDecoderTest, RoundTrip) {
+  const std::string binary = "\xff\xfe\x80 binary";
+  const std::vector<Json::ObjectSharedPtr> lines =
+      decode(record("plain") + record("") + record(absl::nullopt) + record("caf\xc3\xa9") +
+             record(binary));
+  ASSERT_EQ(5, lines.size());
+
+  for (const Json::ObjectSharedPtr& line : lines) {
+    EXPECT_EQ("GET", line->getString("method"));
+    EXPECT_EQ("", line->getString("empty"));
+    EXPECT_EQ("quote=\" control=\x01", line->getString("literal"));
+  }
+  EXPECT_EQ("plain", lines[0]->getString("value"));
+  EXPECT_EQ("", lines[1]->getString("value"));
+  // Columns without a value are omitted.
+  EXPECT_FALSE(lines[2]->hasObject("value"));
+  EXPECT_EQ("caf\xc3\xa9", lines[3]->getString("value"));
+  // Values which are not valid UTF-8 are base64 encoded.
+  EXPECT_EQ(binary, Base64::decode(lines[4]->getObject("value")->getString("base64")));
+}
+
+// Records are decoded across the chunks the input is read in.
+TEST_F(BinaryAccessLogDecoderTest, LargeLog) {
+  const std::string value(64 * 1024, 'a');
+  std::string log;
+  for (int i = 0; i < 32; i++) {
+    log += record(value);
+  }
+  const std::vector<Json::ObjectSharedPtr> lines = decode(log);
+  ASSERT_EQ(32, lines.size());
+  for (const Json::ObjectSharedPtr& line : lines) {
+    EXPECT_EQ(value, line->getString("value"));
+  }
+}
+
+TEST_F(BinaryAccessLogDecoderTest, EmptyLog) { EXPECT_TRUE(decode("").empty()); }
+
+TEST_F(BinaryAccessLogDecoderTest, TruncatedRecord) {
+  const std::string first = record("first");
+  std::istringstream input(first + record("second").substr(0, 10));
+  std::ostringstream output;
+  EXPECT_EQ("Truncated record at end of input",
+            decodeBinaryAccessLog(input, names_, output).message());
+  // The records before it are still written.
+  EXPECT_EQ("first", Json::Factory::loadFromString(output.str())->getString("value"));
+}
+
+TEST_F(BinaryAccessLogDecoderTest, WrongColumnCount) {
+  std::istringstream input(record("value"));
+  std::ostringstream output;
+  EXPECT_EQ("Record has 4 columns, expected 2",
+            decodeBinaryAccessLog(input, {"method", "value"}, output).message());
+  EXPECT_EQ("", output.str());
+}
+
+} // namespace
+} // namespace Tools
+} // namespace Envoy
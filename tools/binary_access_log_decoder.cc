@@ -0,0 +1,37 @@
+/**
+ * Utility to convert an access log written with a binary format to JSON lines, one object per
+ * record keyed by the given column names. Columns without a value are omitted, and values which
+ * are not valid UTF-8 are written as {"base64": "<encoded value>"}.
+ *
+ * Usage:
+ *
+ * binary_access_log_decoder <input path> <column name>...
+ */
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "tools/binary_access_log_decoder_lib.h"
+
+// NOLINT(namespace-envoy)
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <input path> <column name>..." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::ifstream input(argv[1], std::ios::binary);
+  if (!input) {
+    std::cerr << "Unable to open " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::vector<std::string> names(argv + 2, argv + argc);
+
+  const absl::Status status = Envoy::Tools::decodeBinaryAccessLog(input, names, std::cout);
+  if (!status.ok()) {
+    std::cerr << status.message() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,74 @@
+#include "tools/binary_access_log_decoder_lib.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/base64.h"
+#include "source/common/formatter/binary_record.h"
+#include "source/common/json/json_streamer.h"
+
+#include "absl/strings/str_cat.h"
+#include "utf8_validity.h"
+
+namespace Envoy {
+namespace Tools {
+
+absl::Status decodeBinaryAccessLog(std::istream& input, const std::vector<std::string>& names,
+                                   std::ostream& output) {
+  constexpr size_t ChunkSize = 1 << 20;
+  std::string pending;
+  std::vector<absl::optional<absl::string_view>> columns;
+  Buffer::OwnedImpl lines;
+  while (input) {
+    const size_t offset = pending.size();
+    pending.resize(offset + ChunkSize);
+    input.read(pending.data() + offset, ChunkSize);
+    pending.resize(offset + input.gcount());
+
+    absl::string_view data = pending;
+    while (!data.empty()) {
+      const absl::StatusOr<size_t> size = Formatter::BinaryRecord::decode(data, columns);
+      if (!size.ok()) {
+        output << lines.toString();
+        return absl::InvalidArgumentError(
+            absl::StrCat("Malformed record: ", size.status().message()));
+      }
+      if (*size == 0) {
+        break;
+      }
+      if (columns.size() != names.size()) {
+        output << lines.toString();
+        return absl::InvalidArgumentError(absl::StrCat("Record has ", columns.size(),
+                                                       " columns, expected ", names.size()));
+      }
+      {
+        Json::Streamer streamer(lines);
+        Json::Streamer::MapPtr map = streamer.makeRootMap();
+        for (size_t i = 0; i < names.size(); i++) {
+          if (!columns[i].has_value()) {
+            continue;
+          }
+          map->addKey(names[i]);
+          if (utf8_range::IsStructurallyValid(*columns[i])) {
+            map->addString(*columns[i]);
+          } else {
+            Json::Streamer::MapPtr bytes = map->addMap();
+            bytes->addKey("base64");
+            bytes->addString(Base64::encode(columns[i]->data(), columns[i]->size()));
+          }
+        }
+      }
+      lines.add("\n");
+      data.remove_prefix(*size);
+    }
+    output << lines.toString();
+    lines.drain(lines.length());
+    pending.erase(0, pending.size() - data.size());
+  }
+
+  if (!pending.empty()) {
+    return absl::InvalidArgumentError("Truncated record at end of input");
+  }
+  return absl::OkStatus();
+}
+
+} // namespace Tools
+} // namespace Envoy
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+
+namespace Envoy {
+namespace Tools {
+
+/**
+ * Converts an access log written with a binary format to JSON lines, one object per record keyed
+ * by the given column names. Columns without a value are omitted. Values which are not valid UTF-8
+ * cannot be JSON strings, so they are written as an object holding their base64 encoding under
+ * "base64".
+ * @param input supplies the log.
+ * @param names supplies the names of the columns of the format, in order.
+ * @param output receives the JSON lines.
+ * @return an error if a record is malformed, has another number of columns, or is cut short by the
+ *         end of the input, after the lines of the records before it were written.
+ */
+absl::Status decodeBinaryAccessLog(std::istream& input, const std::vector<std::string>& names,
+                                   std::ostream& output);
+
+} // namespace Tools
+} // namespace Envoy